@@ -0,0 +1,75 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.util.Log;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import com.example.sr_poc.benchmark.BatchingBenchmark;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.InputStream;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+/**
+ * Throughput vs. latency of the dynamic batching window on a real device.
+ * Results are written to logcat under the BatchingBenchmark tag.
+ */
+@RunWith(AndroidJUnit4.class)
+public class BatchingBenchmarkTest {
+
+    private ThreadSafeSRProcessor processor;
+    private Bitmap input;
+
+    @Before
+    public void setUp() throws Exception {
+        Context context = InstrumentationRegistry.getInstrumentation().getTargetContext();
+        processor = new ThreadSafeSRProcessor(context);
+
+        CountDownLatch initialized = new CountDownLatch(1);
+        boolean[] success = new boolean[1];
+        processor.initialize((ok, message) -> {
+            success[0] = ok;
+            initialized.countDown();
+        });
+        assertTrue(initialized.await(60, TimeUnit.SECONDS));
+        assertTrue("Processor failed to initialize", success[0]);
+
+        try (InputStream stream = context.getAssets().open("images/d1.png")) {
+            Bitmap decoded = BitmapFactory.decodeStream(stream);
+            input = Bitmap.createScaledBitmap(decoded, processor.getModelInputWidth(),
+                                              processor.getModelInputHeight(), true);
+        }
+    }
+
+    @After
+    public void tearDown() {
+        if (processor != null) {
+            processor.close();
+        }
+    }
+
+    @Test
+    public void batchingWindowSweep() throws Exception {
+        BatchingBenchmark benchmark = new BatchingBenchmark(processor, input, ThreadSafeSRProcessor.ProcessingMode.CPU);
+        List<BatchingBenchmark.Result> results = benchmark.sweep(
+            new int[] {1, 2, 4}, new long[] {0, 2, 5, 10}, 4, 8, 1, 0);
+
+        assertFalse(results.isEmpty());
+        for (BatchingBenchmark.Result result : results) {
+            Log.i("BatchingBenchmarkTest", result.toString());
+            assertEquals(0, result.failed);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import com.example.sr_poc.benchmark.EncoderBenchmark;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.InputStream;
+import java.util.List;
+
+import static org.junit.Assert.*;
+
+/**
+ * Parallel PNG encode time vs. thread count on a 4x-sized output.
+ * Results are written to logcat under the EncoderBenchmark tag.
+ */
+@RunWith(AndroidJUnit4.class)
+public class EncoderBenchmarkTest {
+
+    @Test
+    public void encodeScalesWithThreads() throws Exception {
+        Context context = InstrumentationRegistry.getInstrumentation().getTargetContext();
+        Bitmap output;
+        try (InputStream stream = context.getAssets().open("images/d1.png")) {
+            Bitmap decoded = BitmapFactory.decodeStream(stream);
+            output = Bitmap.createScaledBitmap(decoded, decoded.getWidth() * 4, decoded.getHeight() * 4, true);
+        }
+
+        int cores = Runtime.getRuntime().availableProcessors();
+        List<EncoderBenchmark.Result> results = EncoderBenchmark.run(output, new int[] {1, 2, 4, cores});
+
+        assertEquals(5, results.size());
+        for (EncoderBenchmark.Result result : results) {
+            assertTrue(result.bytes > 0);
+        }
+    }
+}
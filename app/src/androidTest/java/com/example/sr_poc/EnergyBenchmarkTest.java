@@ -0,0 +1,90 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.util.Log;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import com.example.sr_poc.benchmark.EnergyBenchmark;
+import com.example.sr_poc.utils.BatteryPowerSource;
+import com.example.sr_poc.utils.EnergyMeter;
+
+import org.junit.After;
+import org.junit.Assume;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.InputStream;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+/**
+ * Joules per output megapixel for each backend with the configured model.
+ * Run on battery (unplugged); results are written to logcat under the EnergyBenchmark tag.
+ */
+@RunWith(AndroidJUnit4.class)
+public class EnergyBenchmarkTest {
+
+    private ThreadSafeSRProcessor processor;
+    private EnergyMeter meter;
+    private Bitmap input;
+    private String model;
+
+    @Before
+    public void setUp() throws Exception {
+        Context context = InstrumentationRegistry.getInstrumentation().getTargetContext();
+        BatteryPowerSource battery = new BatteryPowerSource(context);
+        Assume.assumeTrue("Device does not report battery current", battery.isSupported());
+
+        ConfigManager config = ConfigManager.getInstance(context);
+        meter = new EnergyMeter(battery, config.getEnergySampleIntervalMs());
+        model = config.getDefaultModelPath();
+        processor = new ThreadSafeSRProcessor(context);
+
+        CountDownLatch initialized = new CountDownLatch(1);
+        boolean[] success = new boolean[1];
+        processor.initialize((ok, message) -> {
+            success[0] = ok;
+            initialized.countDown();
+        });
+        assertTrue(initialized.await(60, TimeUnit.SECONDS));
+        assertTrue("Processor failed to initialize", success[0]);
+
+        try (InputStream stream = context.getAssets().open("images/d1.png")) {
+            Bitmap decoded = BitmapFactory.decodeStream(stream);
+            input = Bitmap.createScaledBitmap(decoded, processor.getModelInputWidth(),
+                                              processor.getModelInputHeight(), true);
+        }
+    }
+
+    @After
+    public void tearDown() {
+        if (processor != null) {
+            processor.close();
+        }
+        if (meter != null) {
+            meter.close();
+        }
+    }
+
+    @Test
+    public void energyPerBackend() throws Exception {
+        EnergyBenchmark benchmark = new EnergyBenchmark(processor, meter, model, input);
+        List<EnergyBenchmark.Result> results = benchmark.run(ThreadSafeSRProcessor.ProcessingMode.values(), 3, 20);
+
+        assertFalse(results.isEmpty());
+        for (EnergyBenchmark.Result result : results) {
+            Log.i("EnergyBenchmarkTest", result.toString());
+            if (result.completed > 0) {
+                assertTrue(result.mode + " produced no energy reading", result.joulesPerMegapixel > 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.util.Log;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import com.example.sr_poc.benchmark.PerformanceHintBenchmark;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.InputStream;
+import java.util.Locale;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+/**
+ * Tile latency variance on the CPU backend with thread priorities and performance hints off, then on.
+ * Idle gaps between tiles let the governor ramp down; results are written to logcat under the
+ * PerformanceHintBenchmark tag. Hint sessions need API 31+, older devices only see the priority change.
+ */
+@RunWith(AndroidJUnit4.class)
+public class PerformanceHintBenchmarkTest {
+
+    private ThreadSafeSRProcessor processor;
+    private Bitmap tile;
+
+    @Before
+    public void setUp() throws Exception {
+        Context context = InstrumentationRegistry.getInstrumentation().getTargetContext();
+        processor = new ThreadSafeSRProcessor(context);
+
+        CountDownLatch initialized = new CountDownLatch(1);
+        boolean[] success = new boolean[1];
+        processor.initialize((ok, message) -> {
+            success[0] = ok;
+            initialized.countDown();
+        });
+        assertTrue(initialized.await(60, TimeUnit.SECONDS));
+        assertTrue("Processor failed to initialize", success[0]);
+
+        try (InputStream stream = context.getAssets().open("images/d1.png")) {
+            Bitmap decoded = BitmapFactory.decodeStream(stream);
+            tile = Bitmap.createScaledBitmap(decoded, processor.getModelInputWidth(),
+                                             processor.getModelInputHeight(), true);
+        }
+    }
+
+    @After
+    public void tearDown() {
+        if (processor != null) {
+            processor.close();
+        }
+    }
+
+    @Test
+    public void tileLatencyVarianceBeforeAndAfterHints() throws Exception {
+        PerformanceHintBenchmark benchmark =
+            new PerformanceHintBenchmark(processor, ThreadSafeSRProcessor.ProcessingMode.CPU, tile);
+        PerformanceHintBenchmark.Result[] results = benchmark.run(3, 40, 30, 10_000);
+
+        PerformanceHintBenchmark.Result before = results[0];
+        PerformanceHintBenchmark.Result after = results[1];
+        Log.i("PerformanceHintBenchmarkTest", before + "\n" + after);
+        Log.i("PerformanceHintBenchmarkTest", String.format(Locale.US, "cv %.3f -> %.3f, p95 %.1fms -> %.1fms",
+              before.getCoefficientOfVariation(), after.getCoefficientOfVariation(), before.p95Ms, after.p95Ms));
+        assertTrue("No tiles completed without hints", before.completed > 0);
+        assertTrue("No tiles completed with hints", after.completed > 0);
+    }
+}
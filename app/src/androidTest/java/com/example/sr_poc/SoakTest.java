@@ -0,0 +1,100 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.os.Bundle;
+import android.util.Log;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import com.example.sr_poc.benchmark.SoakRunner;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+/**
+ * Long-run soak over every bundled image and backend. Flags latency drift and Java/native/PSS growth trends.
+ * The duration defaults to a short smoke run; pass instrumentation arguments for a real soak:
+ * <pre>
+ * adb shell am instrument -w -e class com.example.sr_poc.SoakTest -e soakMinutes 120 -e windowSeconds 60 \
+ *     com.example.sr_poc.test/androidx.test.runner.AndroidJUnitRunner
+ * </pre>
+ * Per-window results are written to logcat under the SoakRunner tag.
+ */
+@RunWith(AndroidJUnit4.class)
+public class SoakTest {
+
+    private ThreadSafeSRProcessor processor;
+    private final List<Bitmap> images = new ArrayList<>();
+
+    @Before
+    public void setUp() throws Exception {
+        Context context = InstrumentationRegistry.getInstrumentation().getTargetContext();
+        processor = new ThreadSafeSRProcessor(context);
+
+        CountDownLatch initialized = new CountDownLatch(1);
+        boolean[] success = new boolean[1];
+        processor.initialize((ok, message) -> {
+            success[0] = ok;
+            initialized.countDown();
+        });
+        assertTrue(initialized.await(60, TimeUnit.SECONDS));
+        assertTrue("Processor failed to initialize", success[0]);
+
+        String[] names = context.getAssets().list("images");
+        assertNotNull(names);
+        for (String name : names) {
+            try (InputStream stream = context.getAssets().open("images/" + name)) {
+                Bitmap decoded = BitmapFactory.decodeStream(stream);
+                if (decoded != null) {
+                    // 直接送模型輸入大小，浸泡的是推理與轉換路徑而非縮放
+                    images.add(Bitmap.createScaledBitmap(decoded, processor.getModelInputWidth(),
+                                                         processor.getModelInputHeight(), true));
+                    decoded.recycle();
+                }
+            }
+        }
+        assertFalse("No bundled images", images.isEmpty());
+    }
+
+    @After
+    public void tearDown() {
+        if (processor != null) {
+            processor.close();
+        }
+        for (Bitmap image : images) {
+            image.recycle();
+        }
+    }
+
+    @Test
+    public void soak() throws Exception {
+        Bundle arguments = InstrumentationRegistry.getArguments();
+        long minutes = Long.parseLong(arguments.getString("soakMinutes", "3"));
+        long windowSeconds = Long.parseLong(arguments.getString("windowSeconds", "20"));
+
+        SoakRunner runner = new SoakRunner(processor, images, ThreadSafeSRProcessor.ProcessingMode.values());
+        SoakRunner.Report report = runner.run(TimeUnit.MINUTES.toMillis(minutes),
+                                              TimeUnit.SECONDS.toMillis(windowSeconds),
+                                              new SoakRunner.Thresholds());
+
+        for (SoakRunner.Window window : report.windows) {
+            Log.i("SoakTest", window.toString());
+        }
+        Log.i("SoakTest", report.toString());
+        assertTrue("No successful runs", report.totalRuns > 0);
+        assertFalse(report.toString(), report.hasRegression());
+    }
+}
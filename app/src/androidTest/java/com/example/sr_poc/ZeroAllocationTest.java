@@ -0,0 +1,192 @@
+package com.example.sr_poc;
+
+import android.graphics.Bitmap;
+import android.os.Debug;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+
+import com.example.sr_poc.processing.BandWorkers;
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.PostProcessChain;
+import com.example.sr_poc.processing.TensorPipeline;
+import com.example.sr_poc.processing.TilePlan;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.tensorflow.lite.DataType;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.function.IntSupplier;
+
+import static org.junit.Assert.*;
+
+/**
+ * Steady-state tiles through the conversion core (input conversion, fused output kernel, parallel bands)
+ * and through TileProcessor's tile loop (prefetch, pending-tile bookkeeping, timings, assembly) must not
+ * allocate once warmed up. Allocations are counted with ART allocation counting on the calling thread and,
+ * through the BandWorkers and TileProcessor prefetch probes, on every band thread and the prefetch thread.
+ *
+ * Inference itself is stubbed (the output tensor is filled once): the TFLite Java Interpreter.run wrapper
+ * allocates its argument arrays per call, and ThreadSafeSRProcessor's request queueing allocates a request
+ * per tile; both are outside the code this test guards.
+ */
+@RunWith(AndroidJUnit4.class)
+public class ZeroAllocationTest {
+
+    private static final int TILE = 256;
+    private static final int SCALE = 4;
+    private static final int WARMUP_TILES = 8;
+    private static final int STEADY_TILES = 32;
+    private static final int LOOP_TILE = 64;
+    private static final int LOOP_OVERLAP = 8;
+
+    private BandWorkers workers;
+
+    @Before
+    public void setUp() {
+        workers = new BandWorkers("ZeroAllocTest", 3);
+    }
+
+    @After
+    public void tearDown() {
+        workers.setProbe(null);
+        workers.close();
+    }
+
+    @Test
+    public void unitScaleTilesDoNotAllocate() {
+        assertSteadyStateAllocationFree(PostProcessChain.EMPTY, 0);
+    }
+
+    @Test
+    public void resampledTilesWithPostOpsDoNotAllocate() {
+        PostProcessChain chain = new PostProcessChain.Builder().sharpen(0.3f).gamma(1.1f).dither().build();
+        // 輸出 1.5 倍目標（非模型倍率），每塊都需重取樣
+        assertSteadyStateAllocationFree(chain, 1.5f);
+    }
+
+    @Test
+    public void tileProcessorLoopDoesNotAllocate() {
+        int outSize = LOOP_TILE * SCALE;
+        TensorPipeline pipeline = TensorPipeline.create(
+            new int[] {1, LOOP_TILE, LOOP_TILE, 3}, DataType.FLOAT32,
+            new int[] {1, outSize, outSize, 3}, DataType.FLOAT32, workers);
+        fillOutput(pipeline.getOutputBuffer());
+
+        TileProcessor processor = new TileProcessor(LOOP_TILE, SCALE, LOOP_OVERLAP, (input, output, region) -> {
+            pipeline.writeInput(input, 0);
+            pipeline.getInputBuffer();
+            pipeline.readOutput(region, 0, output);
+            return true;
+        });
+        processor.setProcessingMode(ThreadSafeSRProcessor.ProcessingMode.CPU);
+
+        // 7x7 塊：前 WARMUP_TILES 塊暖機，其餘在計數中完成
+        Bitmap input = Bitmap.createBitmap(LOOP_TILE * 6, LOOP_TILE * 6, Bitmap.Config.ARGB_8888);
+        input.eraseColor(0xFF336699);
+        IntSupplier probe = Debug::getThreadAllocCount;
+        long[] counts = {-1, -1, -1};
+        int[] measured = new int[1];
+        TileProcessor.ProcessCallback callback = (completed, total) -> {
+            if (completed == WARMUP_TILES) {
+                Debug.startAllocCounting();
+                Debug.resetThreadAllocCount();
+                workers.setProbe(probe);
+                processor.setPrefetchProbe(probe);
+            } else if (completed == total) {
+                counts[0] = Debug.getThreadAllocCount();
+                counts[1] = workers.getProbeTotal();
+                counts[2] = processor.getPrefetchProbeTotal();
+                measured[0] = total - WARMUP_TILES;
+                workers.setProbe(null);
+                processor.setPrefetchProbe(null);
+                Debug.stopAllocCounting();
+            }
+        };
+
+        Bitmap output = processor.processByTiles(input, callback);
+        try {
+            assertNotNull(output);
+            assertTrue("Too few tiles measured: " + measured[0], measured[0] >= STEADY_TILES);
+            assertEquals("Allocations on the tile loop thread after warmup", 0, counts[0]);
+            assertEquals("Allocations on band threads after warmup", 0, counts[1]);
+            assertEquals("Allocations on the prefetch thread after warmup", 0, counts[2]);
+        } finally {
+            input.recycle();
+            if (output != null) {
+                output.recycle();
+            }
+        }
+    }
+
+    private void assertSteadyStateAllocationFree(PostProcessChain chain, float targetScale) {
+        int outSize = TILE * SCALE;
+        TensorPipeline pipeline = TensorPipeline.create(
+            new int[] {1, TILE, TILE, 3}, DataType.FLOAT32,
+            new int[] {1, outSize, outSize, 3}, DataType.FLOAT32, workers);
+        pipeline.setPostProcessChain(chain);
+        fillOutput(pipeline.getOutputBuffer());
+
+        // 區域在計時外預先算好（TilePlan.regionFor 每次建立新的 OutputRegion）
+        int imageSize = TILE * 4;
+        TilePlan plan = new TilePlan(imageSize, imageSize, TILE, 16, SCALE);
+        int targetSize = targetScale > 0 ? Math.round(imageSize * targetScale) : plan.getOutputWidth();
+        List<OutputRegion> regions = new ArrayList<>();
+        int maxWidth = 1;
+        int maxHeight = 1;
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, targetSize, targetSize);
+            if (region.width > 0 && region.height > 0) {
+                regions.add(region);
+                maxWidth = Math.max(maxWidth, region.width);
+                maxHeight = Math.max(maxHeight, region.height);
+            }
+        }
+
+        Bitmap input = Bitmap.createBitmap(TILE, TILE, Bitmap.Config.ARGB_8888);
+        input.eraseColor(0xFF336699);
+        Bitmap dst = Bitmap.createBitmap(maxWidth, maxHeight, Bitmap.Config.ARGB_8888);
+
+        try {
+            for (int i = 0; i < WARMUP_TILES; i++) {
+                runTile(pipeline, input, regions.get(i % regions.size()), dst);
+            }
+
+            Debug.startAllocCounting();
+            Debug.resetThreadAllocCount();
+            workers.setProbe(Debug::getThreadAllocCount);
+            for (int i = 0; i < STEADY_TILES; i++) {
+                runTile(pipeline, input, regions.get(i % regions.size()), dst);
+            }
+            int callerAllocations = Debug.getThreadAllocCount();
+            long bandAllocations = workers.getProbeTotal();
+            workers.setProbe(null);
+            Debug.stopAllocCounting();
+
+            assertEquals("Allocations on the calling thread after warmup", 0, callerAllocations);
+            assertEquals("Allocations on band threads after warmup", 0, bandAllocations);
+        } finally {
+            input.recycle();
+            dst.recycle();
+        }
+    }
+
+    private static void runTile(TensorPipeline pipeline, Bitmap input, OutputRegion region, Bitmap dst) {
+        pipeline.writeInput(input);
+        pipeline.getInputBuffer();
+        pipeline.readOutput(region, 0, dst);
+    }
+
+    private static void fillOutput(ByteBuffer output) {
+        output.rewind();
+        int count = output.capacity() / 4;
+        for (int i = 0; i < count; i++) {
+            output.putFloat((i % 251) / 250f);
+        }
+        output.rewind();
+    }
+}
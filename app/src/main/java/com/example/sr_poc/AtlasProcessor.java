@@ -0,0 +1,163 @@
+package com.example.sr_poc;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.processing.AtlasPlan;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+
+/**
+ * 將多張小圖拼進模型輸入大小的 atlas，一次推理後再切回各自的放大結果。
+ * 每張圖以原始尺寸放入（不再被拉伸到模型輸入尺寸），輸出為 原寬*倍率 x 原高*倍率。
+ */
+public class AtlasProcessor {
+
+    private static final String TAG = "AtlasProcessor";
+
+    private final ThreadSafeSRProcessor srProcessor;
+    private final int pageWidth;
+    private final int pageHeight;
+    private final int outputScale;
+    private final int gutterPixels;
+    private ThreadSafeSRProcessor.ProcessingMode processingMode; // null表示使用當前模式
+
+    public AtlasProcessor(ThreadSafeSRProcessor processor, ConfigManager configManager) {
+        this.srProcessor = processor;
+        this.pageWidth = processor.getModelInputWidth();
+        this.pageHeight = processor.getModelInputHeight();
+        this.outputScale = Math.max(processor.getModelOutputWidth() / pageWidth,
+                                    processor.getModelOutputHeight() / pageHeight);
+        this.gutterPixels = configManager.getAtlasGutterPixels();
+    }
+
+    public void setProcessingMode(ThreadSafeSRProcessor.ProcessingMode mode) {
+        this.processingMode = mode;
+    }
+
+    /**
+     * 圖片加上gutter後是否放得進單一atlas頁面
+     */
+    public boolean fitsAtlas(Bitmap bitmap) {
+        return bitmap != null
+            && bitmap.getWidth() + 2 * gutterPixels <= pageWidth
+            && bitmap.getHeight() + 2 * gutterPixels <= pageHeight;
+    }
+
+    /**
+     * 處理一組圖片；回傳結果與輸入順序相同，失敗的項目為null。
+     * 放不進atlas的圖片逐張處理（拉伸到模型輸入尺寸，與單張處理相同）。
+     */
+    public List<Bitmap> process(List<Bitmap> images) {
+        int count = images.size();
+        int[] widths = new int[count];
+        int[] heights = new int[count];
+        for (int i = 0; i < count; i++) {
+            widths[i] = images.get(i).getWidth();
+            heights[i] = images.get(i).getHeight();
+        }
+
+        AtlasPlan plan = new AtlasPlan(widths, heights, pageWidth, pageHeight, gutterPixels);
+        int invocations = plan.getPageCount() + plan.getOversized().size();
+        Log.d(TAG, plan + " -> " + invocations + " invocations for " + count + " images");
+
+        List<Bitmap> results = new ArrayList<>(Collections.nCopies(count, (Bitmap) null));
+        CountDownLatch done = new CountDownLatch(invocations);
+
+        // 所有頁面一次送出，讓動態批次視窗有機會合併它們
+        for (List<AtlasPlan.Placement> page : plan.getPages()) {
+            Bitmap atlas = buildPage(images, page);
+            srProcessor.processImageWithMode(atlas, processingMode, new ThreadSafeSRProcessor.InferenceCallback() {
+                @Override
+                public void onResult(Bitmap resultBitmap, long inferenceTime) {
+                    cutPage(resultBitmap, page, results);
+                    resultBitmap.recycle();
+                    atlas.recycle();
+                    done.countDown();
+                }
+
+                @Override
+                public void onError(String error) {
+                    Log.e(TAG, "Atlas page failed: " + error);
+                    atlas.recycle();
+                    done.countDown();
+                }
+            });
+        }
+
+        for (int index : plan.getOversized()) {
+            srProcessor.processImageWithMode(images.get(index), processingMode, new ThreadSafeSRProcessor.InferenceCallback() {
+                @Override
+                public void onResult(Bitmap resultBitmap, long inferenceTime) {
+                    synchronized (results) {
+                        results.set(index, resultBitmap);
+                    }
+                    done.countDown();
+                }
+
+                @Override
+                public void onError(String error) {
+                    Log.e(TAG, "Image " + index + " failed: " + error);
+                    done.countDown();
+                }
+            });
+        }
+
+        try {
+            done.await();
+        } catch (InterruptedException e) {
+            Log.e(TAG, "Wait interrupted");
+            Thread.currentThread().interrupt();
+        }
+
+        synchronized (results) {
+            return new ArrayList<>(results);
+        }
+    }
+
+    /**
+     * 組出一頁atlas：每張圖放在其位置，gutter以該圖的邊緣像素延伸填滿
+     */
+    private Bitmap buildPage(List<Bitmap> images, List<AtlasPlan.Placement> page) {
+        Bitmap atlas = Bitmap.createBitmap(pageWidth, pageHeight, Bitmap.Config.ARGB_8888);
+
+        for (AtlasPlan.Placement placement : page) {
+            Bitmap image = images.get(placement.imageIndex);
+            int width = placement.width;
+            int height = placement.height;
+            int paddedWidth = width + 2 * gutterPixels;
+            int paddedHeight = height + 2 * gutterPixels;
+
+            int[] source = new int[width * height];
+            image.getPixels(source, 0, width, 0, 0, width, height);
+
+            int[] padded = new int[paddedWidth * paddedHeight];
+            for (int y = 0; y < paddedHeight; y++) {
+                int sy = Math.min(height - 1, Math.max(0, y - gutterPixels));
+                int rowOffset = y * paddedWidth;
+                int sourceOffset = sy * width;
+                for (int x = 0; x < paddedWidth; x++) {
+                    int sx = Math.min(width - 1, Math.max(0, x - gutterPixels));
+                    padded[rowOffset + x] = source[sourceOffset + sx];
+                }
+            }
+
+            atlas.setPixels(padded, 0, paddedWidth, placement.x - gutterPixels, placement.y - gutterPixels,
+                            paddedWidth, paddedHeight);
+        }
+        return atlas;
+    }
+
+    private void cutPage(Bitmap output, List<AtlasPlan.Placement> page, List<Bitmap> results) {
+        for (AtlasPlan.Placement placement : page) {
+            Bitmap region = Bitmap.createBitmap(output, placement.x * outputScale, placement.y * outputScale,
+                                                placement.width * outputScale, placement.height * outputScale);
+            synchronized (results) {
+                results.set(placement.imageIndex, region);
+            }
+        }
+    }
+}
@@ -28,6 +28,7 @@ public class ConfigManager {
     private String defaultModelPath;
     private int expectedScaleFactor;
     private int channels;
+    private float targetOutputScale;
     private int defaultNumThreads;
     private boolean useXnnpack;
     private boolean allowFp16Precision;
@@ -48,6 +49,70 @@ public class ConfigManager {
     private boolean allowFp16OnNpu;
     private String npuAcceleratorName;
     
+    // Cross-request dynamic batching
+    private int batchMaxSize;
+    private long batchMaxDelayMs;
+    
+    // Small-image atlas packing
+    private boolean atlasEnabled;
+    private int atlasGutterPixels;
+    
+    // Speculative background processing
+    private boolean speculativeEnabled;
+    private long speculativeDelayMs;
+    
+    // Persistent result store
+    private boolean resultStoreEnabled;
+    private long resultStoreMaxBytes;
+    private String resultStoreFormat;
+    
+    // Deep Zoom pyramid output
+    private int pyramidTileSize;
+    private int pyramidOverlap;
+    private String pyramidFormat;
+    private int pyramidQuality;
+    
+    // Out-of-process tile workers
+    private boolean workersEnabled;
+    private int workerCount;
+    
+    // Real-time playback
+    private String realtimeMissPolicy;
+    private int realtimeBudgetFrames;
+    private double realtimeCostEmaAlpha;
+    
+    // Energy measurement
+    private boolean energyEnabled;
+    private long energySampleIntervalMs;
+    
+    // Memory timeline sampling
+    private boolean memorySamplerEnabled;
+    private long memorySampleIntervalMs;
+    private int memoryFullSampleEvery;
+    
+    // Per-job telemetry log
+    private boolean telemetryEnabled;
+    private long telemetryMaxFileBytes;
+    private int telemetryMaxFiles;
+    
+    // Workload capture
+    private boolean workloadCaptureEnabled;
+    private boolean workloadCaptureInputs;
+    
+    // UI jank monitor
+    private boolean jankMonitorEnabled;
+    
+    // Performance hint sessions for inference threads
+    private boolean performanceHintEnabled;
+    private int performanceHintTargetMs;
+    private int performanceHintThreadPriority;
+    
+    // Post-processing (fused into output conversion)
+    private float postSharpenAmount;
+    private float postGamma;
+    private boolean postSrgbEncode;
+    private boolean postDither;
+    
     private ConfigManager(Context context) {
         this.context = context.getApplicationContext();
         loadConfig();
@@ -95,6 +160,10 @@ public class ConfigManager {
         expectedScaleFactor = modelConfig.getInt("expected_scale_factor");
         channels = modelConfig.getInt("channels");
         
+        // Output configuration (0 = model native scale)
+        JSONObject outputConfig = config.optJSONObject("output");
+        targetOutputScale = outputConfig != null ? (float) outputConfig.optDouble("target_scale", 0.0) : 0f;
+        
         
         // Processing configuration
         JSONObject processingConfig = config.getJSONObject("processing");
@@ -119,6 +188,162 @@ public class ConfigManager {
             npuAcceleratorName = "";
         }
         
+        // Dynamic batching configuration
+        JSONObject batchingConfig = config.optJSONObject("batching");
+        if (batchingConfig != null && batchingConfig.optBoolean("enabled", false)) {
+            batchMaxSize = batchingConfig.optInt("max_batch_size", 4);
+            batchMaxDelayMs = batchingConfig.optLong("max_delay_ms", 5);
+        } else {
+            batchMaxSize = 1;
+            batchMaxDelayMs = 0;
+        }
+        
+        // Atlas configuration
+        JSONObject atlasConfig = config.optJSONObject("atlas");
+        if (atlasConfig != null) {
+            atlasEnabled = atlasConfig.optBoolean("enabled", true);
+            atlasGutterPixels = atlasConfig.optInt("gutter_pixels", 16);
+        } else {
+            atlasEnabled = true;
+            atlasGutterPixels = 16;
+        }
+        
+        // Speculative processing configuration
+        JSONObject speculativeConfig = config.optJSONObject("speculative");
+        if (speculativeConfig != null) {
+            speculativeEnabled = speculativeConfig.optBoolean("enabled", true);
+            speculativeDelayMs = speculativeConfig.optLong("start_delay_ms", 500);
+        } else {
+            speculativeEnabled = true;
+            speculativeDelayMs = 500;
+        }
+        
+        // Result store configuration
+        JSONObject storeConfig = config.optJSONObject("result_store");
+        if (storeConfig != null) {
+            resultStoreEnabled = storeConfig.optBoolean("enabled", true);
+            resultStoreMaxBytes = storeConfig.optLong("max_size_mb", 256) * 1024 * 1024;
+            resultStoreFormat = storeConfig.optString("format", "png");
+        } else {
+            resultStoreEnabled = true;
+            resultStoreMaxBytes = 256L * 1024 * 1024;
+            resultStoreFormat = "png";
+        }
+        
+        // Pyramid output configuration
+        JSONObject pyramidConfig = config.optJSONObject("pyramid");
+        if (pyramidConfig != null) {
+            pyramidTileSize = pyramidConfig.optInt("tile_size", 254);
+            pyramidOverlap = pyramidConfig.optInt("overlap", 1);
+            pyramidFormat = pyramidConfig.optString("format", "jpg");
+            pyramidQuality = pyramidConfig.optInt("quality", 90);
+        } else {
+            pyramidTileSize = 254;
+            pyramidOverlap = 1;
+            pyramidFormat = "jpg";
+            pyramidQuality = 90;
+        }
+        
+        // Tile worker configuration
+        JSONObject workerConfig = config.optJSONObject("workers");
+        if (workerConfig != null) {
+            workersEnabled = workerConfig.optBoolean("enabled", false);
+            workerCount = Math.max(1, workerConfig.optInt("count", 2));
+        } else {
+            workersEnabled = false;
+            workerCount = 2;
+        }
+        
+        // Real-time playback configuration
+        JSONObject realtimeConfig = config.optJSONObject("realtime");
+        if (realtimeConfig != null) {
+            realtimeMissPolicy = realtimeConfig.optString("miss_policy", "fallback");
+            realtimeBudgetFrames = realtimeConfig.optInt("latency_budget_frames", 2);
+            realtimeCostEmaAlpha = realtimeConfig.optDouble("cost_ema_alpha", 0.2);
+        } else {
+            realtimeMissPolicy = "fallback";
+            realtimeBudgetFrames = 2;
+            realtimeCostEmaAlpha = 0.2;
+        }
+        
+        // Energy measurement configuration
+        JSONObject energyConfig = config.optJSONObject("energy");
+        if (energyConfig != null) {
+            energyEnabled = energyConfig.optBoolean("enabled", true);
+            energySampleIntervalMs = energyConfig.optLong("sample_interval_ms", 100);
+        } else {
+            energyEnabled = true;
+            energySampleIntervalMs = 100;
+        }
+        
+        // Memory timeline sampling configuration
+        JSONObject memorySamplerConfig = config.optJSONObject("memory_sampler");
+        if (memorySamplerConfig != null) {
+            memorySamplerEnabled = memorySamplerConfig.optBoolean("enabled", true);
+            memorySampleIntervalMs = memorySamplerConfig.optLong("interval_ms", 50);
+            memoryFullSampleEvery = memorySamplerConfig.optInt("full_sample_every", 10);
+        } else {
+            memorySamplerEnabled = true;
+            memorySampleIntervalMs = 50;
+            memoryFullSampleEvery = 10;
+        }
+        
+        // Per-job telemetry log configuration
+        JSONObject telemetryConfig = config.optJSONObject("telemetry");
+        if (telemetryConfig != null) {
+            telemetryEnabled = telemetryConfig.optBoolean("enabled", true);
+            telemetryMaxFileBytes = telemetryConfig.optLong("max_file_bytes", 1024 * 1024);
+            telemetryMaxFiles = telemetryConfig.optInt("max_files", 5);
+        } else {
+            telemetryEnabled = true;
+            telemetryMaxFileBytes = 1024 * 1024;
+            telemetryMaxFiles = 5;
+        }
+        
+        // Workload capture configuration
+        JSONObject workloadConfig = config.optJSONObject("workload_capture");
+        if (workloadConfig != null) {
+            workloadCaptureEnabled = workloadConfig.optBoolean("enabled", false);
+            workloadCaptureInputs = workloadConfig.optBoolean("capture_inputs", false);
+        } else {
+            workloadCaptureEnabled = false;
+            workloadCaptureInputs = false;
+        }
+        
+        // UI jank monitor configuration
+        JSONObject jankConfig = config.optJSONObject("jank_monitor");
+        if (jankConfig != null) {
+            jankMonitorEnabled = jankConfig.optBoolean("enabled", false);
+        } else {
+            jankMonitorEnabled = false;
+        }
+        
+        // Performance hint configuration
+        JSONObject hintConfig = config.optJSONObject("performance_hint");
+        if (hintConfig != null) {
+            performanceHintEnabled = hintConfig.optBoolean("enabled", true);
+            performanceHintTargetMs = hintConfig.optInt("target_ms", 50);
+            performanceHintThreadPriority = hintConfig.optInt("thread_priority", -2);
+        } else {
+            performanceHintEnabled = true;
+            performanceHintTargetMs = 50;
+            performanceHintThreadPriority = -2;
+        }
+        
+        // Post-processing configuration
+        JSONObject postConfig = config.optJSONObject("postprocess");
+        if (postConfig != null) {
+            postSharpenAmount = (float) postConfig.optDouble("sharpen_amount", 0.0);
+            postGamma = (float) postConfig.optDouble("gamma", 1.0);
+            postSrgbEncode = postConfig.optBoolean("srgb_encode", false);
+            postDither = postConfig.optBoolean("dither", false);
+        } else {
+            postSharpenAmount = 0f;
+            postGamma = 1f;
+            postSrgbEncode = false;
+            postDither = false;
+        }
+        
         // Tiling configuration
         JSONObject tilingConfig = config.getJSONObject("tiling");
         overlapPixels = tilingConfig.getInt("overlap_pixels");
@@ -139,6 +364,7 @@ public class ConfigManager {
         defaultModelPath = "models/DSCF_float32.tflite";
         expectedScaleFactor = 4;
         channels = 3;
+        targetOutputScale = 0f;
         defaultNumThreads = 4;
         useXnnpack = true;
         allowFp16Precision = true;
@@ -158,12 +384,77 @@ public class ConfigManager {
         enableNpu = true;
         allowFp16OnNpu = true;
         npuAcceleratorName = "";
+        
+        // Batching defaults (disabled)
+        batchMaxSize = 1;
+        batchMaxDelayMs = 0;
+        
+        // Atlas defaults
+        atlasEnabled = true;
+        atlasGutterPixels = 16;
+        
+        // Speculative defaults
+        speculativeEnabled = true;
+        speculativeDelayMs = 500;
+        
+        // Result store defaults
+        resultStoreEnabled = true;
+        resultStoreMaxBytes = 256L * 1024 * 1024;
+        resultStoreFormat = "png";
+        
+        // Pyramid output defaults
+        pyramidTileSize = 254;
+        pyramidOverlap = 1;
+        pyramidFormat = "jpg";
+        pyramidQuality = 90;
+        
+        // Tile worker defaults
+        workersEnabled = false;
+        workerCount = 2;
+        
+        // Real-time playback defaults
+        realtimeMissPolicy = "fallback";
+        realtimeBudgetFrames = 2;
+        realtimeCostEmaAlpha = 0.2;
+        
+        // Energy measurement defaults
+        energyEnabled = true;
+        energySampleIntervalMs = 100;
+        
+        // Memory timeline sampling defaults
+        memorySamplerEnabled = true;
+        memorySampleIntervalMs = 50;
+        memoryFullSampleEvery = 10;
+        
+        // Per-job telemetry log defaults
+        telemetryEnabled = true;
+        telemetryMaxFileBytes = 1024 * 1024;
+        telemetryMaxFiles = 5;
+        
+        // Workload capture defaults
+        workloadCaptureEnabled = false;
+        workloadCaptureInputs = false;
+        
+        // UI jank monitor defaults
+        jankMonitorEnabled = false;
+        
+        // Performance hint defaults
+        performanceHintEnabled = true;
+        performanceHintTargetMs = 50;
+        performanceHintThreadPriority = -2;
+        
+        // Post-processing defaults
+        postSharpenAmount = 0f;
+        postGamma = 1f;
+        postSrgbEncode = false;
+        postDither = false;
     }
     
     // Essential getter methods
     public String getDefaultModelPath() { return defaultModelPath; }
     public int getExpectedScaleFactor() { return expectedScaleFactor; }
     public int getChannels() { return channels; }
+    public float getTargetOutputScale() { return targetOutputScale; }
     public int getDefaultNumThreads() { return defaultNumThreads; }
     public boolean isUseXnnpack() { return useXnnpack; }
     public boolean isAllowFp16Precision() { return allowFp16Precision; }
@@ -184,6 +475,70 @@ public class ConfigManager {
     public boolean isAllowFp16OnNpu() { return allowFp16OnNpu; }
     public String getNpuAcceleratorName() { return npuAcceleratorName; }
     
+    // Batching getters
+    public int getBatchMaxSize() { return batchMaxSize; }
+    public long getBatchMaxDelayMs() { return batchMaxDelayMs; }
+    
+    // Atlas getters
+    public boolean isAtlasEnabled() { return atlasEnabled; }
+    public int getAtlasGutterPixels() { return atlasGutterPixels; }
+    
+    // Speculative getters
+    public boolean isSpeculativeEnabled() { return speculativeEnabled; }
+    public long getSpeculativeDelayMs() { return speculativeDelayMs; }
+    
+    // Result store getters
+    public boolean isResultStoreEnabled() { return resultStoreEnabled; }
+    public long getResultStoreMaxBytes() { return resultStoreMaxBytes; }
+    public String getResultStoreFormat() { return resultStoreFormat; }
+    
+    // Pyramid output getters
+    public int getPyramidTileSize() { return pyramidTileSize; }
+    public int getPyramidOverlap() { return pyramidOverlap; }
+    public String getPyramidFormat() { return pyramidFormat; }
+    public int getPyramidQuality() { return pyramidQuality; }
+    
+    // Tile worker getters
+    public boolean isWorkersEnabled() { return workersEnabled; }
+    public int getWorkerCount() { return workerCount; }
+    
+    // Real-time playback getters
+    public String getRealtimeMissPolicy() { return realtimeMissPolicy; }
+    public int getRealtimeBudgetFrames() { return realtimeBudgetFrames; }
+    public double getRealtimeCostEmaAlpha() { return realtimeCostEmaAlpha; }
+    
+    // Energy measurement getters
+    public boolean isEnergyEnabled() { return energyEnabled; }
+    public long getEnergySampleIntervalMs() { return energySampleIntervalMs; }
+    
+    // Memory timeline sampling getters
+    public boolean isMemorySamplerEnabled() { return memorySamplerEnabled; }
+    public long getMemorySampleIntervalMs() { return memorySampleIntervalMs; }
+    public int getMemoryFullSampleEvery() { return memoryFullSampleEvery; }
+    
+    // Per-job telemetry log getters
+    public boolean isTelemetryEnabled() { return telemetryEnabled; }
+    public long getTelemetryMaxFileBytes() { return telemetryMaxFileBytes; }
+    public int getTelemetryMaxFiles() { return telemetryMaxFiles; }
+    
+    // Workload capture getters
+    public boolean isWorkloadCaptureEnabled() { return workloadCaptureEnabled; }
+    public boolean isWorkloadCaptureInputs() { return workloadCaptureInputs; }
+    
+    // UI jank monitor getters
+    public boolean isJankMonitorEnabled() { return jankMonitorEnabled; }
+    
+    // Performance hint getters
+    public boolean isPerformanceHintEnabled() { return performanceHintEnabled; }
+    public int getPerformanceHintTargetMs() { return performanceHintTargetMs; }
+    public int getPerformanceHintThreadPriority() { return performanceHintThreadPriority; }
+    
+    // Post-processing getters
+    public float getPostSharpenAmount() { return postSharpenAmount; }
+    public float getPostGamma() { return postGamma; }
+    public boolean isPostSrgbEncode() { return postSrgbEncode; }
+    public boolean isPostDither() { return postDither; }
+    
     // Simple setters
     public void setDefaultTilingEnabled(boolean enabled) {
         this.defaultTilingEnabled = enabled;
@@ -13,11 +13,21 @@ import android.util.Log;
 import android.view.MotionEvent;
 import android.view.View;
 
+import com.example.sr_poc.processing.TileTimings;
 import com.example.sr_poc.utils.Constants;
 
+import java.util.Locale;
+
 public class ImageComparisonView extends View {
     private static final String TAG = "ImageComparisonView";
     
+    /**
+     * 結果上的逐tile熱圖：耗時（綠→紅）或處理決策（顏色見 decisionColor）
+     */
+    public enum HeatmapMode { OFF, LATENCY, DECISION }
+    
+    private static final int HEATMAP_ALPHA = 0x70;
+    
     private Bitmap originalBitmap;
     private Bitmap processedBitmap;
     private float dividerPosition = 0.5f; // 0.0 = 完全顯示原圖, 1.0 = 完全顯示處理後的圖
@@ -25,6 +35,10 @@ public class ImageComparisonView extends View {
     private Paint textPaint;
     private Paint backgroundPaint;
     private boolean isDragging = false;
+    private TileTimings tileTimings;
+    private HeatmapMode heatmapMode = HeatmapMode.OFF;
+    private Paint heatmapPaint;
+    private final RectF tileRect = new RectF();
     
     
     public ImageComparisonView(Context context) {
@@ -60,6 +74,9 @@ public class ImageComparisonView extends View {
         backgroundPaint = new Paint();
         backgroundPaint.setColor(0x80000000);
         backgroundPaint.setAntiAlias(true);
+        
+        heatmapPaint = new Paint();
+        heatmapPaint.setStyle(Paint.Style.FILL);
     }
     
     public void setOriginalBitmap(Bitmap bitmap) {
@@ -72,6 +89,20 @@ public class ImageComparisonView extends View {
         invalidate();
     }
     
+    /**
+     * 處理後圖對應的逐tile耗時；null表示沒有（未分塊或結果來自儲存）
+     */
+    public void setTileTimings(TileTimings timings) {
+        this.tileTimings = timings;
+        invalidate();
+    }
+    
+    public HeatmapMode cycleHeatmapMode() {
+        heatmapMode = HeatmapMode.values()[(heatmapMode.ordinal() + 1) % HeatmapMode.values().length];
+        invalidate();
+        return heatmapMode;
+    }
+    
     public void setDividerPosition(float position) {
         this.dividerPosition = Math.max(0f, Math.min(1f, position));
         invalidate();
@@ -141,10 +172,61 @@ public class ImageComparisonView extends View {
         // 繪製圖片
         RectF destRect = new RectF(offsetX, offsetY, offsetX + scaledWidth, offsetY + scaledHeight);
         canvas.drawBitmap(bitmap, null, destRect, null);
+        if (!isLeft) {
+            drawHeatmap(canvas, bitmap, offsetX, offsetY, scale);
+        }
         
         canvas.restore();
     }
     
+    private void drawHeatmap(Canvas canvas, Bitmap bitmap, float offsetX, float offsetY, float scale) {
+        TileTimings timings = tileTimings;
+        if (heatmapMode == HeatmapMode.OFF || timings == null || timings.getOutputWidth() <= 0) {
+            return;
+        }
+        // tile座標以輸出圖為準，顯示的圖若經過縮放再換算一次
+        float toView = scale * bitmap.getWidth() / timings.getOutputWidth();
+        long min = timings.getMinLatencyNanos();
+        long range = Math.max(1, timings.getMaxLatencyNanos() - min);
+        for (TileTimings.Record record : timings.getRecords()) {
+            if (record.width <= 0 || record.height <= 0) {
+                continue;
+            }
+            int color;
+            if (heatmapMode == HeatmapMode.LATENCY) {
+                if (record.decision == TileTimings.Decision.FAILED) {
+                    color = 0xFF000000;
+                } else {
+                    float t = Math.min(1f, (record.latencyNanos - min) / (float) range);
+                    color = 0xFF000000 | ((int) (255 * t) << 16) | ((int) (255 * (1 - t)) << 8);
+                }
+            } else {
+                color = decisionColor(record.decision);
+            }
+            heatmapPaint.setColor((color & 0x00FFFFFF) | (HEATMAP_ALPHA << 24));
+            tileRect.set(offsetX + record.left * toView, offsetY + record.top * toView,
+                         offsetX + (record.left + record.width) * toView,
+                         offsetY + (record.top + record.height) * toView);
+            canvas.drawRect(tileRect, heatmapPaint);
+        }
+    }
+    
+    private static int decisionColor(TileTimings.Decision decision) {
+        switch (decision) {
+            case ROUTED:
+                return 0xFF8E24AA; // 紫：worker程序
+            case RETRIED:
+                return 0xFFFB8C00; // 橘：worker失敗後本程序重跑
+            case SKIPPED:
+                return 0xFF9E9E9E;
+            case FAILED:
+                return 0xFFE53935;
+            case INFERRED:
+            default:
+                return 0xFF1E88E5; // 藍：本程序推理
+        }
+    }
+    
     private void drawLabels(Canvas canvas, int width, int height, int dividerX) {
         float labelY = 30f;
         
@@ -160,7 +242,7 @@ public class ImageComparisonView extends View {
         
         // Right label  
         if (width - dividerX > 80) {
-            String rightLabel = "Enhanced";
+            String rightLabel = "Enhanced" + heatmapLabel();
             float rightTextWidth = textPaint.measureText(rightLabel);
             float rightLabelX = dividerX + (width - dividerX - rightTextWidth) / 2f;
             
@@ -169,6 +251,18 @@ public class ImageComparisonView extends View {
         }
     }
     
+    private String heatmapLabel() {
+        TileTimings timings = tileTimings;
+        if (heatmapMode == HeatmapMode.OFF || timings == null) {
+            return "";
+        }
+        if (heatmapMode == HeatmapMode.DECISION) {
+            return " (tile decisions)";
+        }
+        return String.format(Locale.US, " (tile %.0f-%.0fms)", timings.getMinLatencyNanos() / 1e6,
+                             timings.getMaxLatencyNanos() / 1e6);
+    }
+    
     @Override
     public boolean onTouchEvent(MotionEvent event) {
         float x = event.getX();
@@ -11,6 +11,8 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
 
+import com.example.sr_poc.processing.ParallelImageDecoder;
+import com.example.sr_poc.utils.BitmapPool;
 import com.example.sr_poc.utils.Constants;
 
 public class ImageManager {
@@ -21,6 +23,8 @@ public class ImageManager {
     private List<String> imageNames;
     private int currentIndex;
     private Bitmap currentBitmap;
+    private final BitmapPool stripPool = new BitmapPool(32L * 1024 * 1024); // 分段解碼的暫存strip
+    private final ParallelImageDecoder decoder = new ParallelImageDecoder(stripPool);
     
     public ImageManager(Context context) {
         this.context = context;
@@ -55,8 +59,9 @@ public class ImageManager {
         String imageName = imageNames.get(currentIndex);
         String imagePath = Constants.IMAGES_PATH + imageName;
         
-        try (InputStream inputStream = context.getAssets().open(imagePath)) {
-            currentBitmap = BitmapFactory.decodeStream(inputStream);
+        try {
+            // 顯示中的Bitmap仍被畫面與背景處理引用，因此每次解碼到新的Bitmap
+            currentBitmap = decodeImage(imagePath);
             
             if (currentBitmap != null) {
                 Log.d(TAG, String.format("Loaded image: %s (%dx%d)", 
@@ -73,6 +78,17 @@ public class ImageManager {
         }
     }
     
+    private Bitmap decodeImage(String imagePath) throws IOException {
+        try {
+            return decoder.decodeAsset(context.getAssets(), imagePath, null);
+        } catch (IOException | RuntimeException e) {
+            Log.w(TAG, "Parallel decode failed, falling back to BitmapFactory: " + e.getMessage());
+            try (InputStream inputStream = context.getAssets().open(imagePath)) {
+                return BitmapFactory.decodeStream(inputStream);
+            }
+        }
+    }
+    
     public Bitmap getCurrentBitmap() {
         return currentBitmap;
     }
@@ -13,7 +13,20 @@ import android.util.Log;
 import androidx.appcompat.app.AppCompatActivity;
 
 import com.example.sr_poc.processing.ProcessingController;
+import com.example.sr_poc.processing.ResultStore;
+import com.example.sr_poc.processing.SpeculativeScheduler;
+import com.example.sr_poc.processing.TelemetryLog;
+import com.example.sr_poc.processing.TileTimings;
+import com.example.sr_poc.processing.TileWorkerPool;
+import com.example.sr_poc.processing.WorkloadRecorder;
+import com.example.sr_poc.utils.BatteryPowerSource;
+import com.example.sr_poc.utils.EnergyMeter;
+import com.example.sr_poc.utils.JankMonitor;
+import com.example.sr_poc.utils.MemorySampler;
 import com.example.sr_poc.utils.MemoryUtils;
+import com.example.sr_poc.utils.MetricsRegistry;
+
+import java.io.File;
 
 public class MainActivity extends AppCompatActivity {
     
@@ -26,13 +39,25 @@ public class MainActivity extends AppCompatActivity {
     private Button btnResetImage;
     private CheckBox cbEnableTiling;
     private TextView tvInferenceTime;
+    private PerformanceOverlayView performanceOverlay;
     private TextView tvImageInfo;
     
     private ImageManager imageManager;
     private ThreadSafeSRProcessor srProcessor;
     private ConfigManager configManager;
+    private SpeculativeScheduler speculativeScheduler;
+    private ResultStore resultStore;
+    private TileWorkerPool workerPool;
+    private EnergyMeter energyMeter;
+    private MemorySampler memorySampler;
+    private TelemetryLog telemetryLog;
+    private WorkloadRecorder workloadRecorder;
+    private JankMonitor jankMonitor;
+    private boolean processorReady;
+    private ThreadSafeSRProcessor.ProcessingMode lastRequestedMode; // 預先處理沿用上次選擇的模式
     private Bitmap originalBitmap;
     private Bitmap processedBitmap;
+    private File largeResultFile; // 輸出超過heap時的完整結果，下一次產生時刪除
     
     @Override
     protected void onCreate(Bundle savedInstanceState) {
@@ -55,6 +80,7 @@ public class MainActivity extends AppCompatActivity {
         btnResetImage = findViewById(R.id.btnResetImage);
         cbEnableTiling = findViewById(R.id.cbEnableTiling);
         tvInferenceTime = findViewById(R.id.tvInferenceTime);
+        performanceOverlay = findViewById(R.id.performanceOverlay);
         tvImageInfo = findViewById(R.id.tvImageInfo);
         
         // 初始化時禁用所有按鈕並顯示 initing 狀態
@@ -75,6 +101,50 @@ public class MainActivity extends AppCompatActivity {
         
         imageManager = new ImageManager(this);
         srProcessor = new ThreadSafeSRProcessor(this);
+        MetricsRegistry.get().setQueueDepthSource(srProcessor::getBatchQueueDepth);
+        
+        if (configManager.isResultStoreEnabled()) {
+            resultStore = new ResultStore(this, configManager);
+        }
+        
+        if (configManager.isWorkersEnabled() && TileWorkerPool.isSupported()) {
+            workerPool = new TileWorkerPool(this, configManager.getWorkerCount());
+        }
+        
+        if (configManager.isEnergyEnabled()) {
+            BatteryPowerSource battery = new BatteryPowerSource(this);
+            if (battery.isSupported()) {
+                energyMeter = new EnergyMeter(battery, configManager.getEnergySampleIntervalMs());
+            } else {
+                Log.d("MainActivity", "Battery current not reported, energy measurement disabled");
+            }
+        }
+        
+        if (configManager.isMemorySamplerEnabled()) {
+            memorySampler = new MemorySampler(configManager.getMemorySampleIntervalMs(),
+                                              configManager.getMemoryFullSampleEvery());
+        }
+        
+        if (configManager.isTelemetryEnabled()) {
+            telemetryLog = new TelemetryLog(this, configManager);
+        }
+        
+        if (configManager.isWorkloadCaptureEnabled()) {
+            workloadRecorder = new WorkloadRecorder(this, configManager);
+            Log.i("MainActivity", "Capturing workload to " + workloadRecorder.getTraceFile());
+        }
+        
+        if (configManager.isJankMonitorEnabled()) {
+            jankMonitor = new JankMonitor(getWindow(), getWindowManager().getDefaultDisplay().getRefreshRate());
+            jankMonitor.start();
+        }
+        
+        if (configManager.isSpeculativeEnabled()) {
+            ProcessingController speculativeController = new ProcessingController(srProcessor, configManager, imageManager);
+            speculativeController.setWorkerPool(workerPool);
+            speculativeScheduler = new SpeculativeScheduler(srProcessor, speculativeController,
+                configManager.getSpeculativeDelayMs());
+        }
         
         // 異步初始化SR處理器
         srProcessor.initialize(new ThreadSafeSRProcessor.InitCallback() {
@@ -83,10 +153,13 @@ public class MainActivity extends AppCompatActivity {
                 runOnUiThread(() -> {
                     if (success) {
                         Log.d("MainActivity", "SR Processor: " + message);
+                        Log.d("MainActivity", "Pipeline: " + srProcessor.getPipelineInfo());
                         Toast.makeText(MainActivity.this, message, Toast.LENGTH_LONG).show();
                         tvInferenceTime.setText("Ready");
                         // 初始化成功後啟用所有按鈕
                         setButtonsEnabled(true);
+                        processorReady = true;
+                        startSpeculation();
                     } else {
                         Log.e("MainActivity", "SR Processor failed: " + message);
                         Toast.makeText(MainActivity.this, "Failed to initialize: " + message, Toast.LENGTH_LONG).show();
@@ -111,6 +184,15 @@ public class MainActivity extends AppCompatActivity {
         btnResetImage.setOnClickListener(v -> resetToOriginalImage());
         
         // 長按checkbox顯示配置摘要
+        tvImageInfo.setOnLongClickListener(v -> {
+            ImageComparisonView.HeatmapMode mode = imageComparisonView.cycleHeatmapMode();
+            Toast.makeText(this, "Tile heatmap: " + mode, Toast.LENGTH_SHORT).show();
+            return true;
+        });
+        tvInferenceTime.setOnLongClickListener(v -> {
+            performanceOverlay.toggle();
+            return true;
+        });
         cbEnableTiling.setOnLongClickListener(v -> {
             String configSummary = configManager.getConfigSummary();
             Toast.makeText(this, configSummary, Toast.LENGTH_LONG).show();
@@ -122,6 +204,7 @@ public class MainActivity extends AppCompatActivity {
         cbEnableTiling.setOnCheckedChangeListener((buttonView, isChecked) -> {
             configManager.setDefaultTilingEnabled(isChecked);
             Log.d("MainActivity", "Tiling default updated: " + isChecked);
+            startSpeculation();
         });
     }
     
@@ -156,8 +239,17 @@ public class MainActivity extends AppCompatActivity {
         
         // Disable buttons during processing
         setProcessingButtonsEnabled(false);
+        lastRequestedMode = processingMode;
         
         ProcessingController controller = new ProcessingController(srProcessor, configManager, imageManager);
+        controller.setSpeculativeScheduler(speculativeScheduler);
+        controller.setResultStore(resultStore);
+        controller.setWorkerPool(workerPool);
+        controller.setEnergyMeter(energyMeter);
+        controller.setMemorySampler(memorySampler);
+        controller.setTelemetryLog(telemetryLog);
+        controller.setWorkloadRecorder(workloadRecorder);
+        controller.setLargeResultDirectory(new File(getFilesDir(), "large_results"));
         controller.processImage(processingMode, cbEnableTiling.isChecked(), new ProcessingController.ProcessingCallback() {
             @Override
             public void onStart() {
@@ -174,13 +266,27 @@ public class MainActivity extends AppCompatActivity {
             
             @Override
             public void onSuccess(Bitmap resultBitmap, String timeMessage) {
+                TileTimings timings = controller.getLastTileTimings();
                 runOnUiThread(() -> {
                     processedBitmap = resultBitmap;
+                    imageComparisonView.setTileTimings(timings);
                     updateComparisonView();
                     tvInferenceTime.setText(timeMessage);
                 });
             }
             
+            @Override
+            public void onPreviewSuccess(Bitmap preview, int factor, File fullResult, String timeMessage) {
+                Log.i("MainActivity", "Full result written to " + fullResult);
+                runOnUiThread(() -> {
+                    if (largeResultFile != null) {
+                        largeResultFile.delete();
+                    }
+                    largeResultFile = fullResult;
+                });
+                onSuccess(preview, timeMessage);
+            }
+            
             @Override
             public void onError(String error) {
                 runOnUiThread(() -> {
@@ -191,6 +297,9 @@ public class MainActivity extends AppCompatActivity {
             
             @Override
             public void onComplete() {
+                if (jankMonitor != null) {
+                    jankMonitor.report();
+                }
                 runOnUiThread(() -> setProcessingButtonsEnabled(true));
             }
         });
@@ -234,6 +343,17 @@ public class MainActivity extends AppCompatActivity {
                 imageManager.getTotalImages());
             tvImageInfo.setText(imageInfo);
             tvInferenceTime.setText("Ready");
+            
+            startSpeculation();
+        }
+    }
+    
+    /**
+     * 圖片顯示後在背景預先處理；切換圖片時舊的預先處理會被取消
+     */
+    private void startSpeculation() {
+        if (speculativeScheduler != null && processorReady) {
+            speculativeScheduler.speculate(imageManager.getCurrentBitmap(), lastRequestedMode, cbEnableTiling.isChecked());
         }
     }
     
@@ -269,6 +389,31 @@ public class MainActivity extends AppCompatActivity {
     @Override
     protected void onDestroy() {
         super.onDestroy();
+        if (speculativeScheduler != null) {
+            speculativeScheduler.shutdown();
+        }
+        if (resultStore != null) {
+            resultStore.close();
+        }
+        if (workerPool != null) {
+            workerPool.close();
+        }
+        if (energyMeter != null) {
+            energyMeter.close();
+        }
+        if (memorySampler != null) {
+            memorySampler.close();
+        }
+        if (telemetryLog != null) {
+            telemetryLog.close();
+        }
+        if (workloadRecorder != null) {
+            workloadRecorder.close();
+        }
+        if (jankMonitor != null) {
+            jankMonitor.stop();
+        }
+        MetricsRegistry.get().setQueueDepthSource(null);
         if (srProcessor != null) {
             srProcessor.close();
         }
@@ -2,6 +2,9 @@ package com.example.sr_poc;
 
 import android.util.Log;
 
+import com.example.sr_poc.utils.MemorySampler;
+import com.example.sr_poc.utils.StageTrace;
+
 public class PerformanceMonitor {
     
     private static final String TAG = "PerformanceMonitor";
@@ -16,6 +19,25 @@ public class PerformanceMonitor {
         public int outputWidth;
         public int outputHeight;
         public boolean usedTileProcessing;
+        public String model;
+        public double energyJoules = -1; // 負值表示未量測
+        public StageTrace stageTrace;
+        public MemorySampler.Report memoryReport; // 未啟用取樣時為 null
+        public int tileSize;        // 分塊處理時的tile邊長
+        public int tilesX;          // 分塊處理時的tile網格
+        public int tilesY;
+        public String resultSource; // render / store / speculative
+        public int previewFactor = 1; // 大於1時交出的是1/previewFactor的預覽，輸出尺寸仍為完整結果
+        public String status = "ok"; // ok / oom / error / null_result
+        public String error;        // 失敗時的例外摘要
+        
+        /**
+         * 每百萬輸出像素的能耗；未量測時回傳負值
+         */
+        public double getJoulesPerOutputMegapixel() {
+            long outputPixels = (long) outputWidth * outputHeight;
+            return energyJoules >= 0 && outputPixels > 0 ? energyJoules * 1e6 / outputPixels : -1;
+        }
         
         @Override
         public String toString() {
@@ -27,10 +49,13 @@ public class PerformanceMonitor {
                 "Output: %dx%d\n" +
                 "Memory Before: %dMB\n" +
                 "Memory After: %dMB\n" +
-                "Tile Processing: %s",
+                "Tile Processing: %s\n" +
+                "Energy: %s",
                 inferenceTime, accelerator, inputWidth, inputHeight, 
                 outputWidth, outputHeight, memoryBefore, memoryAfter,
-                usedTileProcessing ? "Yes" : "No"
+                usedTileProcessing ? "Yes" : "No",
+                energyJoules >= 0 ? String.format("%.2f J (%.3f J/MP)", energyJoules, getJoulesPerOutputMegapixel())
+                                  : "not measured"
             );
         }
     }
@@ -45,6 +70,10 @@ public class PerformanceMonitor {
         double megapixelsPerSecond = pixelsPerSecond / 1_000_000.0;
         
         Log.d(TAG, String.format("Processing Speed: %.2f MP/s", megapixelsPerSecond));
+        if (stats.energyJoules >= 0) {
+            Log.d(TAG, String.format("Energy: %.3f J/MP (%s, %s)", stats.getJoulesPerOutputMegapixel(),
+                                     stats.accelerator, stats.model));
+        }
         
         // GPU vs CPU 效能比較參考
         if (stats.accelerator.contains("GPU")) {
@@ -58,6 +87,13 @@ public class PerformanceMonitor {
         if (memoryUsed > 100) {
             Log.w(TAG, "High memory usage detected: " + memoryUsed + "MB");
         }
+        if (stats.memoryReport != null) {
+            // 前後差值看不到工作中途的尖峰與native配置，以時間軸峰值為準
+            Log.d(TAG, "Memory timeline: " + stats.memoryReport);
+            Log.v(TAG, stats.memoryReport.timelineCsv());
+        } else if (stats.stageTrace != null) {
+            Log.d(TAG, "Stages: " + stats.stageTrace);
+        }
         
         Log.d(TAG, "=== End Performance Statistics ===");
     }
@@ -0,0 +1,139 @@
+package com.example.sr_poc;
+
+import android.content.Context;
+import android.graphics.Typeface;
+import android.os.Build;
+import android.os.PowerManager;
+import android.util.AttributeSet;
+import android.view.View;
+
+import androidx.appcompat.widget.AppCompatTextView;
+
+import com.example.sr_poc.utils.MetricsRegistry;
+import com.example.sr_poc.utils.StageTrace;
+
+import java.util.List;
+import java.util.Locale;
+
+/**
+ * 即時效能覆蓋層：顯示時每 250ms 從 MetricsRegistry 取快照，列出目前工作的各階段時間、
+ * 進行中的 tile、佇列深度、輸出速率、記憶體與溫度狀態。
+ * 隱藏或離開視窗時停止輪詢，處理路徑上只剩原子計數。
+ */
+public class PerformanceOverlayView extends AppCompatTextView {
+
+    private static final long REFRESH_INTERVAL_MS = 250;
+    private static final String[] THERMAL_NAMES = {
+        "none", "light", "moderate", "severe", "critical", "emergency", "shutdown"
+    };
+
+    private final Runnable refresh = this::refresh;
+    private final StringBuilder text = new StringBuilder(256);
+    private PowerManager powerManager;
+    private MetricsRegistry.Snapshot previous;
+    private boolean polling;
+
+    public PerformanceOverlayView(Context context) {
+        super(context);
+        init();
+    }
+
+    public PerformanceOverlayView(Context context, AttributeSet attrs) {
+        super(context, attrs);
+        init();
+    }
+
+    public PerformanceOverlayView(Context context, AttributeSet attrs, int defStyleAttr) {
+        super(context, attrs, defStyleAttr);
+        init();
+    }
+
+    private void init() {
+        powerManager = (PowerManager) getContext().getSystemService(Context.POWER_SERVICE);
+        setTypeface(Typeface.MONOSPACE);
+        setTextSize(10);
+        setTextColor(0xFFFFFFFF);
+        setBackgroundColor(0xA0000000);
+        int padding = (int) (4 * getResources().getDisplayMetrics().density);
+        setPadding(padding, padding, padding, padding);
+    }
+
+    public void toggle() {
+        setVisibility(getVisibility() == View.VISIBLE ? View.GONE : View.VISIBLE);
+    }
+
+    @Override
+    protected void onVisibilityChanged(View changedView, int visibility) {
+        super.onVisibilityChanged(changedView, visibility);
+        updatePolling();
+    }
+
+    @Override
+    protected void onAttachedToWindow() {
+        super.onAttachedToWindow();
+        updatePolling();
+    }
+
+    @Override
+    protected void onDetachedFromWindow() {
+        super.onDetachedFromWindow();
+        updatePolling();
+    }
+
+    private void updatePolling() {
+        boolean shouldPoll = isAttachedToWindow() && isShown();
+        if (shouldPoll == polling) {
+            return;
+        }
+        polling = shouldPoll;
+        if (polling) {
+            previous = null;
+            post(refresh);
+        } else {
+            removeCallbacks(refresh);
+        }
+    }
+
+    private void refresh() {
+        if (!polling) {
+            return;
+        }
+        MetricsRegistry.Snapshot snapshot = MetricsRegistry.get().snapshot();
+        text.setLength(0);
+        text.append(String.format(Locale.US, "jobs %d  tiles %d  queue %s\n", snapshot.jobsInFlight,
+                                  snapshot.tilesInFlight, snapshot.queueDepth >= 0 ? snapshot.queueDepth : "-"));
+        text.append(String.format(Locale.US, "%.2f MP/s  heap %dMB  native %dMB  thermal %s\n",
+                                  previous != null ? snapshot.megapixelsPerSecondSince(previous) : 0.0,
+                                  snapshot.javaHeapKb / 1024, snapshot.nativeHeapKb / 1024, thermalStatus()));
+        appendStages(snapshot);
+        setText(text);
+        previous = snapshot;
+        postDelayed(refresh, REFRESH_INTERVAL_MS);
+    }
+
+    /**
+     * 已完成的階段顯示耗時，進行中的階段顯示到目前為止的時間並加上 *
+     */
+    private void appendStages(MetricsRegistry.Snapshot snapshot) {
+        List<StageTrace.Stage> stages = snapshot.stages;
+        if (stages == null || stages.isEmpty()) {
+            text.append("no job yet");
+            return;
+        }
+        long nowNanos = System.nanoTime();
+        for (StageTrace.Stage stage : stages) {
+            long end = stage.getEndNanos();
+            boolean running = end < 0;
+            long durationMs = ((running ? nowNanos : end) - stage.startNanos) / 1_000_000;
+            text.append(stage.name).append(' ').append(durationMs).append("ms").append(running ? "* " : "  ");
+        }
+    }
+
+    private String thermalStatus() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q || powerManager == null) {
+            return "n/a";
+        }
+        int status = powerManager.getCurrentThermalStatus();
+        return status >= 0 && status < THERMAL_NAMES.length ? THERMAL_NAMES[status] : String.valueOf(status);
+    }
+}
@@ -9,21 +9,30 @@ import android.util.Log;
 
 import org.tensorflow.lite.Interpreter;
 import org.tensorflow.lite.support.common.FileUtil;
-import org.tensorflow.lite.support.tensorbuffer.TensorBuffer;
-import org.tensorflow.lite.DataType;
+import org.tensorflow.lite.Tensor;
 import org.tensorflow.lite.gpu.CompatibilityList;
 import org.tensorflow.lite.gpu.GpuDelegate;
 import org.tensorflow.lite.nnapi.NnApiDelegate;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
-import java.util.concurrent.CountDownLatch;
-import java.util.concurrent.ExecutorService;
-import java.util.concurrent.Executors;
+import java.nio.IntBuffer;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.List;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 
-import com.example.sr_poc.utils.BitmapConverter;
+import com.example.sr_poc.processing.BandWorkers;
+import com.example.sr_poc.processing.DynamicBatcher;
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.PostProcessChain;
+import com.example.sr_poc.processing.TensorPipeline;
 import com.example.sr_poc.utils.Constants;
 import com.example.sr_poc.utils.MemoryUtils;
+import com.example.sr_poc.utils.PerformanceHints;
 
 public class ThreadSafeSRProcessor {
     
@@ -46,14 +55,16 @@ public class ThreadSafeSRProcessor {
     private GpuDelegate gpuDelegate;
     private NnApiDelegate npuDelegate;
     
-    // 共享的buffers
-    private TensorBuffer inputBuffer;
-    private TensorBuffer outputBuffer;
-    
-    // Direct ByteBuffers for INT8 models (TensorBuffer doesn't support INT8)
-    private ByteBuffer inputByteBuffer;
-    private ByteBuffer outputByteBuffer;
+    // 依模型dtype特化的輸入/輸出轉換管線
+    private TensorPipeline pipeline;
+    // 目前生效的後處理鏈（結果快取的指紋依此計算）
+    private volatile PostProcessChain postProcessChain;
     
+    // 跨請求動態批次（僅CPU解釋器會真正合併推理）
+    private DynamicBatcher<PendingRequest> batcher;
+    private TensorPipeline batchPipeline;
+    private int cpuBatchSize = 1;
+
     private boolean isInitialized = false;
     private ProcessingMode currentMode = ProcessingMode.CPU;
     
@@ -66,34 +77,74 @@ public class ThreadSafeSRProcessor {
     private int actualOutputWidth;
     private int actualOutputHeight;
     
-    // 並行處理執行器
-    private ExecutorService conversionExecutor;
+    // 輸出轉換的分段執行緒（呼叫端執行第0段，額外執行緒數少一）
+    private BandWorkers conversionWorkers;
     
-    // 記憶體優化 - 重用的緩存數組
-    private float[] cachedFloatArray;
-    private byte[] cachedByteArray;
-    private int[] cachedPixelArray;
+    // SR 線程與轉換執行緒的優先權及效能提示（每個 tile 回報實際耗時）
+    private final PerformanceHints performanceHints;
     
-    // 深度記憶體池化 - 輸出轉換專用緩存
-    private float[] cachedOutputFloatArray;
-    private byte[] cachedOutputByteArray;
-    private int[] cachedOutputPixelArray;
+    // 低優先權佇列：只在一般請求（含批次視窗中等待的）全部完成後，SR線程才逐一取出執行
+    private final ArrayDeque<PendingRequest> backgroundQueue = new ArrayDeque<>();
+    private final AtomicInteger foregroundPending = new AtomicInteger();
+    private boolean backgroundPosted; // 由 backgroundQueue 保護
+    private volatile BackgroundToken runningBackground;
+    
+    /**
+     * 一組低優先權請求（如預先處理）的控制：取消後尚未執行的請求直接失敗，執行中的請求在下一個階段前中止；
+     * 提升後改走一般佇列
+     */
+    public static final class BackgroundToken {
+        private final AtomicBoolean cancelled;
+        private volatile boolean promoted;
+        
+        public BackgroundToken(AtomicBoolean cancelled) {
+            this.cancelled = cancelled;
+        }
+        
+        public AtomicBoolean getCancellationFlag() {
+            return cancelled;
+        }
+        
+        public boolean isPromoted() {
+            return promoted;
+        }
+    }
     
     public ThreadSafeSRProcessor(Context context) {
         this.context = context;
         this.configManager = ConfigManager.getInstance(context);
+        this.postProcessChain = buildPostProcessChain();
         
-        // Initialize parallel processing executor
+        performanceHints = new PerformanceHints(context, configManager.getPerformanceHintTargetMs() * 1_000_000L,
+                                                configManager.getPerformanceHintThreadPriority(),
+                                                configManager.isPerformanceHintEnabled());
+        
+        // Initialize parallel conversion workers
         int cores = Runtime.getRuntime().availableProcessors();
-        conversionExecutor = Executors.newFixedThreadPool(Math.min(cores, Constants.MAX_CONVERSION_THREADS));
+        conversionWorkers = new BandWorkers("Conversion", Math.min(cores, Constants.MAX_CONVERSION_THREADS) - 1,
+                                            performanceHints::registerCurrentThread);
         
         initializeThread();
+        
+        batcher = new DynamicBatcher<>(new DynamicBatcher.Scheduler() {
+            @Override
+            public void execute(Runnable task) {
+                srHandler.post(task);
+            }
+            
+            @Override
+            public void schedule(Runnable task, long delayMs) {
+                srHandler.postDelayed(task, delayMs);
+            }
+        }, request -> request.mode, this::runBatch);
+        batcher.setPolicy(configManager.getBatchMaxSize(), configManager.getBatchMaxDelayMs());
     }
     
     private void initializeThread() {
         srThread = new HandlerThread("SuperResolutionThread");
         srThread.start();
         srHandler = new Handler(srThread.getLooper());
+        srHandler.post(performanceHints::registerCurrentThread);
     }
     
     public interface InitCallback {
@@ -132,8 +183,7 @@ public class ThreadSafeSRProcessor {
                     currentMode = ProcessingMode.CPU;
                 }
                 
-                allocateBuffers();
-                allocateCachedArrays();
+                createPipeline();
                 
                 isInitialized = true;
                 
@@ -338,29 +388,48 @@ public class ThreadSafeSRProcessor {
         }
     }
     
-    private void allocateBuffers() {
-        ensureBuffersAreCorrectSize();
+    private void createPipeline() {
+        // 所有解釋器共用同一模型，dtype 與形狀相同，只需建立一次
+        Tensor inputTensor = currentInterpreter.getInputTensor(0);
+        Tensor outputTensor = currentInterpreter.getOutputTensor(0);
+        
+        pipeline = TensorPipeline.create(
+            inputTensor.shape(), inputTensor.dataType(),
+            outputTensor.shape(), outputTensor.dataType(),
+            conversionWorkers);
+        pipeline.setPostProcessChain(postProcessChain);
     }
     
-    private void allocateCachedArrays() {
-        try {
-            int inputPixels = actualInputWidth * actualInputHeight;
-            int outputPixels = actualOutputWidth * actualOutputHeight;
-            
-            // Allocate input processing caches
-            cachedPixelArray = new int[inputPixels];
-            cachedFloatArray = new float[inputPixels * 3];
-            cachedByteArray = new byte[inputPixels * 3];
-            
-            // Allocate output processing caches
-            cachedOutputPixelArray = new int[outputPixels];
-            cachedOutputFloatArray = new float[outputPixels * 3];
-            cachedOutputByteArray = new byte[outputPixels * 3];
-            
-        } catch (OutOfMemoryError e) {
-            Log.e(TAG, "Out of memory allocating cached arrays", e);
-            throw new RuntimeException("Insufficient memory for cached arrays", e);
+    private PostProcessChain buildPostProcessChain() {
+        PostProcessChain.Builder builder = new PostProcessChain.Builder()
+            .sharpen(configManager.getPostSharpenAmount())
+            .gamma(configManager.getPostGamma());
+        if (configManager.isPostSrgbEncode()) {
+            builder.srgbEncode();
+        }
+        if (configManager.isPostDither()) {
+            builder.dither();
         }
+        return builder.build();
+    }
+    
+    /**
+     * 替換融合在輸出轉換中的後處理鏈（在SR線程上生效）
+     */
+    public void setPostProcessChain(PostProcessChain chain) {
+        postProcessChain = chain;
+        srHandler.post(() -> {
+            if (pipeline != null) {
+                pipeline.setPostProcessChain(chain);
+            }
+            if (batchPipeline != null) {
+                batchPipeline.setPostProcessChain(chain);
+            }
+        });
+    }
+    
+    public PostProcessChain getPostProcessChain() {
+        return postProcessChain;
     }
     
     private void switchToMode(ProcessingMode mode) {
@@ -388,80 +457,6 @@ public class ThreadSafeSRProcessor {
         }
     }
     
-    private void ensureBuffersAreCorrectSize() {
-        if (currentInterpreter == null) {
-            Log.w(TAG, "No current interpreter available for buffer allocation");
-            return;
-        }
-        
-        // 檢查實際模型形狀
-        int[] inputShape = currentInterpreter.getInputTensor(0).shape();
-        int[] outputShape = currentInterpreter.getOutputTensor(0).shape();
-        DataType inputDataType = currentInterpreter.getInputTensor(0).dataType();
-        DataType outputDataType = currentInterpreter.getOutputTensor(0).dataType();
-        
-        
-        // 計算所需緩衝區大小
-        long inputElements = 1;
-        for (int dim : inputShape) {
-            inputElements *= dim;
-        }
-        long outputElements = 1;
-        for (int dim : outputShape) {
-            outputElements *= dim;
-        }
-        
-        int inputBytesPerElement = (inputDataType == DataType.FLOAT32) ? 4 : 1;
-        int outputBytesPerElement = (outputDataType == DataType.FLOAT32) ? 4 : 1;
-        
-        long requiredInputBytes = inputElements * inputBytesPerElement;
-        long requiredOutputBytes = outputElements * outputBytesPerElement;
-        
-        
-        // 檢查是否需要重新分配輸入緩衝區
-        boolean needNewInputBuffer;
-        if (inputDataType == DataType.INT8) {
-            needNewInputBuffer = inputByteBuffer == null || inputByteBuffer.capacity() != requiredInputBytes;
-        } else {
-            needNewInputBuffer = inputBuffer == null || 
-                               inputBuffer.getBuffer().capacity() != requiredInputBytes ||
-                               inputBuffer.getDataType() != inputDataType;
-        }
-                                   
-        // 檢查是否需要重新分配輸出緩衝區
-        boolean needNewOutputBuffer;
-        if (outputDataType == DataType.INT8) {
-            needNewOutputBuffer = outputByteBuffer == null || outputByteBuffer.capacity() != requiredOutputBytes;
-        } else {
-            needNewOutputBuffer = outputBuffer == null || 
-                                outputBuffer.getBuffer().capacity() != requiredOutputBytes ||
-                                outputBuffer.getDataType() != outputDataType;
-        }
-        
-        if (needNewInputBuffer) {
-            if (inputDataType == DataType.INT8) {
-                inputByteBuffer = ByteBuffer.allocateDirect((int) requiredInputBytes);
-                inputByteBuffer.order(java.nio.ByteOrder.nativeOrder());
-                inputBuffer = null;
-            } else {
-                inputBuffer = TensorBuffer.createFixedSize(inputShape, inputDataType);
-                inputByteBuffer = null;
-            }
-        }
-        
-        if (needNewOutputBuffer) {
-            if (outputDataType == DataType.INT8) {
-                outputByteBuffer = ByteBuffer.allocateDirect((int) requiredOutputBytes);
-                outputByteBuffer.order(java.nio.ByteOrder.nativeOrder());
-                outputBuffer = null;
-            } else {
-                outputBuffer = TensorBuffer.createFixedSize(outputShape, outputDataType);
-                outputByteBuffer = null;
-            }
-        }
-        
-    }
-    
     public interface InferenceCallback {
         void onResult(Bitmap result, long inferenceTime);
         void onError(String error);
@@ -484,280 +479,414 @@ public class ThreadSafeSRProcessor {
     }
     
     public void processImageWithMode(Bitmap inputBitmap, ProcessingMode forceMode, InferenceCallback callback) {
+        processImageWithMode(inputBitmap, forceMode, null, callback);
+    }
+    
+    /**
+     * 推理並只輸出目標網格上的指定視窗（region為null時輸出完整模型倍率結果）
+     */
+    public void processImageWithMode(Bitmap inputBitmap, ProcessingMode forceMode, OutputRegion region,
+                                     InferenceCallback callback) {
         if (!isInitialized) {
             callback.onError("Processor not initialized");
             return;
         }
         
-        srHandler.post(() -> {
-            try {
-
-                if (forceMode != null && forceMode != currentMode) {
-                    switchToMode(forceMode);
-                }
-
-                // 確保輸入尺寸符合模型要求
-                Bitmap resizedInput;
-                if (inputBitmap.getWidth() != actualInputWidth || inputBitmap.getHeight() != actualInputHeight) {
-                    resizedInput = Bitmap.createScaledBitmap(inputBitmap, actualInputWidth, actualInputHeight, true);
-                } else {
-                    resizedInput = inputBitmap;
-                }
-
-                long totalStartTime = System.currentTimeMillis();
-
-                ensureBuffersAreCorrectSize();
-                convertBitmapToBuffer(resizedInput);
-
-                // Rewind the appropriate buffers
-                if (inputBuffer != null) {
-                    inputBuffer.getBuffer().rewind();
-                } else if (inputByteBuffer != null) {
-                    inputByteBuffer.rewind();
-                }
-
-                if (outputBuffer != null) {
-                    outputBuffer.getBuffer().rewind();
-                } else if (outputByteBuffer != null) {
-                    outputByteBuffer.rewind();
-                }
-
-                try {
-                    long inferenceStart = System.currentTimeMillis();
-
-                    // Run inference with appropriate buffers
-                    ByteBuffer inputBuf = (inputBuffer != null) ? inputBuffer.getBuffer() : inputByteBuffer;
-                    ByteBuffer outputBuf = (outputBuffer != null) ? outputBuffer.getBuffer() : outputByteBuffer;
-                    currentInterpreter.run(inputBuf, outputBuf);
-                    long pureInferenceTime = System.currentTimeMillis() - inferenceStart;
-
-                    Log.d(TAG, "Pure inference time: " + pureInferenceTime + "ms");
-                } catch (Exception e) {
-                    Log.e(TAG, "Error during model inference", e);
-                    throw new RuntimeException("Model inference failed: " + e.getMessage(), e);
-                }
-            
-                
-                // 轉換輸出
-                long outputStart = System.currentTimeMillis();
-                Bitmap resultBitmap = convertOutputToBitmap();
-                long outputTime = System.currentTimeMillis() - outputStart;
-
-                long totalTime = System.currentTimeMillis() - totalStartTime;
-
-                // 釋放中間結果
-                if (resizedInput != inputBitmap && !resizedInput.isRecycled()) {
-                    resizedInput.recycle();
-                }
-
-                callback.onResult(resultBitmap, totalTime);
-
-                } catch (Exception e) {
-                    Log.e(TAG, "Error during inference", e);
-                    callback.onError("Inference failed: " + e.getMessage());
-            }
-        });
+        ProcessingMode mode = forceMode != null ? forceMode : currentMode;
+        foregroundPending.incrementAndGet();
+        batcher.submit(new PendingRequest(inputBitmap, mode, region, callback, null));
     }
     
-    private void convertBitmapToBuffer(Bitmap bitmap) {
-        // 使用緩存的像素數組避免重複分配
-        bitmap.getPixels(cachedPixelArray, 0, actualInputWidth, 0, 0, actualInputWidth, actualInputHeight);
-        
-        // Rewind the appropriate buffer
-        if (inputBuffer != null) {
-            inputBuffer.getBuffer().rewind();
-        } else if (inputByteBuffer != null) {
-            inputByteBuffer.rewind();
+    /**
+     * 直接以像素緩衝推理（例如跨程序共享記憶體的映射），不經過 Bitmap：input 為模型輸入大小的 ARGB，
+     * 結果以 region.width 為列寬寫入 output（兩者皆從位置 0 起算），onResult 的 Bitmap 為 null
+     */
+    public void processPixels(IntBuffer input, IntBuffer output, ProcessingMode forceMode, OutputRegion region,
+                              InferenceCallback callback) {
+        if (!isInitialized) {
+            callback.onError("Processor not initialized");
+            return;
+        }
+        if (!checkPixelBuffers(input, output, region, callback)) {
+            return;
         }
         
-        DataType inputDataType = currentInterpreter.getInputTensor(0).dataType();
-        
-        try {
-            if (inputDataType == DataType.FLOAT32) {
-                // 優化的float32輸入處理 - 批量轉換
-                convertPixelsToFloat32Buffer(cachedPixelArray);
-            } else if (inputDataType == DataType.UINT8) {
-                // 優化的uint8輸入處理 - 批量轉換
-                convertPixelsToUint8Buffer(cachedPixelArray);
-            } else if (inputDataType == DataType.INT8) {
-                // 優化的int8輸入處理 - 批量轉換
-                convertPixelsToInt8Buffer(cachedPixelArray);
-            } else {
-                throw new IllegalArgumentException("Unsupported input data type: " + inputDataType);
-            }
-        } catch (Exception e) {
-            Log.e(TAG, "Error converting bitmap to buffer", e);
-            Log.e(TAG, "Buffer capacity: " + inputBuffer.getBuffer().capacity() + 
-                      ", position: " + inputBuffer.getBuffer().position() + 
-                      ", remaining: " + inputBuffer.getBuffer().remaining());
-            throw e;
+        ProcessingMode mode = forceMode != null ? forceMode : currentMode;
+        foregroundPending.incrementAndGet();
+        batcher.submit(new PendingRequest(null, input, output, mode, region, callback, null));
+    }
+    
+    private boolean checkPixelBuffers(IntBuffer input, IntBuffer output, OutputRegion region,
+                                      InferenceCallback callback) {
+        int outputPixels = region != null ? region.width * region.height : actualOutputWidth * actualOutputHeight;
+        if (input.limit() < actualInputWidth * actualInputHeight || output.limit() < outputPixels) {
+            callback.onError("Pixel buffer smaller than model input/output");
+            return false;
         }
+        return true;
     }
     
-    private void convertPixelsToFloat32Buffer(int[] pixels) {
-        int totalFloats = pixels.length * 3;
-        
-        if (cachedFloatArray.length < totalFloats) {
-            cachedFloatArray = new float[totalFloats];
+    /**
+     * 以低優先權推理：排在所有一般請求之後，執行期間 SR 線程與轉換執行緒降為背景優先權，不回報效能提示。
+     * token 已提升時等同一般請求
+     */
+    public void processImageInBackground(Bitmap inputBitmap, ProcessingMode forceMode, OutputRegion region,
+                                         BackgroundToken token, InferenceCallback callback) {
+        if (!isInitialized) {
+            callback.onError("Processor not initialized");
+            return;
         }
         
-        // Use utility class for conversion
-        BitmapConverter.convertPixelsToFloat32(pixels, cachedFloatArray);
-        
-        // Write to buffer
-        inputBuffer.getBuffer().asFloatBuffer().put(cachedFloatArray, 0, totalFloats);
+        ProcessingMode mode = forceMode != null ? forceMode : currentMode;
+        submitBackground(new PendingRequest(inputBitmap, mode, region, callback, token));
     }
     
-    private void convertPixelsToUint8Buffer(int[] pixels) {
-        int totalBytes = pixels.length * 3;
-        
-        if (cachedByteArray.length < totalBytes) {
-            cachedByteArray = new byte[totalBytes];
+    /**
+     * processPixels 的低優先權版本，排程方式同 processImageInBackground
+     */
+    public void processPixelsInBackground(IntBuffer input, IntBuffer output, ProcessingMode forceMode,
+                                          OutputRegion region, BackgroundToken token, InferenceCallback callback) {
+        if (!isInitialized) {
+            callback.onError("Processor not initialized");
+            return;
+        }
+        if (!checkPixelBuffers(input, output, region, callback)) {
+            return;
         }
         
-        // Use utility class for conversion
-        BitmapConverter.convertPixelsToUint8(pixels, cachedByteArray);
-        
-        // Write to buffer
-        inputBuffer.getBuffer().put(cachedByteArray, 0, totalBytes);
+        ProcessingMode mode = forceMode != null ? forceMode : currentMode;
+        submitBackground(new PendingRequest(null, input, output, mode, region, callback, token));
     }
     
-    private void convertPixelsToInt8Buffer(int[] pixels) {
-        int totalBytes = pixels.length * 3;
-        
-        if (cachedByteArray.length < totalBytes) {
-            cachedByteArray = new byte[totalBytes];
+    private void submitBackground(PendingRequest request) {
+        BackgroundToken token = request.background;
+        synchronized (backgroundQueue) {
+            if (!token.promoted) {
+                backgroundQueue.add(request);
+                scheduleBackgroundLocked();
+                return;
+            }
+        }
+        foregroundPending.incrementAndGet();
+        batcher.submit(request);
+    }
+    
+    /**
+     * 把 token 尚在佇列中的請求移到一般佇列，之後的請求也直接走一般佇列；執行中的請求恢復一般優先權
+     */
+    public void promote(BackgroundToken token) {
+        synchronized (backgroundQueue) {
+            token.promoted = true;
+            for (Iterator<PendingRequest> it = backgroundQueue.iterator(); it.hasNext(); ) {
+                PendingRequest request = it.next();
+                if (request.background == token) {
+                    it.remove();
+                    foregroundPending.incrementAndGet();
+                    batcher.submit(request);
+                }
+            }
+        }
+        if (runningBackground == token) {
+            performanceHints.setBackground(false);
         }
-        
-        // Use utility class for conversion
-        BitmapConverter.convertPixelsToInt8(pixels, cachedByteArray);
-        
-        // Write to buffer (use direct ByteBuffer for INT8)
-        inputByteBuffer.put(cachedByteArray, 0, totalBytes);
     }
     
-    private Bitmap convertOutputToBitmap() {
-        int[] outputShape = currentInterpreter.getOutputTensor(0).shape();
-        DataType outputDataType = currentInterpreter.getOutputTensor(0).dataType();
-        
-        // Parse output dimensions
-        int outputHeight, outputWidth;
-        if (outputShape.length >= 4) {
-            outputHeight = outputShape[1];
-            outputWidth = outputShape[2]; 
-        } else if (outputShape.length == 3) {
-            outputHeight = outputShape[0];
-            outputWidth = outputShape[1];
+    /**
+     * 在SR線程上執行一個低優先權請求；仍有一般請求待處理時先讓出，由其完成後重新排程
+     */
+    private void runNextBackground() {
+        PendingRequest request;
+        synchronized (backgroundQueue) {
+            backgroundPosted = false;
+            if (foregroundPending.get() > 0) {
+                return;
+            }
+            request = backgroundQueue.poll();
+        }
+        if (request == null) {
+            return;
+        }
+        if (request.isCancelled()) {
+            request.callback.onError("Cancelled");
         } else {
-            Log.e(TAG, "Unexpected output shape length: " + outputShape.length);
-            return null;
+            runningBackground = request.background;
+            performanceHints.setBackground(!request.background.promoted);
+            try {
+                runSingle(request);
+            } finally {
+                runningBackground = null;
+                performanceHints.setBackground(false);
+            }
         }
-        
-        int totalPixels = outputWidth * outputHeight;
-        
-        if (cachedOutputPixelArray.length < totalPixels) {
-            cachedOutputPixelArray = new int[totalPixels];
+        scheduleBackground();
+    }
+    
+    private void scheduleBackground() {
+        synchronized (backgroundQueue) {
+            scheduleBackgroundLocked();
         }
-        
-        // Rewind the appropriate output buffer
-        if (outputBuffer != null) {
-            outputBuffer.getBuffer().rewind();
-        } else if (outputByteBuffer != null) {
-            outputByteBuffer.rewind();
+    }
+    
+    private void scheduleBackgroundLocked() {
+        if (!backgroundPosted && !backgroundQueue.isEmpty()) {
+            backgroundPosted = true;
+            srHandler.post(this::runNextBackground);
         }
-        
-        
+    }
+    
+    /**
+     * 設定跨請求動態批次視窗（maxBatchSize為1時停用）
+     */
+    public void setBatchingPolicy(int maxBatchSize, long maxDelayMs) {
+        batcher.setPolicy(maxBatchSize, maxDelayMs);
+    }
+    
+    public int getBatchQueueDepth() {
+        return batcher.getQueueDepth();
+    }
+    
+    /**
+     * 在SR線程上執行一個已收集的批次
+     */
+    private void runBatch(List<PendingRequest> batch) {
         try {
-            if (outputDataType == DataType.FLOAT32) {
-                // 優化的float32輸出處理 - 使用緩存數組
-                convertFloat32OutputToPixelsCached(cachedOutputPixelArray, totalPixels);
-            } else if (outputDataType == DataType.UINT8) {
-                // 優化的uint8輸出處理 - 使用緩存數組
-                convertUint8OutputToPixelsCached(cachedOutputPixelArray, totalPixels);
-            } else if (outputDataType == DataType.INT8) {
-                // INT8輸出處理 - 轉換到0-255範圍
-                convertInt8OutputToPixelsCached(cachedOutputPixelArray, totalPixels);
-            } else {
-                Log.e(TAG, "Unsupported output data type: " + outputDataType);
-                return null;
+            runForegroundBatch(batch);
+        } finally {
+            if (foregroundPending.addAndGet(-batch.size()) == 0) {
+                scheduleBackground();
             }
-            
-            
-        } catch (Exception e) {
-            Log.e(TAG, "Error converting output buffer to bitmap", e);
-            return null;
         }
-        
-        // 只複製需要的像素數據到新數組給Bitmap.createBitmap
-        int[] bitmapPixels = new int[totalPixels];
-        System.arraycopy(cachedOutputPixelArray, 0, bitmapPixels, 0, totalPixels);
-        
-        return Bitmap.createBitmap(bitmapPixels, outputWidth, outputHeight, Bitmap.Config.ARGB_8888);
     }
     
-    private void convertFloat32OutputToPixelsCached(int[] pixels, int totalPixels) {
-        int totalFloats = totalPixels * 3;
-        
-        if (cachedOutputFloatArray.length < totalFloats) {
-            cachedOutputFloatArray = new float[totalFloats];
+    private void runForegroundBatch(List<PendingRequest> batch) {
+        ProcessingMode mode = batch.get(0).mode;
+        if (batch.size() > 1 && canRunBatched(mode)) {
+            Bitmap[] results = new Bitmap[batch.size()];
+            long totalTime;
+            try {
+                totalTime = runBatched(batch, results);
+            } catch (Exception e) {
+                Log.w(TAG, "Batched inference failed, falling back to sequential: " + e.getMessage());
+                for (Bitmap result : results) {
+                    if (result != null) {
+                        result.recycle();
+                    }
+                }
+                totalTime = -1;
+            }
+            if (totalTime >= 0) {
+                // 回呼在重試範圍之外：某個回呼拋出例外只影響該請求，不會讓整批重跑
+                for (int i = 0; i < results.length; i++) {
+                    deliverResult(batch.get(i), results[i], totalTime);
+                }
+                return;
+            }
         }
-        
-        // Read all float data to cached array
-        outputBuffer.getBuffer().asFloatBuffer().get(cachedOutputFloatArray, 0, totalFloats);
-        
-        
-        // Use utility class for conversion with parallel processing support
-        if (totalPixels > Constants.LARGE_IMAGE_PIXEL_THRESHOLD) {
-            BitmapConverter.convertFloat32ToPixelsParallel(cachedOutputFloatArray, pixels, conversionExecutor);
-        } else {
-            BitmapConverter.convertFloat32ToPixels(cachedOutputFloatArray, pixels);
+        for (PendingRequest request : batch) {
+            runSingle(request);
         }
     }
     
+    /**
+     * 只有CPU解釋器可動態調整batch維度；GPU/NPU delegate 重新調整形狀代價過高
+     */
+    private boolean canRunBatched(ProcessingMode mode) {
+        return mode == ProcessingMode.CPU && cpuInterpreter != null;
+    }
     
+    private void runSingle(PendingRequest request) {
+        Bitmap resultBitmap;
+        long totalTime;
+        try {
+
+            if (request.mode != currentMode) {
+                switchToMode(request.mode);
+            }
+            ensureCpuBatchSize(1);
+
+            long totalStartTime = System.currentTimeMillis();
+            long tileStartNanos = System.nanoTime();
+
+            writeInput(pipeline, request, 0);
+            checkCancelled(request);
+
+            try {
+                long inferenceStart = System.currentTimeMillis();
+
+                currentInterpreter.run(pipeline.getInputBuffer(), pipeline.getOutputBuffer());
+                long pureInferenceTime = System.currentTimeMillis() - inferenceStart;
+
+                Log.d(TAG, "Pure inference time: " + pureInferenceTime + "ms");
+            } catch (Exception e) {
+                Log.e(TAG, "Error during model inference", e);
+                throw new RuntimeException("Model inference failed: " + e.getMessage(), e);
+            }
+            checkCancelled(request);
+            
+            // 轉換輸出
+            resultBitmap = readOutput(pipeline, request, 0);
+
+            totalTime = System.currentTimeMillis() - totalStartTime;
+            if (request.background == null || request.background.promoted) {
+                performanceHints.reportActualWorkDuration(System.nanoTime() - tileStartNanos);
+            }
+        } catch (CancellationException e) {
+            Log.d(TAG, "Background request cancelled");
+            request.callback.onError("Cancelled");
+            return;
+        } catch (Exception e) {
+            Log.e(TAG, "Error during inference", e);
+            request.callback.onError("Inference failed: " + e.getMessage());
+            return;
+        }
+        deliverResult(request, resultBitmap, totalTime);
+    }
     
-    private void convertUint8OutputToPixelsCached(int[] pixels, int totalPixels) {
-        int totalBytes = totalPixels * 3;
-        
-        if (cachedOutputByteArray.length < totalBytes) {
-            cachedOutputByteArray = new byte[totalBytes];
+    /**
+     * 低優先權請求在各階段之間檢查取消（無法中斷單次推理）
+     */
+    private static void checkCancelled(PendingRequest request) {
+        if (request.isCancelled()) {
+            throw new CancellationException();
         }
-        
-        // Read all byte data to cached array
-        outputBuffer.getBuffer().get(cachedOutputByteArray, 0, totalBytes);
-        
-        // Use utility class for conversion with parallel processing support
-        if (totalPixels > Constants.LARGE_IMAGE_PIXEL_THRESHOLD) {
-            BitmapConverter.convertUint8ToPixelsParallel(cachedOutputByteArray, pixels, conversionExecutor);
-        } else {
-            BitmapConverter.convertUint8ToPixels(cachedOutputByteArray, pixels);
+    }
+    
+    private static void deliverResult(PendingRequest request, Bitmap result, long totalTime) {
+        try {
+            request.callback.onResult(result, totalTime);
+        } catch (RuntimeException e) {
+            Log.e(TAG, "Result callback failed", e);
         }
     }
     
-    private void convertInt8OutputToPixelsCached(int[] pixels, int totalPixels) {
-        int totalBytes = totalPixels * 3;
+    /**
+     * 批次推理並把各請求的輸出寫入 results；回傳批次總時間。失敗時已轉換的輸出留在 results 由呼叫端回收
+     */
+    private long runBatched(List<PendingRequest> batch, Bitmap[] results) {
+        int count = batch.size();
+        if (currentMode != ProcessingMode.CPU) {
+            switchToMode(ProcessingMode.CPU);
+        }
+        ensureBatchPipeline(count);
+        ensureCpuBatchSize(count);
+        
+        long totalStartTime = System.currentTimeMillis();
+        long batchStartNanos = System.nanoTime();
         
-        if (cachedOutputByteArray.length < totalBytes) {
-            cachedOutputByteArray = new byte[totalBytes];
+        for (int i = 0; i < count; i++) {
+            writeInput(batchPipeline, batch.get(i), i);
         }
         
-        // Read all byte data to cached array (use direct ByteBuffer for INT8)
-        outputByteBuffer.get(cachedOutputByteArray, 0, totalBytes);
+        long inferenceStart = System.currentTimeMillis();
+        currentInterpreter.run(batchPipeline.getInputBuffer(count), batchPipeline.getOutputBuffer(count));
+        Log.d(TAG, "Batched inference (" + count + "): " + (System.currentTimeMillis() - inferenceStart) + "ms");
         
-        // Use utility class for conversion with parallel processing support
-        if (totalPixels > Constants.LARGE_IMAGE_PIXEL_THRESHOLD) {
-            BitmapConverter.convertInt8ToPixelsParallel(cachedOutputByteArray, pixels, conversionExecutor);
-        } else {
-            BitmapConverter.convertInt8ToPixels(cachedOutputByteArray, pixels);
+        // 輸出逐一轉換；批次總時間即每個請求的處理時間
+        for (int i = 0; i < count; i++) {
+            results[i] = readOutput(batchPipeline, batch.get(i), i);
         }
+        long totalTime = System.currentTimeMillis() - totalStartTime;
+        // 目標是單一 tile 的時間，批次以平均值回報
+        performanceHints.reportActualWorkDuration((System.nanoTime() - batchStartNanos) / count);
+        return totalTime;
     }
     
+    private void writeInput(TensorPipeline target, PendingRequest request, int index) {
+        if (request.inputPixels != null) {
+            target.writeInput(request.inputPixels, index);
+            return;
+        }
+        Bitmap inputBitmap = request.input;
+        Bitmap resizedInput = resizeToModelInput(inputBitmap);
+        target.writeInput(resizedInput, index);
+        // 釋放中間結果
+        if (resizedInput != inputBitmap && !resizedInput.isRecycled()) {
+            resizedInput.recycle();
+        }
+    }
+    
+    /**
+     * 像素緩衝請求直接寫入呼叫端的 output 並回傳null，其餘配置新的結果 Bitmap
+     */
+    private static Bitmap readOutput(TensorPipeline source, PendingRequest request, int index) {
+        if (request.outputPixels != null) {
+            source.readOutput(request.region, index, request.outputPixels);
+            return null;
+        }
+        return source.readOutput(request.region, index);
+    }
     
+    private Bitmap resizeToModelInput(Bitmap inputBitmap) {
+        // 確保輸入尺寸符合模型要求
+        if (inputBitmap.getWidth() != actualInputWidth || inputBitmap.getHeight() != actualInputHeight) {
+            return Bitmap.createScaledBitmap(inputBitmap, actualInputWidth, actualInputHeight, true);
+        }
+        return inputBitmap;
+    }
     
+    private void ensureBatchPipeline(int count) {
+        int capacity = Math.max(count, batcher.getMaxBatchSize());
+        if (batchPipeline == null || batchPipeline.getBatchCapacity() < count) {
+            Tensor inputTensor = cpuInterpreter.getInputTensor(0);
+            Tensor outputTensor = cpuInterpreter.getOutputTensor(0);
+            batchPipeline = TensorPipeline.create(
+                inputTensor.shape(), inputTensor.dataType(),
+                outputTensor.shape(), outputTensor.dataType(),
+                conversionWorkers, capacity);
+            batchPipeline.setPostProcessChain(pipeline.getPostProcessChain());
+        }
+    }
     
+    private void ensureCpuBatchSize(int count) {
+        if (currentInterpreter != cpuInterpreter || cpuBatchSize == count) {
+            return;
+        }
+        cpuInterpreter.resizeInput(0, new int[] {count, actualInputHeight, actualInputWidth, 3});
+        cpuInterpreter.allocateTensors();
+        cpuBatchSize = count;
+    }
     
+    private static final class PendingRequest {
+        final Bitmap input;
+        final IntBuffer inputPixels;  // 不為null時取代 input
+        final IntBuffer outputPixels; // 不為null時結果寫入此緩衝
+        final ProcessingMode mode;
+        final OutputRegion region;
+        final InferenceCallback callback;
+        final BackgroundToken background; // null 為一般請求
+        
+        PendingRequest(Bitmap input, ProcessingMode mode, OutputRegion region, InferenceCallback callback,
+                       BackgroundToken background) {
+            this(input, null, null, mode, region, callback, background);
+        }
+        
+        PendingRequest(Bitmap input, IntBuffer inputPixels, IntBuffer outputPixels, ProcessingMode mode,
+                       OutputRegion region, InferenceCallback callback, BackgroundToken background) {
+            this.input = input;
+            this.inputPixels = inputPixels;
+            this.outputPixels = outputPixels;
+            this.mode = mode;
+            this.region = region;
+            this.callback = callback;
+            this.background = background;
+        }
+        
+        boolean isCancelled() {
+            return background != null && background.cancelled.get();
+        }
+    }
     
     public void close() {
+        // 尚未執行的低優先權請求不會再被取出，先通知等待中的呼叫端
+        List<PendingRequest> abandoned;
+        synchronized (backgroundQueue) {
+            abandoned = new ArrayList<>(backgroundQueue);
+            backgroundQueue.clear();
+        }
+        for (PendingRequest request : abandoned) {
+            request.callback.onError("Processor closed");
+        }
+        
         if (srHandler != null) {
             srHandler.post(() -> {
                 if (gpuInterpreter != null) {
@@ -781,22 +910,16 @@ public class ThreadSafeSRProcessor {
                     npuDelegate = null;
                 }
                 currentInterpreter = null;
+                pipeline = null;
+                batchPipeline = null;
             });
         }
         
-        // Shutdown conversion executor
-        if (conversionExecutor != null) {
-            conversionExecutor.shutdown();
-            try {
-                if (!conversionExecutor.awaitTermination(Constants.EXECUTOR_SHUTDOWN_TIMEOUT_SECONDS, 
-                                                         java.util.concurrent.TimeUnit.SECONDS)) {
-                    conversionExecutor.shutdownNow();
-                }
-            } catch (InterruptedException e) {
-                conversionExecutor.shutdownNow();
-                Thread.currentThread().interrupt();
-            }
+        // Shutdown conversion workers (idle ones exit immediately, a running band finishes first)
+        if (conversionWorkers != null) {
+            conversionWorkers.close();
         }
+        performanceHints.close();
         
         if (srThread != null) {
             srThread.quitSafely();
@@ -808,6 +931,13 @@ public class ThreadSafeSRProcessor {
         }
     }
     
+    /**
+     * 開關執行緒優先權與效能提示（基準測試比較前後差異用）
+     */
+    public void setPerformanceHintsEnabled(boolean enabled) {
+        performanceHints.setEnabled(enabled);
+    }
+    
     public boolean isUsingGpu() {
         return currentMode == ProcessingMode.GPU;
     }
@@ -832,6 +962,24 @@ public class ThreadSafeSRProcessor {
         }
     }
     
+    /**
+     * 當前dtype管線與其常駐記憶體（輸入/輸出緩衝區）
+     */
+    public String getPipelineInfo() {
+        TensorPipeline current = pipeline;
+        if (current == null) {
+            return "Pipeline not initialized";
+        }
+        String info = String.format("%s (%.1fMB resident)", current.describe(),
+                                    current.getResidentBytes() / (1024.0 * 1024.0));
+        TensorPipeline batched = batchPipeline;
+        if (batched != null) {
+            info += String.format(", batch x%d (%.1fMB resident)", batched.getBatchCapacity(),
+                                  batched.getResidentBytes() / (1024.0 * 1024.0));
+        }
+        return info;
+    }
+    
     public int getModelInputWidth() {
         return actualInputWidth;
     }
@@ -3,6 +3,25 @@ package com.example.sr_poc;
 import android.graphics.Bitmap;
 import android.util.Log;
 
+import com.example.sr_poc.processing.BitmapTileSource;
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.TilePlan;
+import com.example.sr_poc.processing.TileSource;
+import com.example.sr_poc.processing.TileTimings;
+import com.example.sr_poc.processing.TileWorkerPool;
+import com.example.sr_poc.utils.MetricsRegistry;
+
+import java.io.IOException;
+import java.nio.IntBuffer;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.IntSupplier;
+
 public class TileProcessor {
     
     private static final String TAG = "TileProcessor";
@@ -12,9 +31,24 @@ public class TileProcessor {
     private int tileSize; // 動態設定的tile尺寸
     private int outputScale; // 動態計算的輸出倍率
     private int overlapPixels; // 來自配置的overlap像素數
+    private int targetWidth; // 目標輸出寬度，0表示模型倍率
+    private int targetHeight;
+    private ThreadSafeSRProcessor.ProcessingMode processingMode; // null表示使用當前模式
+    private AtomicBoolean cancelled; // 設定後於每個tile之間檢查，取消時回傳null
+    private RowListener rowListener;
+    private TileWorkerPool workerPool; // 設定後tile推理在獨立的worker程序執行
+    private ThreadSafeSRProcessor.BackgroundToken background; // 設定後tile推理走低優先權佇列
+    private TileTimings tileTimings;   // 最近一次分塊處理的逐tile耗時
+    private String inProcessBackend;
+    private String workerBackend;
+    private final Inference inference;
+    private IntBuffer tileOutput;      // 本程序推理的tile結果，跨次處理重用
+    private volatile IntSupplier prefetchProbe;
+    private final AtomicLong prefetchProbeTotal = new AtomicLong();
     
     public TileProcessor(ThreadSafeSRProcessor processor) {
         this.srProcessor = processor;
+        this.inference = new ProcessorInference();
         
         // 使用預設overlap值（向後兼容）
         this.overlapPixels = 32;
@@ -36,6 +70,7 @@ public class TileProcessor {
     public TileProcessor(ThreadSafeSRProcessor processor, ConfigManager configManager) {
         this.srProcessor = processor;
         this.configManager = configManager;
+        this.inference = new ProcessorInference();
         
         // 從配置獲取overlap像素數
         this.overlapPixels = configManager.getOverlapPixels();
@@ -54,6 +89,53 @@ public class TileProcessor {
         
     }
     
+    /**
+     * 測試用：不經 ThreadSafeSRProcessor，以指定的實作推理每塊（需同時以 setProcessingMode 指定模式）
+     */
+    TileProcessor(int tileSize, int outputScale, int overlapPixels, Inference inference) {
+        this.tileSize = tileSize;
+        this.outputScale = outputScale;
+        this.overlapPixels = overlapPixels;
+        this.inference = inference;
+    }
+    
+    /**
+     * 指定最終輸出尺寸（0表示使用模型倍率）；各tile輸出會在轉換時直接重取樣到目標網格
+     */
+    public void setTargetSize(int width, int height) {
+        this.targetWidth = width;
+        this.targetHeight = height;
+    }
+    
+    public void setProcessingMode(ThreadSafeSRProcessor.ProcessingMode mode) {
+        this.processingMode = mode;
+    }
+    
+    public void setCancellationFlag(AtomicBoolean cancelled) {
+        this.cancelled = cancelled;
+    }
+    
+    /**
+     * 每完成一排tile即通知輸出圖上已定案的列範圍，可用於串流編碼
+     */
+    public void setRowListener(RowListener rowListener) {
+        this.rowListener = rowListener;
+    }
+    
+    /**
+     * 把tile推理交給worker程序（各自有獨立heap與interpreter）；null表示在本程序推理
+     */
+    public void setWorkerPool(TileWorkerPool workerPool) {
+        this.workerPool = workerPool;
+    }
+    
+    /**
+     * 以低優先權推理每個tile（預先處理用），見 ThreadSafeSRProcessor.processPixelsInBackground
+     */
+    public void setBackgroundToken(ThreadSafeSRProcessor.BackgroundToken background) {
+        this.background = background;
+    }
+    
     /**
      * 將大圖片分塊處理以避免記憶體溢出
      */
@@ -62,206 +144,520 @@ public class TileProcessor {
             Log.e(TAG, "Input bitmap is null");
             return null;
         }
+        return processByTiles(new BitmapTileSource(inputBitmap), callback);
+    }
+    
+    /**
+     * 從任意輸入來源按需讀取分塊處理，回傳完整輸出圖；取消或任何tile失敗時回傳null
+     */
+    public Bitmap processByTiles(TileSource source, ProcessCallback callback) {
+        return runTiles(source, false, callback);
+    }
+    
+    /**
+     * 串流處理：不配置完整輸出圖，只保留一排tile高的輸出帶，每排完成即交給RowListener。
+     * 記憶體用量與輸入/輸出高度無關，適用無法整張解碼的超大輸入。
+     * 回傳false時已交出的列不完整，呼叫端須捨棄。
+     */
+    public boolean processToRows(TileSource source, ProcessCallback callback) {
+        if (rowListener == null) {
+            throw new IllegalStateException("processToRows requires a RowListener");
+        }
+        Bitmap band = runTiles(source, true, callback);
+        if (band == null) {
+            return false;
+        }
+        band.recycle();
+        return true;
+    }
+    
+    /**
+     * 最近一次分塊處理的逐tile耗時與決策；尚未處理時為null
+     */
+    public TileTimings getTileTimings() {
+        return tileTimings;
+    }
+    
+    /**
+     * 測試用：設定預讀線程每次讀取前後呼叫的計數器（null停用），並歸零累計值
+     */
+    void setPrefetchProbe(IntSupplier probe) {
+        prefetchProbe = probe;
+        prefetchProbeTotal.set(0);
+    }
+    
+    /**
+     * 預讀線程上 probe 差值的累計
+     */
+    long getPrefetchProbeTotal() {
+        return prefetchProbeTotal.get();
+    }
+    
+    private Bitmap runTiles(TileSource source, boolean streaming, ProcessCallback callback) {
+        TilePlan plan = new TilePlan(source.getWidth(), source.getHeight(),
+                                     tileSize, overlapPixels, outputScale);
+        
+        int outputWidth = targetWidth > 0 ? targetWidth : plan.getOutputWidth();
+        int outputHeight = targetHeight > 0 ? targetHeight : plan.getOutputHeight();
+        Log.d(TAG, plan + " -> " + outputWidth + "x" + outputHeight + (streaming ? " (streaming)" : "")
+                   + (workerPool != null ? " on " + workerPool.getWorkerCount() + " workers" : ""));
+        
+        // 各tile在目標網格上負責的視窗在迴圈外算好；需要推理的tile（縮小時部分tile沒有像素）
+        OutputRegion[] regions = new OutputRegion[plan.getTileCount()];
+        List<TilePlan.Tile> work = new ArrayList<>();
+        int bandHeight = 0;
+        int maxRegionPixels = 0;
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, outputWidth, outputHeight);
+            regions[tile.index] = region;
+            if (region.width > 0 && region.height > 0) {
+                work.add(tile);
+                bandHeight = Math.max(bandHeight, region.height);
+                maxRegionPixels = Math.max(maxRegionPixels, region.width * region.height);
+            }
+        }
+        if (tileOutput == null || tileOutput.capacity() < maxRegionPixels) {
+            tileOutput = IntBuffer.wrap(new int[maxRegionPixels]);
+        }
         
-        int inputWidth = inputBitmap.getWidth();
-        int inputHeight = inputBitmap.getHeight();
-        
-        
-        // 計算有效的tile步長 (去除overlap)
-        int effectiveTileStep = tileSize - overlapPixels;
-        
-        // 計算分塊數量
-        int tilesX = (int) Math.ceil((double) inputWidth / effectiveTileStep);
-        int tilesY = (int) Math.ceil((double) inputHeight / effectiveTileStep);
-        
-        
-        // 計算正確的輸出尺寸
-        int effectiveOutputStep = effectiveTileStep * outputScale;
-        int lastTileInputX = Math.min(tileSize, inputWidth - (tilesX - 1) * effectiveTileStep);
-        int lastTileInputY = Math.min(tileSize, inputHeight - (tilesY - 1) * effectiveTileStep);
-        
-        int outputWidth = (tilesX - 1) * effectiveOutputStep + (lastTileInputX * outputScale);
-        int outputHeight = (tilesY - 1) * effectiveOutputStep + (lastTileInputY * outputScale);
-        
-        
-        Bitmap resultBitmap = Bitmap.createBitmap(outputWidth, outputHeight, Bitmap.Config.ARGB_8888);
-        android.graphics.Canvas canvas = new android.graphics.Canvas(resultBitmap);
-        
-        int processedTiles = 0;
-        int totalTiles = tilesX * tilesY;
-        long totalTileTime = 0;
-        
-        for (int y = 0; y < tilesY; y++) {
-            for (int x = 0; x < tilesX; x++) {
-                long tileStartTime = System.currentTimeMillis();
-                
-                // 計算當前分塊的位置和大小
-                int tileLeft = (x == 0) ? 0 : x * effectiveTileStep;
-                int tileTop = (y == 0) ? 0 : y * effectiveTileStep;
-                int tileRight = Math.min(tileLeft + tileSize, inputWidth);
-                int tileBottom = Math.min(tileTop + tileSize, inputHeight);
-                
-                int tileWidth = tileRight - tileLeft;
-                int tileHeight = tileBottom - tileTop;
-                
+        Bitmap resultBitmap = Bitmap.createBitmap(outputWidth, streaming ? Math.max(1, bandHeight) : outputHeight,
+                                                  Bitmap.Config.ARGB_8888);
+        Assembly assembly = new Assembly(plan, resultBitmap, outputHeight, streaming, callback);
+        tileTimings = new TileTimings(outputWidth, outputHeight, plan.getTileCount());
+        inProcessBackend = (processingMode != null ? processingMode : srProcessor.getCurrentMode()).name();
+        workerBackend = "worker/" + inProcessBackend;
+        
+        // worker程序各自推理，同時送出的tile數等於worker數；結果仍依plan順序合成
+        int window = workerPool != null ? workerPool.getWorkerCount() : 1;
+        ArrayDeque<PendingTile> inFlight = new ArrayDeque<>();
+        ArrayDeque<PendingTile> freeTiles = new ArrayDeque<>();
+        int nextWork = 0;
+        
+        TilePrefetcher prefetcher = new TilePrefetcher(source);
+        try {
+            if (!work.isEmpty()) {
+                prefetcher.request(work.get(nextWork++));
+            }
+            
+            for (TilePlan.Tile tile : plan.getTiles()) {
+                if (cancelled != null && cancelled.get()) {
+                    Log.d(TAG, "Tile processing cancelled after " + assembly.processedTiles + "/"
+                               + plan.getTileCount() + " tiles");
+                    abandon(inFlight);
+                    resultBitmap.recycle();
+                    return null;
+                }
                 
-                // 提取分塊，確保符合模型輸入尺寸
-                Bitmap tileBitmap;
-                if (tileWidth == tileSize && tileHeight == tileSize) {
-                    tileBitmap = Bitmap.createBitmap(inputBitmap, tileLeft, tileTop, tileWidth, tileHeight);
-                } else {
-                    // 對於邊界tile，需要padding到模型輸入尺寸
-                    tileBitmap = Bitmap.createBitmap(tileSize, tileSize, Bitmap.Config.ARGB_8888);
-                    android.graphics.Canvas tileCanvas = new android.graphics.Canvas(tileBitmap);
-                    
-                    Bitmap sourceTile = Bitmap.createBitmap(inputBitmap, tileLeft, tileTop, tileWidth, tileHeight);
-                    tileCanvas.drawBitmap(sourceTile, 0, 0, null);
-                    
-                    // 如果需要padding，複製邊緣像素
-                    if (tileWidth < tileSize || tileHeight < tileSize) {
-                        android.graphics.Paint paint = new android.graphics.Paint();
-                        paint.setFilterBitmap(false);
-                        
-                        if (tileWidth < tileSize) {
-                            android.graphics.Rect srcRight = new android.graphics.Rect(tileWidth-1, 0, tileWidth, tileHeight);
-                            android.graphics.Rect dstRight = new android.graphics.Rect(tileWidth, 0, tileSize, tileHeight);
-                            tileCanvas.drawBitmap(sourceTile, srcRight, dstRight, paint);
-                        }
-                        
-                        if (tileHeight < tileSize) {
-                            android.graphics.Rect srcBottom = new android.graphics.Rect(0, tileHeight-1, tileSize, tileHeight);
-                            android.graphics.Rect dstBottom = new android.graphics.Rect(0, tileHeight, tileSize, tileSize);
-                            tileCanvas.drawBitmap(tileBitmap, srcBottom, dstBottom, paint);
-                        }
+                PendingTile pending = freeTiles.poll();
+                if (pending == null) {
+                    pending = new PendingTile();
+                }
+                pending.reset(tile, regions[tile.index]);
+                if (pending.infer) {
+                    pending.pixels = prefetcher.take();
+                    // 推理進行時在背景讀取下一塊
+                    if (nextWork < work.size()) {
+                        prefetcher.request(work.get(nextWork++));
                     }
-                    
-                    sourceTile.recycle();
+                    submitTile(pending);
                 }
+                inFlight.add(pending);
                 
-                // 處理分塊
-                final Object lock = new Object();
-                final Bitmap[] result = new Bitmap[1];
-                final boolean[] completed = new boolean[1];
-                
-                srProcessor.processImage(tileBitmap, new ThreadSafeSRProcessor.InferenceCallback() {
-                    @Override
-                    public void onResult(Bitmap resultBitmap, long inferenceTime) {
-                        synchronized (lock) {
-                            result[0] = resultBitmap;
-                            completed[0] = true;
-                            lock.notify();
-                        }
+                while (inFlight.size() >= window) {
+                    completeTile(prefetcher, inFlight.poll(), assembly, freeTiles);
+                }
+            }
+            while (!inFlight.isEmpty()) {
+                completeTile(prefetcher, inFlight.poll(), assembly, freeTiles);
+            }
+        } catch (IOException e) {
+            Log.e(TAG, "Failed to read tile input", e);
+            abandon(inFlight);
+            resultBitmap.recycle();
+            return null;
+        } finally {
+            prefetcher.close();
+        }
+        
+        // 失敗的tile在輸出留下空白，不能當成完整結果交出（呼叫端可能把它存進store）
+        if (assembly.failedTiles > 0) {
+            Log.e(TAG, assembly.failedTiles + "/" + plan.getTileCount() + " tiles failed, discarding output");
+            resultBitmap.recycle();
+            return null;
+        }
+        return resultBitmap;
+    }
+    
+    /**
+     * 取消尚未合成的tile，並從進行中的計數移除
+     */
+    private static void abandon(ArrayDeque<PendingTile> inFlight) {
+        for (PendingTile pending : inFlight) {
+            if (pending.infer) {
+                if (pending.remote != null) {
+                    pending.remote.cancel(true);
+                }
+                MetricsRegistry.get().tileFinished(0);
+            }
+        }
+    }
+    
+    /**
+     * 送到worker程序，或在本程序同步推理到 tileOutput（本程序時窗口為1，合成前不會被下一塊覆寫）
+     */
+    private void submitTile(PendingTile pending) {
+        MetricsRegistry.get().tileStarted();
+        if (workerPool != null) {
+            pending.remote = workerPool.submit(pending.pixels.array(), tileSize, pending.region, processingMode);
+            return;
+        }
+        long start = System.nanoTime();
+        pending.succeeded = inference.run(pending.pixels, tileOutput, pending.region);
+        pending.latencyNanos = System.nanoTime() - start;
+    }
+    
+    /**
+     * 等待tile結果並合成；worker失敗（含worker程序崩潰）時改在本程序重新推理該tile
+     */
+    private void completeTile(TilePrefetcher prefetcher, PendingTile pending, Assembly assembly,
+                              ArrayDeque<PendingTile> freeTiles) {
+        Bitmap remoteTile = null;
+        TileTimings.Decision decision = TileTimings.Decision.SKIPPED;
+        String backend = inProcessBackend;
+        if (pending.infer) {
+            decision = TileTimings.Decision.INFERRED;
+            if (pending.remote != null) {
+                decision = TileTimings.Decision.ROUTED;
+                try {
+                    TileWorkerPool.Result result = pending.remote.get();
+                    remoteTile = result.bitmap;
+                    pending.succeeded = remoteTile != null;
+                    // 以worker回報的處理耗時計，不含等待空閒worker與排在前面tile之後的時間
+                    pending.latencyNanos = result.workerNanos;
+                    backend = workerBackend;
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                } catch (ExecutionException e) {
+                    Log.w(TAG, "Worker failed on tile " + pending.tile.column + "," + pending.tile.row
+                               + ", running in-process: " + e.getCause());
+                    long retryStart = System.nanoTime();
+                    pending.succeeded = inference.run(pending.pixels, tileOutput, pending.region);
+                    pending.latencyNanos = System.nanoTime() - retryStart;
+                    decision = TileTimings.Decision.RETRIED;
+                }
+            }
+            prefetcher.release(pending.pixels);
+            MetricsRegistry.get().tileFinished(pending.succeeded
+                ? (long) pending.region.width * pending.region.height : 0);
+            if (!pending.succeeded) {
+                decision = TileTimings.Decision.FAILED;
+            }
+        }
+        tileTimings.add(pending.tile.column, pending.tile.row, pending.region, pending.latencyNanos, backend, decision);
+        assembly.place(pending, remoteTile);
+        pending.reset(null, null);
+        freeTiles.add(pending);
+    }
+    
+    /**
+     * 進行中的tile；合成後放回池中重用
+     */
+    private static final class PendingTile {
+        TilePlan.Tile tile;
+        OutputRegion region;
+        boolean infer;          // 在目標網格上有像素，需要推理
+        IntBuffer pixels;
+        Future<TileWorkerPool.Result> remote; // worker程序的結果；本程序推理時為null
+        boolean succeeded;      // 結果可用（本程序推理時已寫入 tileOutput）
+        long latencyNanos;
+        
+        void reset(TilePlan.Tile tile, OutputRegion region) {
+            this.tile = tile;
+            this.region = region;
+            this.infer = region != null && region.width > 0 && region.height > 0;
+            this.pixels = null;
+            this.remote = null;
+            this.succeeded = false;
+            this.latencyNanos = 0;
+        }
+    }
+    
+    /**
+     * 依plan順序把tile結果寫入輸出（或輸出帶），每排完成時通知RowListener
+     */
+    private final class Assembly {
+        private final TilePlan plan;
+        private final Bitmap resultBitmap;
+        private android.graphics.Canvas canvas; // 只在合成worker回傳的Bitmap時建立
+        private final int outputHeight;
+        private final boolean streaming;
+        private final ProcessCallback callback;
+        int processedTiles;
+        int failedTiles;
+        private int completedRows;
+        private int bandTop; // 輸出帶第0列對應的輸出列（非串流時恆為0）
+        private boolean bandDirty;
+        
+        Assembly(TilePlan plan, Bitmap resultBitmap, int outputHeight, boolean streaming, ProcessCallback callback) {
+            this.plan = plan;
+            this.resultBitmap = resultBitmap;
+            this.outputHeight = outputHeight;
+            this.streaming = streaming;
+            this.callback = callback;
+        }
+        
+        void place(PendingTile pending, Bitmap remoteTile) {
+            TilePlan.Tile tile = pending.tile;
+            OutputRegion region = pending.region;
+            if (!pending.infer) {
+                processedTiles++;
+            } else if (pending.succeeded) {
+                if (remoteTile != null) {
+                    if (canvas == null) {
+                        canvas = new android.graphics.Canvas(resultBitmap);
                     }
-                    
-                    @Override
-                    public void onError(String error) {
-                        Log.e(TAG, "Tile processing failed: " + error);
-                        synchronized (lock) {
-                            result[0] = null;
-                            completed[0] = true;
-                            lock.notify();
-                        }
+                    canvas.drawBitmap(remoteTile, region.left, region.top - bandTop, null);
+                    remoteTile.recycle();
+                } else {
+                    resultBitmap.setPixels(tileOutput.array(), 0, region.width, region.left, region.top - bandTop,
+                                           region.width, region.height);
+                }
+                processedTiles++;
+            } else {
+                failedTiles++;
+                bandDirty = true;
+            }
+            
+            // 一排tile的最後一塊完成後，該排負責的輸出列已全部寫入
+            if (tile.column == plan.getTilesX() - 1) {
+                int rowBottom = tile.row == plan.getTilesY() - 1 ? outputHeight : region.top + region.height;
+                if (rowBottom > completedRows) {
+                    if (rowListener != null) {
+                        rowListener.onRowsComplete(resultBitmap, completedRows - bandTop, completedRows, rowBottom);
                     }
-                });
-                
-                // 等待處理完成
-                synchronized (lock) {
-                    while (!completed[0]) {
+                    completedRows = rowBottom;
+                }
+                if (streaming) {
+                    bandTop = completedRows;
+                    // 失敗的tile不會覆寫輸出帶，清除以免殘留上一排內容
+                    if (bandDirty) {
+                        resultBitmap.eraseColor(0);
+                        bandDirty = false;
+                    }
+                }
+            }
+            
+            // 更新進度
+            if (callback != null) {
+                callback.onProgress(processedTiles, plan.getTileCount());
+            }
+        }
+    }
+    
+    /**
+     * 在專用線程讀取下一個tile的輸入並補齊到模型輸入大小（邊界tile以邊緣像素padding），
+     * 讀取與進行中tile的推理重疊；一次只有一個請求，緩衝在tile合成後才歸還重用
+     */
+    private final class TilePrefetcher implements Runnable {
+        private final TileSource source;
+        private final Thread thread;
+        private final ArrayDeque<IntBuffer> freeBuffers = new ArrayDeque<>(); // 只在呼叫端線程使用
+        private final int[] regionPixels = new int[tileSize * tileSize]; // 只在預讀線程使用
+        // 以下由 this 保護
+        private TilePlan.Tile requested;
+        private IntBuffer requestedBuffer;
+        private IntBuffer ready;
+        private Exception failure;
+        private boolean closed;
+        
+        TilePrefetcher(TileSource source) {
+            this.source = source;
+            this.thread = new Thread(this, "TilePrefetch");
+            thread.start();
+        }
+        
+        void request(TilePlan.Tile tile) {
+            IntBuffer polled = freeBuffers.poll();
+            IntBuffer buffer = polled != null ? polled : IntBuffer.wrap(new int[tileSize * tileSize]);
+            synchronized (this) {
+                requested = tile;
+                requestedBuffer = buffer;
+                notifyAll();
+            }
+        }
+        
+        /**
+         * 等待已請求的tile，回傳的像素在release前由呼叫端持有
+         */
+        synchronized IntBuffer take() throws IOException {
+            while (ready == null && failure == null) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    throw new IOException("Interrupted while reading tile", e);
+                }
+            }
+            if (failure != null) {
+                Exception cause = failure;
+                failure = null;
+                throw cause instanceof IOException ? (IOException) cause : new IOException(cause);
+            }
+            IntBuffer result = ready;
+            ready = null;
+            return result;
+        }
+        
+        void release(IntBuffer buffer) {
+            freeBuffers.add(buffer);
+        }
+        
+        @Override
+        public void run() {
+            while (true) {
+                TilePlan.Tile tile;
+                IntBuffer buffer;
+                synchronized (this) {
+                    while (requested == null && !closed) {
                         try {
-                            lock.wait();
+                            wait();
                         } catch (InterruptedException e) {
-                            Log.e(TAG, "Wait interrupted");
-                            break;
+                            return;
                         }
                     }
+                    if (closed) {
+                        return;
+                    }
+                    tile = requested;
+                    buffer = requestedBuffer;
+                    requested = null;
+                    requestedBuffer = null;
                 }
                 
-                Bitmap processedTile = result[0];
-                if (processedTile != null) {
-                    // 計算在輸出畫布上的位置
-                    int outputLeft = x * effectiveOutputStep;
-                    int outputTop = y * effectiveOutputStep;
-                    
-                    // 確定要裁剪的區域以避免overlap
-                    int cropLeft = 0;
-                    int cropTop = 0;
-                    int cropRight = processedTile.getWidth();
-                    int cropBottom = processedTile.getHeight();
-                    
-                    int halfOverlap = (overlapPixels * outputScale) / 2;
-                    
-                    if (x == 0) {
-                        cropLeft = 0;
-                        if (tilesX > 1) {
-                            cropRight = processedTile.getWidth() - halfOverlap;
-                        }
-                    } else if (x == tilesX - 1) {
-                        cropLeft = halfOverlap;
-                        int expectedLastTileOutputWidth = lastTileInputX * outputScale;
-                        cropRight = Math.min(processedTile.getWidth(), expectedLastTileOutputWidth);
-                    } else {
-                        cropLeft = halfOverlap;
-                        cropRight = processedTile.getWidth() - halfOverlap;
-                    }
-                    
-                    if (y == 0) {
-                        cropTop = 0;
-                        if (tilesY > 1) {
-                            cropBottom = processedTile.getHeight() - halfOverlap;
-                        }
-                    } else if (y == tilesY - 1) {
-                        cropTop = halfOverlap;
-                        int expectedLastTileOutputHeight = lastTileInputY * outputScale;
-                        cropBottom = Math.min(processedTile.getHeight(), expectedLastTileOutputHeight);
+                IntSupplier probe = prefetchProbe;
+                int before = probe != null ? probe.getAsInt() : 0;
+                Exception error = null;
+                try {
+                    readPadded(tile, buffer.array());
+                } catch (Exception e) {
+                    error = e;
+                }
+                if (probe != null) {
+                    prefetchProbeTotal.addAndGet(probe.getAsInt() - before);
+                }
+                
+                synchronized (this) {
+                    if (error != null) {
+                        failure = error;
                     } else {
-                        cropTop = halfOverlap;
-                        cropBottom = processedTile.getHeight() - halfOverlap;
-                    }
-                    
-                    int actualCropWidth = cropRight - cropLeft;
-                    int actualCropHeight = cropBottom - cropTop;
-                    
-                    int availableWidth = outputWidth - outputLeft;
-                    int availableHeight = outputHeight - outputTop;
-                    
-                    actualCropWidth = Math.min(actualCropWidth, availableWidth);
-                    actualCropHeight = Math.min(actualCropHeight, availableHeight);
-                    
-                    if (actualCropWidth > 0 && actualCropHeight > 0) {
-                        if (cropLeft + actualCropWidth <= processedTile.getWidth() && 
-                            cropTop + actualCropHeight <= processedTile.getHeight()) {
-                            
-                            Bitmap croppedTile = Bitmap.createBitmap(processedTile, 
-                                cropLeft, cropTop, actualCropWidth, actualCropHeight);
-                            canvas.drawBitmap(croppedTile, outputLeft, outputTop, null);
-                            croppedTile.recycle();
-                        }
+                        ready = buffer;
                     }
-                    
-                    processedTile.recycle();
-                    processedTiles++;
+                    notifyAll();
                 }
-                
-                tileBitmap.recycle();
-                
-                long tileTime = System.currentTimeMillis() - tileStartTime;
-                totalTileTime += tileTime;
-                
-                // 更新進度
-                if (callback != null) {
-                    callback.onProgress(processedTiles, totalTiles);
+            }
+        }
+        
+        private void readPadded(TilePlan.Tile tile, int[] buffer) throws IOException {
+            int width = tile.inputWidth;
+            int height = tile.inputHeight;
+            source.readRegion(tile.inputLeft, tile.inputTop, width, height, regionPixels);
+            
+            if (width == tileSize && height == tileSize) {
+                System.arraycopy(regionPixels, 0, buffer, 0, tileSize * tileSize);
+                return;
+            }
+            for (int y = 0; y < tileSize; y++) {
+                int sourceRow = Math.min(y, height - 1) * width;
+                int row = y * tileSize;
+                System.arraycopy(regionPixels, sourceRow, buffer, row, width);
+                int edge = regionPixels[sourceRow + width - 1];
+                for (int x = width; x < tileSize; x++) {
+                    buffer[row + x] = edge;
                 }
             }
         }
         
+        /**
+         * 等進行中的讀取結束，之後來源可由呼叫端關閉
+         */
+        void close() {
+            synchronized (this) {
+                closed = true;
+                notifyAll();
+            }
+            try {
+                thread.join();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+    
+    /**
+     * 本程序推理一塊：input 為 tileSize×tileSize 的 ARGB，結果以 region.width 為列寬寫入 output；失敗回傳false
+     */
+    interface Inference {
+        boolean run(IntBuffer input, IntBuffer output, OutputRegion region);
+    }
+    
+    /**
+     * 以 ThreadSafeSRProcessor 同步推理；回呼與等待用的鎖重用，每塊不配置物件
+     */
+    private final class ProcessorInference implements Inference, ThreadSafeSRProcessor.InferenceCallback {
+        private boolean completed;
+        private boolean succeeded;
+        
+        @Override
+        public synchronized boolean run(IntBuffer input, IntBuffer output, OutputRegion region) {
+            completed = false;
+            if (background != null) {
+                srProcessor.processPixelsInBackground(input, output, processingMode, region, background, this);
+            } else {
+                srProcessor.processPixels(input, output, processingMode, region, this);
+            }
+            
+            // 等待處理完成
+            while (!completed) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                    Log.e(TAG, "Wait interrupted");
+                    return false;
+                }
+            }
+            return succeeded;
+        }
         
-        return resultBitmap;
+        @Override
+        public synchronized void onResult(Bitmap resultBitmap, long inferenceTime) {
+            succeeded = true;
+            completed = true;
+            notifyAll();
+        }
+        
+        @Override
+        public void onError(String error) {
+            Log.e(TAG, "Tile processing failed: " + error);
+            synchronized (this) {
+                succeeded = false;
+                completed = true;
+                notifyAll();
+            }
+        }
     }
     
     public interface ProcessCallback {
         void onProgress(int completed, int total);
     }
     
+    public interface RowListener {
+        /**
+         * Output rows [top, bottom) are final and will not be written again.
+         * They are stored in pixels starting at row sourceTop (pixels may be a band, not the whole output).
+         */
+        void onRowsComplete(Bitmap pixels, int sourceTop, int top, int bottom);
+    }
+    
     /**
      * 檢查是否需要分塊處理
      */
@@ -0,0 +1,169 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 動態批次的吞吐量/延遲基準：多個閉環客戶端同時送出小圖，
+ * 掃描不同的批次大小與等待視窗，比較每秒處理張數與 p50/p95 延遲。
+ */
+public final class BatchingBenchmark {
+
+    private static final String TAG = "BatchingBenchmark";
+    private static final long REQUEST_TIMEOUT_MS = 60_000;
+
+    public static final class Result {
+        public final int maxBatchSize;
+        public final long maxDelayMs;
+        public final int clients;
+        public final int completed;
+        public final int failed;
+        public final double imagesPerSecond;
+        public final long p50Ms;
+        public final long p95Ms;
+
+        Result(int maxBatchSize, long maxDelayMs, int clients, int completed, int failed,
+               double imagesPerSecond, long p50Ms, long p95Ms) {
+            this.maxBatchSize = maxBatchSize;
+            this.maxDelayMs = maxDelayMs;
+            this.clients = clients;
+            this.completed = completed;
+            this.failed = failed;
+            this.imagesPerSecond = imagesPerSecond;
+            this.p50Ms = p50Ms;
+            this.p95Ms = p95Ms;
+        }
+
+        @Override
+        public String toString() {
+            return String.format("batch=%d delay=%dms clients=%d: %.2f img/s, p50=%dms, p95=%dms (%d ok, %d failed)",
+                                 maxBatchSize, maxDelayMs, clients, imagesPerSecond, p50Ms, p95Ms, completed, failed);
+        }
+    }
+
+    private final ThreadSafeSRProcessor processor;
+    private final Bitmap input;
+    private final ThreadSafeSRProcessor.ProcessingMode mode;
+
+    public BatchingBenchmark(ThreadSafeSRProcessor processor, Bitmap input, ThreadSafeSRProcessor.ProcessingMode mode) {
+        this.processor = processor;
+        this.input = input;
+        this.mode = mode;
+    }
+
+    /**
+     * Runs every (batch size, delay) combination and restores batching to the given policy afterwards
+     */
+    public List<Result> sweep(int[] batchSizes, long[] delaysMs, int clients, int requestsPerClient,
+                              int restoreBatchSize, long restoreDelayMs) throws InterruptedException {
+        List<Result> results = new ArrayList<>();
+        try {
+            // 預熱：避免首次分配與delegate初始化計入結果
+            processor.setBatchingPolicy(1, 0);
+            runClients(clients, 1);
+
+            for (int batchSize : batchSizes) {
+                for (long delay : delaysMs) {
+                    if (batchSize == 1 && delay > 0) {
+                        continue; // 單張批次不會等待視窗
+                    }
+                    Result result = run(batchSize, delay, clients, requestsPerClient);
+                    Log.i(TAG, result.toString());
+                    results.add(result);
+                }
+            }
+        } finally {
+            processor.setBatchingPolicy(restoreBatchSize, restoreDelayMs);
+        }
+        return results;
+    }
+
+    public Result run(int maxBatchSize, long maxDelayMs, int clients, int requestsPerClient) throws InterruptedException {
+        processor.setBatchingPolicy(maxBatchSize, maxDelayMs);
+
+        long start = System.nanoTime();
+        ClientStats stats = runClients(clients, requestsPerClient);
+        long elapsedNs = System.nanoTime() - start;
+
+        long[] latencies = Arrays.copyOf(stats.latenciesMs, stats.count.get());
+        Arrays.sort(latencies);
+        double seconds = elapsedNs / 1e9;
+        return new Result(maxBatchSize, maxDelayMs, clients, latencies.length, stats.failed.get(),
+                          seconds > 0 ? latencies.length / seconds : 0,
+                          percentile(latencies, 0.50), percentile(latencies, 0.95));
+    }
+
+    private static final class ClientStats {
+        final long[] latenciesMs;
+        final AtomicInteger count = new AtomicInteger();
+        final AtomicInteger failed = new AtomicInteger();
+
+        ClientStats(int capacity) {
+            latenciesMs = new long[capacity];
+        }
+    }
+
+    private ClientStats runClients(int clients, int requestsPerClient) throws InterruptedException {
+        ClientStats stats = new ClientStats(clients * requestsPerClient);
+        List<Thread> threads = new ArrayList<>(clients);
+        for (int c = 0; c < clients; c++) {
+            Thread thread = new Thread(() -> {
+                for (int i = 0; i < requestsPerClient; i++) {
+                    if (!submitAndWait(stats)) {
+                        return;
+                    }
+                }
+            }, "BatchingClient-" + c);
+            threads.add(thread);
+            thread.start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        return stats;
+    }
+
+    private boolean submitAndWait(ClientStats stats) {
+        CountDownLatch done = new CountDownLatch(1);
+        long submitted = System.nanoTime();
+        processor.processImageWithMode(input, mode, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap result, long inferenceTime) {
+                long latencyMs = (System.nanoTime() - submitted) / 1_000_000;
+                stats.latenciesMs[stats.count.getAndIncrement()] = latencyMs;
+                result.recycle();
+                done.countDown();
+            }
+
+            @Override
+            public void onError(String error) {
+                Log.w(TAG, "Request failed: " + error);
+                stats.failed.incrementAndGet();
+                done.countDown();
+            }
+        });
+        try {
+            return done.await(REQUEST_TIMEOUT_MS, TimeUnit.MILLISECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return false;
+        }
+    }
+
+    private static long percentile(long[] sorted, double fraction) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(fraction * sorted.length) - 1;
+        return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+    }
+}
@@ -0,0 +1,102 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.processing.ImageEncoder;
+import com.example.sr_poc.processing.ParallelPngEncoder;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.zip.Deflater;
+
+/**
+ * 輸出編碼的擴展性基準：同一張圖以 Bitmap.compress(PNG) 與不同執行緒數的平行 PNG 編碼比較。
+ * 輸出寫到丟棄串流，只量測編碼本身。
+ */
+public final class EncoderBenchmark {
+
+    private static final String TAG = "EncoderBenchmark";
+
+    public static final class Result {
+        public final String name;
+        public final int threads;
+        public final long wallMs;
+        public final long bytes;
+        public final String stageReport;
+
+        Result(String name, int threads, long wallMs, long bytes, String stageReport) {
+            this.name = name;
+            this.threads = threads;
+            this.wallMs = wallMs;
+            this.bytes = bytes;
+            this.stageReport = stageReport;
+        }
+
+        @Override
+        public String toString() {
+            return String.format("%s threads=%d: %d ms, %d KB%s", name, threads, wallMs, bytes / 1024,
+                                 stageReport != null ? " [" + stageReport + "]" : "");
+        }
+    }
+
+    private static final class CountingSink extends OutputStream {
+        long count;
+
+        @Override
+        public void write(int b) {
+            count++;
+        }
+
+        @Override
+        public void write(byte[] b, int off, int len) {
+            count += len;
+        }
+    }
+
+    private EncoderBenchmark() {
+        // Prevent instantiation
+    }
+
+    public static List<Result> run(Bitmap bitmap, int[] threadCounts) throws IOException {
+        List<Result> results = new ArrayList<>();
+
+        CountingSink baselineSink = new CountingSink();
+        long start = System.currentTimeMillis();
+        bitmap.compress(Bitmap.CompressFormat.PNG, 100, baselineSink);
+        Result baseline = new Result("Bitmap.compress", 1, System.currentTimeMillis() - start, baselineSink.count, null);
+        Log.i(TAG, baseline.toString());
+        results.add(baseline);
+
+        int width = bitmap.getWidth();
+        int height = bitmap.getHeight();
+        for (int threads : threadCounts) {
+            ExecutorService executor = Executors.newFixedThreadPool(threads);
+            try {
+                CountingSink sink = new CountingSink();
+                start = System.currentTimeMillis();
+                ParallelPngEncoder encoder = new ParallelPngEncoder(sink, width, height, bitmap.hasAlpha(), executor,
+                                                                    Deflater.DEFAULT_COMPRESSION,
+                                                                    ImageEncoder.DEFAULT_STRIP_ROWS, 2 * threads);
+                for (int y = 0; y < height; y += ImageEncoder.DEFAULT_STRIP_ROWS) {
+                    int rows = Math.min(ImageEncoder.DEFAULT_STRIP_ROWS, height - y);
+                    int[] pixels = new int[width * rows];
+                    bitmap.getPixels(pixels, 0, width, 0, y, width, rows);
+                    encoder.writeRows(pixels, rows);
+                }
+                encoder.finish();
+                Result result = new Result("ParallelPngEncoder", threads, System.currentTimeMillis() - start,
+                                           sink.count, encoder.getReport());
+                Log.i(TAG, result.toString());
+                results.add(result);
+            } finally {
+                executor.shutdown();
+            }
+        }
+        return results;
+    }
+}
@@ -0,0 +1,139 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+import com.example.sr_poc.utils.EnergyMeter;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 各後端的能耗基準：同一張圖在每個模式下連續處理，量測延遲與每百萬輸出像素的焦耳數。
+ * 一次只跑一個請求，量到的整機功率才可歸給該後端；執行前應拔除充電器並關閉螢幕以外的負載。
+ */
+public final class EnergyBenchmark {
+
+    private static final String TAG = "EnergyBenchmark";
+    private static final long REQUEST_TIMEOUT_MS = 60_000;
+
+    public static final class Result {
+        public final String model;
+        public final ThreadSafeSRProcessor.ProcessingMode mode;
+        public final int completed;
+        public final int failed;
+        public final long p50Ms;
+        public final long p95Ms;
+        public final double averageWatts;
+        public final double joulesPerMegapixel; // 負值表示功率來源無法取樣
+
+        Result(String model, ThreadSafeSRProcessor.ProcessingMode mode, int completed, int failed,
+               long p50Ms, long p95Ms, double averageWatts, double joulesPerMegapixel) {
+            this.model = model;
+            this.mode = mode;
+            this.completed = completed;
+            this.failed = failed;
+            this.p50Ms = p50Ms;
+            this.p95Ms = p95Ms;
+            this.averageWatts = averageWatts;
+            this.joulesPerMegapixel = joulesPerMegapixel;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "%s %s: p50=%dms, p95=%dms, %.2f W, %s (%d ok, %d failed)",
+                                 model, mode, p50Ms, p95Ms, averageWatts,
+                                 joulesPerMegapixel >= 0 ? String.format(Locale.US, "%.3f J/MP", joulesPerMegapixel)
+                                                         : "energy n/a",
+                                 completed, failed);
+        }
+    }
+
+    private final ThreadSafeSRProcessor processor;
+    private final EnergyMeter meter;
+    private final String model;
+    private final Bitmap input;
+
+    public EnergyBenchmark(ThreadSafeSRProcessor processor, EnergyMeter meter, String model, Bitmap input) {
+        this.processor = processor;
+        this.meter = meter;
+        this.model = model;
+        this.input = input;
+    }
+
+    public List<Result> run(ThreadSafeSRProcessor.ProcessingMode[] modes, int warmupRuns, int runs)
+            throws InterruptedException {
+        List<Result> results = new ArrayList<>();
+        for (ThreadSafeSRProcessor.ProcessingMode mode : modes) {
+            Result result = run(mode, warmupRuns, runs);
+            Log.i(TAG, result.toString());
+            results.add(result);
+        }
+        return results;
+    }
+
+    public Result run(ThreadSafeSRProcessor.ProcessingMode mode, int warmupRuns, int runs) throws InterruptedException {
+        // 預熱：delegate初始化與首次分配不計入
+        for (int i = 0; i < warmupRuns; i++) {
+            processOnce(mode, null);
+        }
+
+        long[] latencies = new long[runs];
+        long[] outputPixels = new long[1];
+        int completed = 0;
+        int failed = 0;
+        EnergyMeter.Measurement measurement = meter.begin();
+        for (int i = 0; i < runs; i++) {
+            long start = System.nanoTime();
+            if (processOnce(mode, outputPixels)) {
+                latencies[completed++] = (System.nanoTime() - start) / 1_000_000;
+            } else {
+                failed++;
+            }
+        }
+        EnergyMeter.Energy energy = measurement.end();
+
+        long[] sorted = Arrays.copyOf(latencies, completed);
+        Arrays.sort(sorted);
+        return new Result(model, mode, completed, failed, percentile(sorted, 0.50), percentile(sorted, 0.95),
+                          energy.getAverageWatts(),
+                          energy.isValid() ? energy.joulesPerMegapixel(outputPixels[0]) : -1);
+    }
+
+    private boolean processOnce(ThreadSafeSRProcessor.ProcessingMode mode, long[] outputPixels)
+            throws InterruptedException {
+        CountDownLatch done = new CountDownLatch(1);
+        boolean[] ok = new boolean[1];
+        processor.processImageWithMode(input, mode, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap result, long inferenceTime) {
+                if (outputPixels != null) {
+                    outputPixels[0] += (long) result.getWidth() * result.getHeight();
+                }
+                result.recycle();
+                ok[0] = true;
+                done.countDown();
+            }
+
+            @Override
+            public void onError(String error) {
+                Log.w(TAG, mode + " request failed: " + error);
+                done.countDown();
+            }
+        });
+        return done.await(REQUEST_TIMEOUT_MS, TimeUnit.MILLISECONDS) && ok[0];
+    }
+
+    private static long percentile(long[] sorted, double fraction) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(fraction * sorted.length) - 1;
+        return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+    }
+}
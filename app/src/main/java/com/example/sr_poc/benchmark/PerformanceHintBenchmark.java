@@ -0,0 +1,144 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 效能提示前後的 tile 延遲變異：同一個 tile 之間插入閒置間隔（模擬分塊處理間的等待，讓 CPU 降頻），
+ * 先在關閉優先權與提示下量測，再開啟後量測，比較標準差、變異係數與 p95。
+ * 兩段之間先冷卻，避免後段因溫度較高而吃虧。
+ */
+public final class PerformanceHintBenchmark {
+
+    private static final String TAG = "PerformanceHintBenchmark";
+    private static final long REQUEST_TIMEOUT_MS = 60_000;
+
+    public static final class Result {
+        public final boolean hintsEnabled;
+        public final int completed;
+        public final int failed;
+        public final double meanMs;
+        public final double stdDevMs;
+        public final double p50Ms;
+        public final double p95Ms;
+
+        Result(boolean hintsEnabled, int completed, int failed, double meanMs, double stdDevMs,
+               double p50Ms, double p95Ms) {
+            this.hintsEnabled = hintsEnabled;
+            this.completed = completed;
+            this.failed = failed;
+            this.meanMs = meanMs;
+            this.stdDevMs = stdDevMs;
+            this.p50Ms = p50Ms;
+            this.p95Ms = p95Ms;
+        }
+
+        /**
+         * 變異係數（標準差 / 平均）
+         */
+        public double getCoefficientOfVariation() {
+            return meanMs > 0 ? stdDevMs / meanMs : 0;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "hints %s: mean=%.1fms, stddev=%.1fms, cv=%.3f, p50=%.1fms, p95=%.1fms (%d ok, %d failed)",
+                                 hintsEnabled ? "on" : "off", meanMs, stdDevMs, getCoefficientOfVariation(),
+                                 p50Ms, p95Ms, completed, failed);
+        }
+    }
+
+    private final ThreadSafeSRProcessor processor;
+    private final ThreadSafeSRProcessor.ProcessingMode mode;
+    private final Bitmap tile;
+
+    public PerformanceHintBenchmark(ThreadSafeSRProcessor processor, ThreadSafeSRProcessor.ProcessingMode mode,
+                                    Bitmap tile) {
+        this.processor = processor;
+        this.mode = mode;
+        this.tile = tile;
+    }
+
+    /**
+     * @return [0] 為關閉提示，[1] 為開啟提示
+     */
+    public Result[] run(int warmupRuns, int runs, long idleGapMs, long cooldownMs) throws InterruptedException {
+        Result before = run(false, warmupRuns, runs, idleGapMs);
+        Log.i(TAG, before.toString());
+        Thread.sleep(cooldownMs);
+        Result after = run(true, warmupRuns, runs, idleGapMs);
+        Log.i(TAG, after.toString());
+        return new Result[] { before, after };
+    }
+
+    public Result run(boolean hintsEnabled, int warmupRuns, int runs, long idleGapMs) throws InterruptedException {
+        processor.setPerformanceHintsEnabled(hintsEnabled);
+        // 預熱：delegate初始化與 session 建立不計入
+        for (int i = 0; i < warmupRuns; i++) {
+            processOnce();
+        }
+
+        long[] latencies = new long[runs];
+        int completed = 0;
+        int failed = 0;
+        for (int i = 0; i < runs; i++) {
+            Thread.sleep(idleGapMs);
+            long start = System.nanoTime();
+            if (processOnce()) {
+                latencies[completed++] = System.nanoTime() - start;
+            } else {
+                failed++;
+            }
+        }
+
+        long[] sorted = Arrays.copyOf(latencies, completed);
+        Arrays.sort(sorted);
+        double sum = 0;
+        for (long latency : sorted) {
+            sum += latency;
+        }
+        double mean = completed > 0 ? sum / completed : 0;
+        double squares = 0;
+        for (long latency : sorted) {
+            squares += (latency - mean) * (latency - mean);
+        }
+        double stdDev = completed > 1 ? Math.sqrt(squares / (completed - 1)) : 0;
+        return new Result(hintsEnabled, completed, failed, mean / 1e6, stdDev / 1e6,
+                          percentile(sorted, 0.50) / 1e6, percentile(sorted, 0.95) / 1e6);
+    }
+
+    private boolean processOnce() throws InterruptedException {
+        CountDownLatch done = new CountDownLatch(1);
+        boolean[] ok = new boolean[1];
+        processor.processImageWithMode(tile, mode, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap result, long inferenceTime) {
+                result.recycle();
+                ok[0] = true;
+                done.countDown();
+            }
+
+            @Override
+            public void onError(String error) {
+                Log.w(TAG, mode + " request failed: " + error);
+                done.countDown();
+            }
+        });
+        return done.await(REQUEST_TIMEOUT_MS, TimeUnit.MILLISECONDS) && ok[0];
+    }
+
+    private static long percentile(long[] sorted, double fraction) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(fraction * sorted.length) - 1;
+        return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+    }
+}
@@ -0,0 +1,257 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.os.Debug;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 長時間浸泡測試：在指定時間內輪流以每張圖、每個後端呼叫 processImageWithMode，
+ * 每個時間窗記錄延遲百分位、GC 後的 Java heap、native heap、PSS 與 GC 次數，
+ * 結束時以最小平方斜率判斷延遲漂移與記憶體成長（洩漏的 Bitmap/direct buffer/delegate 記憶體都在 native 端）。
+ */
+public final class SoakRunner {
+
+    private static final String TAG = "SoakRunner";
+    private static final long REQUEST_TIMEOUT_MS = 60_000;
+    private static final double MS_PER_HOUR = 3_600_000.0;
+
+    public static final class Thresholds {
+        /** p50 延遲每小時相對於基準增加的比例上限 */
+        public double latencyDriftPerHour = 0.10;
+        /** 每小時成長上限（KB） */
+        public double nativeGrowthKbPerHour = 32 * 1024;
+        public double javaGrowthKbPerHour = 16 * 1024;
+        public double pssGrowthKbPerHour = 48 * 1024;
+        /** 總成長低於此值時不判定（短時間測試的雜訊） */
+        public double minGrowthKb = 8 * 1024;
+        /** 前幾個時間窗為暖機，不列入趨勢 */
+        public int warmupWindows = 1;
+    }
+
+    public static final class Window {
+        public final int index;
+        public final long endOffsetMs;
+        public final int runs;
+        public final int failures;
+        public final long p50Ms;
+        public final long p95Ms;
+        public final long javaHeapKb;
+        public final long nativeHeapKb;
+        public final long pssKb;
+        public final long gcCount;
+        public final long blockingGcCount;
+
+        Window(int index, long endOffsetMs, int runs, int failures, long p50Ms, long p95Ms,
+               long javaHeapKb, long nativeHeapKb, long pssKb, long gcCount, long blockingGcCount) {
+            this.index = index;
+            this.endOffsetMs = endOffsetMs;
+            this.runs = runs;
+            this.failures = failures;
+            this.p50Ms = p50Ms;
+            this.p95Ms = p95Ms;
+            this.javaHeapKb = javaHeapKb;
+            this.nativeHeapKb = nativeHeapKb;
+            this.pssKb = pssKb;
+            this.gcCount = gcCount;
+            this.blockingGcCount = blockingGcCount;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US,
+                "window %d @%ds: %d runs (%d failed), p50 %dms p95 %dms, Java %dMB, native %dMB, PSS %dMB, GC %d (%d blocking)",
+                index, endOffsetMs / 1000, runs, failures, p50Ms, p95Ms, javaHeapKb / 1024, nativeHeapKb / 1024,
+                pssKb / 1024, gcCount, blockingGcCount);
+        }
+    }
+
+    public static final class Report {
+        public final List<Window> windows;
+        public final List<String> regressions;
+        public final long totalRuns;
+        public final long totalFailures;
+
+        Report(List<Window> windows, List<String> regressions) {
+            this.windows = windows;
+            this.regressions = regressions;
+            long runs = 0;
+            long failures = 0;
+            for (Window window : windows) {
+                runs += window.runs;
+                failures += window.failures;
+            }
+            this.totalRuns = runs;
+            this.totalFailures = failures;
+        }
+
+        public boolean hasRegression() {
+            return !regressions.isEmpty();
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "%d windows, %d runs (%d failed), regressions: %s",
+                                 windows.size(), totalRuns, totalFailures,
+                                 regressions.isEmpty() ? "none" : String.join("; ", regressions));
+        }
+    }
+
+    private final ThreadSafeSRProcessor processor;
+    private final List<Bitmap> images;
+    private final ThreadSafeSRProcessor.ProcessingMode[] modes;
+
+    public SoakRunner(ThreadSafeSRProcessor processor, List<Bitmap> images,
+                      ThreadSafeSRProcessor.ProcessingMode[] modes) {
+        this.processor = processor;
+        this.images = images;
+        this.modes = modes;
+    }
+
+    public Report run(long durationMs, long windowMs, Thresholds thresholds) throws InterruptedException {
+        List<Window> windows = new ArrayList<>();
+        long start = System.currentTimeMillis();
+        long end = start + durationMs;
+        long lastGc = gcCount("art.gc.gc-count");
+        long lastBlockingGc = gcCount("art.gc.blocking-gc-count");
+        int request = 0;
+
+        while (System.currentTimeMillis() < end) {
+            long windowEnd = Math.min(end, System.currentTimeMillis() + windowMs);
+            long[] latencies = new long[64];
+            int runs = 0;
+            int failures = 0;
+            while (System.currentTimeMillis() < windowEnd) {
+                Bitmap image = images.get(request % images.size());
+                ThreadSafeSRProcessor.ProcessingMode mode = modes[(request / images.size()) % modes.length];
+                request++;
+                long begin = System.nanoTime();
+                if (processOnce(image, mode)) {
+                    if (runs == latencies.length) {
+                        latencies = Arrays.copyOf(latencies, runs * 2);
+                    }
+                    latencies[runs++] = (System.nanoTime() - begin) / 1_000_000;
+                } else {
+                    failures++;
+                }
+            }
+
+            // 強制GC後再讀 Java heap，只看仍被持有的物件
+            Runtime.getRuntime().gc();
+            Runtime.getRuntime().runFinalization();
+            Runtime runtime = Runtime.getRuntime();
+            long javaHeap = (runtime.totalMemory() - runtime.freeMemory()) / 1024;
+            long gc = gcCount("art.gc.gc-count");
+            long blockingGc = gcCount("art.gc.blocking-gc-count");
+
+            long[] sorted = Arrays.copyOf(latencies, runs);
+            Arrays.sort(sorted);
+            Window window = new Window(windows.size(), System.currentTimeMillis() - start, runs, failures,
+                                       percentile(sorted, 0.50), percentile(sorted, 0.95), javaHeap,
+                                       Debug.getNativeHeapAllocatedSize() / 1024, Debug.getPss(),
+                                       gc - lastGc, blockingGc - lastBlockingGc);
+            lastGc = gc;
+            lastBlockingGc = blockingGc;
+            Log.i(TAG, window.toString());
+            windows.add(window);
+        }
+
+        Report report = new Report(windows, analyze(windows, thresholds));
+        Log.i(TAG, report.toString());
+        return report;
+    }
+
+    /**
+     * 暖機後的時間窗以最小平方斜率換算成每小時變化，超過門檻且總變化顯著時列為回歸
+     */
+    static List<String> analyze(List<Window> windows, Thresholds thresholds) {
+        List<String> regressions = new ArrayList<>();
+        int from = Math.min(thresholds.warmupWindows, windows.size());
+        int n = windows.size() - from;
+        if (n < 3) {
+            return regressions;
+        }
+
+        double[] hours = new double[n];
+        double[] latency = new double[n];
+        double[] nativeHeap = new double[n];
+        double[] javaHeap = new double[n];
+        double[] pss = new double[n];
+        for (int i = 0; i < n; i++) {
+            Window window = windows.get(from + i);
+            hours[i] = window.endOffsetMs / MS_PER_HOUR;
+            latency[i] = window.p50Ms;
+            nativeHeap[i] = window.nativeHeapKb;
+            javaHeap[i] = window.javaHeapKb;
+            pss[i] = window.pssKb;
+        }
+        double span = hours[n - 1] - hours[0];
+
+        double baseline = Trend.median(latency, 0, Math.min(3, n));
+        double latencySlope = Trend.slope(hours, latency);
+        if (baseline > 0 && latencySlope / baseline > thresholds.latencyDriftPerHour
+            && latency[n - 1] > baseline * (1 + thresholds.latencyDriftPerHour * Math.min(1, span))) {
+            regressions.add(String.format(Locale.US, "latency drift %+.1f%%/h (p50 %.0fms -> %.0fms)",
+                                          latencySlope / baseline * 100, baseline, latency[n - 1]));
+        }
+        checkGrowth(regressions, "native heap", hours, nativeHeap, thresholds.nativeGrowthKbPerHour, thresholds);
+        checkGrowth(regressions, "Java heap", hours, javaHeap, thresholds.javaGrowthKbPerHour, thresholds);
+        checkGrowth(regressions, "PSS", hours, pss, thresholds.pssGrowthKbPerHour, thresholds);
+        return regressions;
+    }
+
+    private static void checkGrowth(List<String> regressions, String name, double[] hours, double[] kb,
+                                    double limitKbPerHour, Thresholds thresholds) {
+        double slope = Trend.slope(hours, kb);
+        double growth = kb[kb.length - 1] - kb[0];
+        if (slope > limitKbPerHour && growth > thresholds.minGrowthKb) {
+            regressions.add(String.format(Locale.US, "%s growth %.1fMB/h (+%.1fMB)", name, slope / 1024,
+                                          growth / 1024));
+        }
+    }
+
+    private boolean processOnce(Bitmap image, ThreadSafeSRProcessor.ProcessingMode mode) throws InterruptedException {
+        CountDownLatch done = new CountDownLatch(1);
+        boolean[] ok = new boolean[1];
+        processor.processImageWithMode(image, mode, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap result, long inferenceTime) {
+                result.recycle();
+                ok[0] = true;
+                done.countDown();
+            }
+
+            @Override
+            public void onError(String error) {
+                Log.w(TAG, mode + " request failed: " + error);
+                done.countDown();
+            }
+        });
+        return done.await(REQUEST_TIMEOUT_MS, TimeUnit.MILLISECONDS) && ok[0];
+    }
+
+    private static long gcCount(String stat) {
+        String value = Debug.getRuntimeStat(stat);
+        try {
+            return value != null ? Long.parseLong(value.trim()) : 0;
+        } catch (NumberFormatException e) {
+            return 0;
+        }
+    }
+
+    private static long percentile(long[] sorted, double fraction) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(fraction * sorted.length) - 1;
+        return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+    }
+}
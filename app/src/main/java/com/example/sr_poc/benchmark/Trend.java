@@ -0,0 +1,53 @@
+package com.example.sr_poc.benchmark;
+
+import java.util.Arrays;
+
+/**
+ * 最小平方法斜率，用於長時間量測判斷指標是否持續上升（而非單次尖峰）。
+ */
+public final class Trend {
+
+    private Trend() {
+        // Prevent instantiation
+    }
+
+    /**
+     * y 對 x 的最小平方斜率；點數不足或 x 無變化時回傳 0
+     */
+    public static double slope(double[] x, double[] y, int from, int to) {
+        int n = to - from;
+        if (n < 2) {
+            return 0;
+        }
+        double meanX = 0;
+        double meanY = 0;
+        for (int i = from; i < to; i++) {
+            meanX += x[i];
+            meanY += y[i];
+        }
+        meanX /= n;
+        meanY /= n;
+        double covariance = 0;
+        double variance = 0;
+        for (int i = from; i < to; i++) {
+            double dx = x[i] - meanX;
+            covariance += dx * (y[i] - meanY);
+            variance += dx * dx;
+        }
+        return variance > 0 ? covariance / variance : 0;
+    }
+
+    public static double slope(double[] x, double[] y) {
+        return slope(x, y, 0, Math.min(x.length, y.length));
+    }
+
+    public static double median(double[] values, int from, int to) {
+        if (to <= from) {
+            return 0;
+        }
+        double[] sorted = Arrays.copyOfRange(values, from, to);
+        Arrays.sort(sorted);
+        int mid = sorted.length / 2;
+        return sorted.length % 2 == 1 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+    }
+}
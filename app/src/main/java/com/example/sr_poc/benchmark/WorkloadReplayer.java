@@ -0,0 +1,182 @@
+package com.example.sr_poc.benchmark;
+
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.os.SystemClock;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+import com.example.sr_poc.processing.ProcessingController;
+import com.example.sr_poc.processing.WorkloadTrace;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 在裝置上依原本的時間點重送擷取的請求序列（開放迴圈：不等前一個完成），
+ * 經由 ProcessingController 完整路徑，因此排程、結果儲存與預先處理的改動都會反映在結果中。
+ * 有擷取輸入時使用原圖，否則以紀錄的尺寸產生合成影像（延遲相同，結果儲存的命中會不同）。
+ */
+public final class WorkloadReplayer {
+
+    private static final String TAG = "WorkloadReplayer";
+    private static final long DRAIN_TIMEOUT_MS = 10 * 60_000;
+
+    public static final class Report {
+        public final int requests;
+        public final int failures;
+        public final long p50Ms;
+        public final long p95Ms;
+        public final long maxMs;
+        public final long maxLatenessMs; // 送出時間落後排程的最大值，過大表示回放端本身跟不上
+
+        Report(int requests, int failures, long p50Ms, long p95Ms, long maxMs, long maxLatenessMs) {
+            this.requests = requests;
+            this.failures = failures;
+            this.p50Ms = p50Ms;
+            this.p95Ms = p95Ms;
+            this.maxMs = maxMs;
+            this.maxLatenessMs = maxLatenessMs;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "%d requests (%d failed): p50 %dms, p95 %dms, max %dms, max lateness %dms",
+                                 requests, failures, p50Ms, p95Ms, maxMs, maxLatenessMs);
+        }
+    }
+
+    private final ProcessingController controller;
+    private final File traceFile;
+
+    public WorkloadReplayer(ProcessingController controller, File traceFile) {
+        this.controller = controller;
+        this.traceFile = traceFile;
+    }
+
+    /**
+     * @param speed 時間倍率，2 表示以兩倍速度送出
+     */
+    public Report run(double speed) throws IOException, InterruptedException {
+        List<WorkloadTrace.Entry> entries = WorkloadTrace.read(traceFile);
+        Map<String, Bitmap> inputs = loadInputs(entries);
+
+        int count = entries.size();
+        long[] latencies = new long[count];
+        Arrays.fill(latencies, -1); // 失敗或逾時的請求維持 -1
+        AtomicInteger failures = new AtomicInteger();
+        CountDownLatch done = new CountDownLatch(count);
+        long maxLateness = 0;
+        long origin = SystemClock.elapsedRealtime();
+
+        for (int i = 0; i < count; i++) {
+            WorkloadTrace.Entry entry = entries.get(i);
+            long due = origin + (long) (entry.offsetMs / speed);
+            long wait = due - SystemClock.elapsedRealtime();
+            if (wait > 0) {
+                Thread.sleep(wait);
+            }
+            long issued = SystemClock.elapsedRealtime();
+            maxLateness = Math.max(maxLateness, issued - due);
+
+            int index = i;
+            controller.processBitmap(inputs.get(entry.inputHash), mode(entry), entry.tiling,
+                entry.targetWidth, entry.targetHeight, new ProcessingController.ProcessingCallback() {
+                    @Override
+                    public void onStart() {
+                    }
+
+                    @Override
+                    public void onProgress(String message) {
+                    }
+
+                    @Override
+                    public void onSuccess(Bitmap resultBitmap, String timeMessage) {
+                        latencies[index] = SystemClock.elapsedRealtime() - issued;
+                        resultBitmap.recycle();
+                    }
+
+                    @Override
+                    public void onError(String error) {
+                        Log.w(TAG, "Request " + index + " failed: " + error);
+                        failures.incrementAndGet();
+                    }
+
+                    @Override
+                    public void onComplete() {
+                        done.countDown();
+                    }
+                });
+        }
+        if (done.await(DRAIN_TIMEOUT_MS, TimeUnit.MILLISECONDS)) {
+            for (Bitmap input : inputs.values()) {
+                input.recycle();
+            }
+        } else {
+            // 仍在處理的請求會讀取輸入，不能回收
+            Log.w(TAG, done.getCount() + " requests still running after drain timeout");
+        }
+
+        long[] sorted = Arrays.stream(latencies).filter(latency -> latency >= 0).sorted().toArray();
+        Report report = new Report(count, failures.get(), percentile(sorted, 0.50), percentile(sorted, 0.95),
+                                   sorted.length > 0 ? sorted[sorted.length - 1] : 0, maxLateness);
+        Log.i(TAG, report.toString());
+        return report;
+    }
+
+    /**
+     * 送出前先準備好所有輸入，解碼時間不計入送出時間
+     */
+    private Map<String, Bitmap> loadInputs(List<WorkloadTrace.Entry> entries) throws IOException {
+        Map<String, Bitmap> inputs = new HashMap<>();
+        for (WorkloadTrace.Entry entry : entries) {
+            if (inputs.containsKey(entry.inputHash)) {
+                continue;
+            }
+            File file = WorkloadTrace.inputFileFor(traceFile, entry);
+            Bitmap input = null;
+            if (file != null) {
+                input = BitmapFactory.decodeFile(file.getPath());
+                if (input == null) {
+                    throw new IOException("Failed to decode " + file);
+                }
+            }
+            inputs.put(entry.inputHash, input != null ? input : synthetic(entry.width, entry.height));
+        }
+        return inputs;
+    }
+
+    private static Bitmap synthetic(int width, int height) {
+        Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        int[] row = new int[width];
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int r = x * 255 / Math.max(1, width - 1);
+                int g = y * 255 / Math.max(1, height - 1);
+                row[x] = 0xFF000000 | (r << 16) | (g << 8) | ((x ^ y) & 0xFF);
+            }
+            bitmap.setPixels(row, 0, width, 0, y, width, 1);
+        }
+        return bitmap;
+    }
+
+    private static ThreadSafeSRProcessor.ProcessingMode mode(WorkloadTrace.Entry entry) {
+        return WorkloadTrace.AUTO_MODE.equals(entry.mode) ? null : ThreadSafeSRProcessor.ProcessingMode.valueOf(entry.mode);
+    }
+
+    private static long percentile(long[] sorted, double fraction) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(fraction * sorted.length) - 1;
+        return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+    }
+}
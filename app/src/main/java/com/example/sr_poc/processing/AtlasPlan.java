@@ -0,0 +1,144 @@
+package com.example.sr_poc.processing;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * 小圖拼貼規劃：以 shelf packing 將多張小圖放進模型輸入大小的 atlas 頁面。
+ * 每張圖四周各保留 gutter 像素（以自身邊緣像素填滿），gutter 需不小於模型感受野半徑，
+ * 使每張圖的輸出不受鄰圖影響。放不進單頁的圖列在 oversized，需另外處理。
+ */
+public final class AtlasPlan {
+
+    /**
+     * Where one image sits inside an atlas page (content rectangle, gutter excluded)
+     */
+    public static final class Placement {
+        public final int imageIndex;
+        public final int page;
+        public final int x;
+        public final int y;
+        public final int width;
+        public final int height;
+
+        Placement(int imageIndex, int page, int x, int y, int width, int height) {
+            this.imageIndex = imageIndex;
+            this.page = page;
+            this.x = x;
+            this.y = y;
+            this.width = width;
+            this.height = height;
+        }
+    }
+
+    private final int pageWidth;
+    private final int pageHeight;
+    private final int gutter;
+    private final List<List<Placement>> pages;
+    private final List<Integer> oversized;
+
+    /**
+     * @param widths  image widths, indexed by image
+     * @param heights image heights, indexed by image
+     */
+    public AtlasPlan(int[] widths, int[] heights, int pageWidth, int pageHeight, int gutter) {
+        if (widths.length != heights.length) {
+            throw new IllegalArgumentException("widths and heights differ in length");
+        }
+        this.pageWidth = pageWidth;
+        this.pageHeight = pageHeight;
+        this.gutter = Math.max(0, gutter);
+
+        // 依高度遞減排序，讓同一層 shelf 的高度接近以減少浪費
+        List<Integer> order = new ArrayList<>(widths.length);
+        List<Integer> tooLarge = new ArrayList<>();
+        for (int i = 0; i < widths.length; i++) {
+            if (widths[i] + 2 * this.gutter > pageWidth || heights[i] + 2 * this.gutter > pageHeight
+                || widths[i] <= 0 || heights[i] <= 0) {
+                tooLarge.add(i);
+            } else {
+                order.add(i);
+            }
+        }
+        Collections.sort(order, (a, b) -> heights[b] != heights[a] ? heights[b] - heights[a] : widths[b] - widths[a]);
+
+        List<List<Placement>> result = new ArrayList<>();
+        List<Placement> page = new ArrayList<>();
+        int shelfTop = 0;
+        int shelfHeight = 0;
+        int cursorX = 0;
+
+        for (int index : order) {
+            int cellWidth = widths[index] + 2 * this.gutter;
+            int cellHeight = heights[index] + 2 * this.gutter;
+
+            if (cursorX + cellWidth > pageWidth) {
+                // 換到下一層 shelf
+                shelfTop += shelfHeight;
+                shelfHeight = 0;
+                cursorX = 0;
+            }
+            if (shelfTop + cellHeight > pageHeight) {
+                // 換到新的一頁
+                result.add(Collections.unmodifiableList(page));
+                page = new ArrayList<>();
+                shelfTop = 0;
+                shelfHeight = 0;
+                cursorX = 0;
+            }
+
+            page.add(new Placement(index, result.size(), cursorX + this.gutter, shelfTop + this.gutter,
+                                   widths[index], heights[index]));
+            cursorX += cellWidth;
+            shelfHeight = Math.max(shelfHeight, cellHeight);
+        }
+        if (!page.isEmpty()) {
+            result.add(Collections.unmodifiableList(page));
+        }
+
+        this.pages = Collections.unmodifiableList(result);
+        this.oversized = Collections.unmodifiableList(tooLarge);
+    }
+
+    public List<List<Placement>> getPages() {
+        return pages;
+    }
+
+    public int getPageCount() {
+        return pages.size();
+    }
+
+    /**
+     * Indices of images that do not fit a page together with their gutter
+     */
+    public List<Integer> getOversized() {
+        return oversized;
+    }
+
+    public int getPageWidth() {
+        return pageWidth;
+    }
+
+    public int getPageHeight() {
+        return pageHeight;
+    }
+
+    public int getGutter() {
+        return gutter;
+    }
+
+    public int getPlacedCount() {
+        int count = 0;
+        for (List<Placement> page : pages) {
+            count += page.size();
+        }
+        return count;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("AtlasPlan[%d images on %d pages of %dx%d, gutter=%d, %d oversized]",
+                             getPlacedCount(), pages.size(), pageWidth, pageHeight, gutter, oversized.size());
+    }
+}
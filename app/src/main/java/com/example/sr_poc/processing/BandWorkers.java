@@ -0,0 +1,190 @@
+package com.example.sr_poc.processing;
+
+import java.util.function.IntSupplier;
+
+/**
+ * 常駐的分段執行緒：把一個工作切成 bandCount 段並行，呼叫端自己執行第0段。
+ * 只用 monitor 的 wait/notify 協調，建構後每次 run 都不配置物件
+ * （ExecutorService 每次提交都會配置 FutureTask/佇列節點，CountDownLatch 等待時也會配置 AQS 節點）。
+ *
+ * 同一時間只允許一個 run；OutputKernel 只在 SR 線程上呼叫。
+ */
+public final class BandWorkers {
+
+    public interface BandTask {
+        void run(int band, int bandCount);
+    }
+
+    private final Thread[] threads;
+    private final Object lock = new Object();
+
+    // 以下由 lock 保護
+    private BandTask task;
+    private int bandCount;
+    private long generation;
+    private int remaining;
+    private RuntimeException failure;
+    private boolean closed;
+
+    // 量測模式：worker在每段前後呼叫probe（如 Debug.getThreadAllocCount）並累加差值
+    private volatile IntSupplier probe;
+    private long probeTotal;
+
+    /**
+     * @param workerCount 額外的執行緒數；最多可並行 workerCount + 1 段
+     */
+    public BandWorkers(String name, int workerCount) {
+        this(name, workerCount, null);
+    }
+
+    /**
+     * @param onWorkerStart 每個 worker 執行緒啟動時先在該執行緒上執行一次（如調整優先權、登記效能提示）；可為 null
+     */
+    public BandWorkers(String name, int workerCount, Runnable onWorkerStart) {
+        threads = new Thread[Math.max(0, workerCount)];
+        for (int i = 0; i < threads.length; i++) {
+            final int band = i + 1;
+            threads[i] = new Thread(() -> {
+                if (onWorkerStart != null) {
+                    onWorkerStart.run();
+                }
+                loop(band);
+            }, name + "-" + band);
+            threads[i].setDaemon(true);
+            threads[i].start();
+        }
+    }
+
+    public int getMaxBands() {
+        return threads.length + 1;
+    }
+
+    /**
+     * 執行 task 的第 0..bandCount-1 段並等待全部完成；任一段拋出的例外會在此重新拋出
+     */
+    public void run(int bandCount, BandTask task) {
+        int bands = Math.max(1, Math.min(bandCount, getMaxBands()));
+        if (bands > 1) {
+            synchronized (lock) {
+                if (closed) {
+                    throw new IllegalStateException("BandWorkers closed");
+                }
+                this.task = task;
+                this.bandCount = bands;
+                this.remaining = bands - 1;
+                this.failure = null;
+                generation++;
+                lock.notifyAll();
+            }
+        }
+
+        RuntimeException own = null;
+        try {
+            task.run(0, bands);
+        } catch (RuntimeException e) {
+            own = e;
+        }
+        if (bands == 1) {
+            if (own != null) {
+                throw own;
+            }
+            return;
+        }
+
+        RuntimeException failed;
+        synchronized (lock) {
+            boolean interrupted = false;
+            while (remaining > 0) {
+                try {
+                    lock.wait();
+                } catch (InterruptedException e) {
+                    // 段仍在使用呼叫端的緩衝，必須等完成才能返回
+                    interrupted = true;
+                }
+            }
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+            this.task = null;
+            failed = failure;
+        }
+        if (own != null) {
+            throw own;
+        }
+        if (failed != null) {
+            throw failed;
+        }
+    }
+
+    private void loop(int band) {
+        long seen = 0;
+        while (true) {
+            BandTask current;
+            int bands;
+            synchronized (lock) {
+                while (!closed && generation == seen) {
+                    try {
+                        lock.wait();
+                    } catch (InterruptedException e) {
+                        return;
+                    }
+                }
+                if (generation == seen) {
+                    return; // 已關閉且沒有待執行的段
+                }
+                seen = generation;
+                current = task;
+                bands = bandCount;
+            }
+            if (band >= bands) {
+                continue;
+            }
+
+            IntSupplier activeProbe = probe;
+            int before = activeProbe != null ? activeProbe.getAsInt() : 0;
+            RuntimeException error = null;
+            try {
+                current.run(band, bands);
+            } catch (RuntimeException e) {
+                error = e;
+            }
+            int delta = activeProbe != null ? activeProbe.getAsInt() - before : 0;
+
+            synchronized (lock) {
+                probeTotal += delta;
+                if (error != null && failure == null) {
+                    failure = error;
+                }
+                if (--remaining == 0) {
+                    lock.notifyAll();
+                }
+            }
+        }
+    }
+
+    /**
+     * 測試用：設定每段前後呼叫的計數器（null停用），並歸零累計值
+     */
+    public void setProbe(IntSupplier probe) {
+        synchronized (lock) {
+            this.probe = probe;
+            probeTotal = 0;
+        }
+    }
+
+    /**
+     * worker執行緒上 probe 差值的累計（不含呼叫端執行的第0段）
+     */
+    public long getProbeTotal() {
+        synchronized (lock) {
+            return probeTotal;
+        }
+    }
+
+    public void close() {
+        synchronized (lock) {
+            closed = true;
+            lock.notifyAll();
+        }
+    }
+}
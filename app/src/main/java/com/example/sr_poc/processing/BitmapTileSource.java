@@ -0,0 +1,35 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+
+/**
+ * 已解碼的 Bitmap 作為分塊來源（不擁有該 Bitmap，close 不會 recycle）
+ */
+public final class BitmapTileSource implements TileSource {
+
+    private final Bitmap bitmap;
+
+    public BitmapTileSource(Bitmap bitmap) {
+        this.bitmap = bitmap;
+    }
+
+    @Override
+    public int getWidth() {
+        return bitmap.getWidth();
+    }
+
+    @Override
+    public int getHeight() {
+        return bitmap.getHeight();
+    }
+
+    @Override
+    public void readRegion(int left, int top, int width, int height, int[] dst) {
+        bitmap.getPixels(dst, 0, width, left, top, width, height);
+    }
+
+    @Override
+    public void close() {
+        // Bitmap由呼叫端管理
+    }
+}
@@ -0,0 +1,138 @@
+package com.example.sr_poc.processing;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * 跨請求的動態批次視窗：相容的請求（相同key）在 maxDelayMs 或 maxBatchSize 內被收集成一批，
+ * 交給 BatchHandler 一次執行。所有批次都在同一個 Scheduler（推理線程）上執行。
+ */
+public final class DynamicBatcher<T> {
+
+    /**
+     * Serial executor the batches run on (the inference thread)
+     */
+    public interface Scheduler {
+        void execute(Runnable task);
+
+        void schedule(Runnable task, long delayMs);
+    }
+
+    public interface KeyFunction<T> {
+        Object keyOf(T item);
+    }
+
+    public interface BatchHandler<T> {
+        void onBatch(List<T> batch);
+    }
+
+    private final Scheduler scheduler;
+    private final KeyFunction<T> keyFunction;
+    private final BatchHandler<T> handler;
+    private final Map<Object, Group> groups = new HashMap<>();
+
+    private int maxBatchSize = 1;
+    private long maxDelayMs = 0;
+
+    public DynamicBatcher(Scheduler scheduler, KeyFunction<T> keyFunction, BatchHandler<T> handler) {
+        this.scheduler = scheduler;
+        this.keyFunction = keyFunction;
+        this.handler = handler;
+    }
+
+    public synchronized void setPolicy(int maxBatchSize, long maxDelayMs) {
+        this.maxBatchSize = Math.max(1, maxBatchSize);
+        this.maxDelayMs = Math.max(0, maxDelayMs);
+    }
+
+    public synchronized int getMaxBatchSize() {
+        return maxBatchSize;
+    }
+
+    public synchronized long getMaxDelayMs() {
+        return maxDelayMs;
+    }
+
+    /**
+     * Number of requests waiting for their batch window to close
+     */
+    public synchronized int getQueueDepth() {
+        int depth = 0;
+        for (Group group : groups.values()) {
+            depth += group.pending.size();
+        }
+        return depth;
+    }
+
+    public void submit(T item) {
+        Object key = keyFunction.keyOf(item);
+        synchronized (this) {
+            Group group = groups.get(key);
+            if (group == null) {
+                group = new Group(key);
+                groups.put(key, group);
+            }
+            group.pending.add(item);
+
+            if (group.pending.size() >= maxBatchSize) {
+                // 批次已滿：不再等待視窗，立即排入推理線程
+                if (!group.flushPosted) {
+                    group.flushPosted = true;
+                    scheduler.execute(group.flushTask);
+                }
+            } else if (!group.flushPosted && !group.timerArmed) {
+                group.timerArmed = true;
+                if (maxDelayMs == 0) {
+                    scheduler.execute(group.timerTask);
+                } else {
+                    scheduler.schedule(group.timerTask, maxDelayMs);
+                }
+            }
+        }
+    }
+
+    private final class Group {
+        final Object key;
+        final List<T> pending = new ArrayList<>();
+        boolean flushPosted;
+        boolean timerArmed;
+
+        final Runnable flushTask = () -> flush(this, true);
+        final Runnable timerTask = () -> flush(this, false);
+
+        Group(Object key) {
+            this.key = key;
+        }
+    }
+
+    private void flush(Group group, boolean fromFullBatch) {
+        List<T> batch;
+        synchronized (this) {
+            if (fromFullBatch) {
+                group.flushPosted = false;
+            } else {
+                group.timerArmed = false;
+            }
+            if (group.pending.isEmpty()) {
+                return;
+            }
+            int count = Math.min(maxBatchSize, group.pending.size());
+            batch = new ArrayList<>(group.pending.subList(0, count));
+            group.pending.subList(0, count).clear();
+
+            if (!group.pending.isEmpty() && !group.flushPosted) {
+                // 剩餘請求：滿批立即處理，否則重新開一個視窗
+                if (group.pending.size() >= maxBatchSize) {
+                    group.flushPosted = true;
+                    scheduler.execute(group.flushTask);
+                } else if (!group.timerArmed) {
+                    group.timerArmed = true;
+                    scheduler.schedule(group.timerTask, maxDelayMs);
+                }
+            }
+        }
+        handler.onBatch(batch);
+    }
+}
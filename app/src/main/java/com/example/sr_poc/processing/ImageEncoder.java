@@ -0,0 +1,142 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.example.sr_poc.TileProcessor;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.zip.Deflater;
+
+/**
+ * 超解析度輸出的編碼階段。PNG 以 ParallelPngEncoder 依列分段平行壓縮；
+ * JPEG/WebP 使用 Bitmap.compress（Android 未提供 restart interval 或分段編碼的介面）。
+ */
+public final class ImageEncoder {
+
+    private static final String TAG = "ImageEncoder";
+
+    public static final int DEFAULT_STRIP_ROWS = 64;
+
+    private static ExecutorService executor;
+
+    private ImageEncoder() {
+        // Prevent instantiation
+    }
+
+    /**
+     * 共用的編碼執行緒池（與核心數相同）
+     */
+    public static synchronized ExecutorService getExecutor() {
+        if (executor == null) {
+            int threads = Runtime.getRuntime().availableProcessors();
+            AtomicInteger counter = new AtomicInteger();
+            executor = Executors.newFixedThreadPool(threads, r -> {
+                Thread thread = new Thread(r, "ImageEncoder-" + counter.incrementAndGet());
+                thread.setPriority(Thread.NORM_PRIORITY - 1);
+                return thread;
+            });
+        }
+        return executor;
+    }
+
+    public static void encode(Bitmap bitmap, Bitmap.CompressFormat format, int quality, OutputStream out)
+            throws IOException {
+        if (format == Bitmap.CompressFormat.PNG) {
+            encodePng(bitmap, out);
+            return;
+        }
+
+        long start = System.currentTimeMillis();
+        if (!bitmap.compress(format, quality, out)) {
+            throw new IOException("Bitmap.compress failed for " + format);
+        }
+        Log.d(TAG, String.format("%s %dx%d: compress %d ms (single-threaded)", format,
+                                 bitmap.getWidth(), bitmap.getHeight(), System.currentTimeMillis() - start));
+    }
+
+    public static void encodePng(Bitmap bitmap, OutputStream out) throws IOException {
+        PngRowSink sink = new PngRowSink(out, bitmap.getHeight());
+        sink.onRowsComplete(bitmap, 0, 0, bitmap.getHeight());
+        sink.finish();
+    }
+
+    /**
+     * 接收分塊處理完成的列並立即送去平行壓縮，輸出圖不需等全部完成才開始編碼
+     */
+    public static final class PngRowSink implements TileProcessor.RowListener {
+
+        private final OutputStream out;
+        private final int imageHeight;
+        private ParallelPngEncoder encoder;
+        private IOException failure;
+
+        /**
+         * 列來自完整輸出圖時使用，影像高度取自該圖
+         */
+        public PngRowSink(OutputStream out) {
+            this(out, 0);
+        }
+
+        /**
+         * @param imageHeight 完整輸出的高度（列可能分批來自只有一排高的輸出帶）
+         */
+        public PngRowSink(OutputStream out, int imageHeight) {
+            this.out = out;
+            this.imageHeight = imageHeight;
+        }
+
+        @Override
+        public void onRowsComplete(Bitmap pixelsSource, int sourceTop, int top, int bottom) {
+            if (failure != null) {
+                return;
+            }
+            try {
+                if (encoder == null) {
+                    int inFlight = 2 * Runtime.getRuntime().availableProcessors();
+                    int height = imageHeight > 0 ? imageHeight : pixelsSource.getHeight();
+                    encoder = new ParallelPngEncoder(out, pixelsSource.getWidth(), height, pixelsSource.hasAlpha(),
+                                                     getExecutor(), Deflater.DEFAULT_COMPRESSION,
+                                                     DEFAULT_STRIP_ROWS, inFlight);
+                }
+                // 以strip為單位讀取像素，避免一次複製整批列
+                int width = pixelsSource.getWidth();
+                for (int y = top; y < bottom; y += DEFAULT_STRIP_ROWS) {
+                    int rows = Math.min(DEFAULT_STRIP_ROWS, bottom - y);
+                    int[] pixels = new int[width * rows];
+                    pixelsSource.getPixels(pixels, 0, width, 0, sourceTop + (y - top), width, rows);
+                    encoder.writeRows(pixels, rows);
+                }
+            } catch (IOException e) {
+                failure = e;
+                if (encoder != null) {
+                    encoder.abort();
+                }
+            }
+        }
+
+        /**
+         * 寫出剩餘資料；串流過程中發生的錯誤在此拋出
+         */
+        public void finish() throws IOException {
+            if (failure != null) {
+                throw failure;
+            }
+            if (encoder == null) {
+                throw new IOException("No rows were written");
+            }
+            encoder.finish();
+            Log.d(TAG, encoder.getReport());
+        }
+
+        public void abort() {
+            if (encoder != null) {
+                encoder.abort();
+            }
+        }
+    }
+}
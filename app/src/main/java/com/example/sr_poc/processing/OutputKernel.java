@@ -0,0 +1,466 @@
+package com.example.sr_poc.processing;
+
+import java.util.Arrays;
+
+import com.example.sr_poc.utils.Constants;
+
+/**
+ * 單次掃描的輸出轉換 kernel：解碼模型輸出列 → 後處理鏈 → (重取樣) → 量化成 ARGB。
+ * 大圖按列分段並行，每段持有自己的列緩存，後處理與縮放都不會增加額外的記憶體掃描。
+ * 目標網格與模型倍率不同時，於同一趟內以雙線性取樣（縮小超過2倍時多點平均）映射到目標像素。
+ * 緩衝與取樣表在尺寸不變時重複使用，穩態下每次 run 不配置物件（見 ZeroAllocationTest）。
+ */
+public final class OutputKernel {
+
+    /**
+     * Row-wise view over a model output tensor
+     */
+    public interface Source {
+        int width();
+
+        int height();
+
+        /** Decode row y into interleaved RGB floats in [0,1] */
+        void decodeRow(int y, float[] dst);
+
+        /** 量化截斷前要加上的捨入偏移；有 dither 時由門檻取代，不會疊加 */
+        float roundingOffset();
+
+        /** Fast path without post ops: pack count pixels of row y starting at x0 straight to ARGB */
+        void packRow(int y, int x0, int count, int[] dst, int offset);
+    }
+
+    private final BandWorkers workers;
+    private PostProcessChain chain = PostProcessChain.EMPTY;
+    private Band[] bands = new Band[0];
+
+    // 水平取樣表（同一region重複使用，region改變時就地重填）
+    private OutputRegion tapRegion;
+    private int tapSourceWidth;
+    private final Taps columnTaps = new Taps();
+
+    // 目前分段執行的工作；bandTask 只建立一次，避免每次配置 lambda
+    private Source activeSource;
+    private OutputRegion activeRegion;
+    private Taps activeTaps;
+    private int[] activePixels;
+    private PostProcessChain activeChain;
+    private final BandWorkers.BandTask bandTask = this::runBand;
+
+    /**
+     * @param workers 大圖分段並行用；null 表示單執行緒
+     */
+    public OutputKernel(BandWorkers workers) {
+        this.workers = workers;
+    }
+
+    public void setChain(PostProcessChain chain) {
+        this.chain = chain != null ? chain : PostProcessChain.EMPTY;
+    }
+
+    public PostProcessChain getChain() {
+        return chain;
+    }
+
+    /**
+     * Convert the whole source into packed ARGB pixels at native scale
+     */
+    public void run(Source source, int[] pixels) {
+        run(source, OutputRegion.identity(source.width(), source.height()), pixels);
+    }
+
+    /**
+     * Produce region.width x region.height packed ARGB pixels (row stride region.width)
+     */
+    public void run(Source source, OutputRegion region, int[] pixels) {
+        if (region.width <= 0 || region.height <= 0) {
+            return;
+        }
+        boolean resample = !region.isUnitScale();
+        Taps taps = resample ? columnTapsFor(region, source.width()) : null;
+
+        int numBands = 1;
+        if (workers != null && (long) region.width * region.height > Constants.LARGE_IMAGE_PIXEL_THRESHOLD) {
+            numBands = Math.min(Constants.MAX_CONVERSION_THREADS, workers.getMaxBands());
+            numBands = Math.max(1, Math.min(numBands, region.height));
+        }
+        ensureBands(numBands, source.width(), region.width);
+
+        if (numBands == 1) {
+            bands[0].process(source, region, taps, pixels, chain, 0, region.height);
+            return;
+        }
+
+        activeSource = source;
+        activeRegion = region;
+        activeTaps = taps;
+        activePixels = pixels;
+        activeChain = chain;
+        try {
+            workers.run(numBands, bandTask);
+        } finally {
+            activeSource = null;
+            activeRegion = null;
+            activeTaps = null;
+            activePixels = null;
+            activeChain = null;
+        }
+    }
+
+    private void runBand(int band, int bandCount) {
+        int rowsPerBand = activeRegion.height / bandCount;
+        int startRow = band * rowsPerBand;
+        int endRow = band == bandCount - 1 ? activeRegion.height : startRow + rowsPerBand;
+        bands[band].process(activeSource, activeRegion, activeTaps, activePixels, activeChain, startRow, endRow);
+    }
+
+    private void ensureBands(int count, int sourceWidth, int targetWidth) {
+        if (bands.length < count) {
+            Band[] grown = new Band[count];
+            System.arraycopy(bands, 0, grown, 0, bands.length);
+            bands = grown;
+        }
+        for (int i = 0; i < count; i++) {
+            if (bands[i] == null || bands[i].sourceWidth != sourceWidth || bands[i].targetWidth < targetWidth) {
+                bands[i] = new Band(sourceWidth, targetWidth);
+            }
+        }
+    }
+
+    private Taps columnTapsFor(OutputRegion region, int sourceWidth) {
+        if (tapRegion == null || sourceWidth != tapSourceWidth || !sameColumns(region, tapRegion)) {
+            columnTaps.fill(region.width, region.originX, region.stepX, sourceWidth);
+            tapRegion = region;
+            tapSourceWidth = sourceWidth;
+        }
+        return columnTaps;
+    }
+
+    private static boolean sameColumns(OutputRegion a, OutputRegion b) {
+        return b != null && a.width == b.width && a.originX == b.originX && a.stepX == b.stepX;
+    }
+
+    /**
+     * Bilinear sample positions along one axis; steps above 2 use several evenly spaced taps.
+     * Refilled in place; the arrays only grow.
+     */
+    static final class Taps {
+        int count;
+        int tapsPerPixel;
+        int[] index = new int[0];
+        float[] frac = new float[0];
+        float weight;
+
+        void fill(int count, double origin, double step, int sourceLength) {
+            this.count = count;
+            this.tapsPerPixel = Math.max(1, (int) Math.ceil(step / 2.0));
+            if (index.length < count * tapsPerPixel) {
+                index = new int[count * tapsPerPixel];
+                frac = new float[count * tapsPerPixel];
+            }
+            this.weight = 1f / tapsPerPixel;
+
+            double spacing = step / tapsPerPixel;
+            for (int t = 0, k = 0; t < count; t++) {
+                double centre = origin + t * step;
+                for (int j = 0; j < tapsPerPixel; j++, k++) {
+                    double pos = centre + (j + 0.5) * spacing - step / 2.0;
+                    pos = Math.max(0, Math.min(sourceLength - 1, pos));
+                    int i0 = Math.min((int) pos, sourceLength - 1);
+                    index[k] = i0;
+                    frac[k] = (float) (pos - i0);
+                }
+            }
+        }
+    }
+
+    /**
+     * Per-thread scratch: decoded and filtered source row caches plus target row buffers
+     */
+    private static final class Band {
+        final int sourceWidth;
+        final int targetWidth;
+
+        // 解碼列的3列環形緩存（stencil視窗）
+        final float[][] decoded = new float[3][];
+        final int[] decodedRow = {-1, -1, -1};
+
+        // 經stencil後的來源列緩存，供垂直取樣使用
+        float[][] filtered = new float[0][];
+        int[] filteredRow = new int[0];
+
+        final float[] sourceOut;
+        final float[] targetOut;
+        final Taps rows = new Taps();
+
+        Band(int sourceWidth, int targetWidth) {
+            this.sourceWidth = sourceWidth;
+            this.targetWidth = targetWidth;
+            for (int i = 0; i < 3; i++) {
+                decoded[i] = new float[sourceWidth * 3];
+            }
+            sourceOut = new float[sourceWidth * 3];
+            targetOut = new float[targetWidth * 3];
+        }
+
+        void process(Source source, OutputRegion region, Taps columns, int[] pixels,
+                     PostProcessChain chain, int startRow, int endRow) {
+            decodedRow[0] = decodedRow[1] = decodedRow[2] = -1;
+
+            if (columns == null) {
+                processUnitScale(source, region, pixels, chain, startRow, endRow);
+            } else {
+                processResampled(source, region, columns, pixels, chain, startRow, endRow);
+            }
+        }
+
+        private void processUnitScale(Source source, OutputRegion region, int[] pixels,
+                                      PostProcessChain chain, int startRow, int endRow) {
+            int x0 = (int) region.originX;
+            int y0 = (int) region.originY;
+            float rounding = chain.isDithered() ? 0f : source.roundingOffset();
+            for (int ty = startRow; ty < endRow; ty++) {
+                int sy = y0 + ty;
+                int offset = ty * region.width;
+                if (chain.isEmpty()) {
+                    source.packRow(sy, x0, region.width, pixels, offset);
+                    continue;
+                }
+                float[] row = filter(source, chain, sy, sourceOut);
+                if (x0 != 0) {
+                    System.arraycopy(row, x0 * 3, targetOut, 0, region.width * 3);
+                    row = targetOut;
+                }
+                chain.applyPointOps(row, region.width, region.left, region.top + ty);
+                quantizeRow(row, pixels, offset, region.width, rounding);
+            }
+        }
+
+        private void processResampled(Source source, OutputRegion region, Taps columns, int[] pixels,
+                                      PostProcessChain chain, int startRow, int endRow) {
+            rows.fill(endRow - startRow, region.originY + startRow * region.stepY, region.stepY, source.height());
+            ensureFilteredCache((int) Math.ceil(region.stepY) + 3);
+
+            int lastRow = source.height() - 1;
+            float weight = rows.weight * columns.weight;
+            float rounding = chain.isDithered() ? 0f : source.roundingOffset();
+            for (int ty = startRow, r = 0; ty < endRow; ty++, r++) {
+                Arrays.fill(targetOut, 0, region.width * 3, 0f);
+
+                for (int j = 0; j < rows.tapsPerPixel; j++) {
+                    int k = r * rows.tapsPerPixel + j;
+                    int sy = rows.index[k];
+                    float fy = rows.frac[k];
+                    float[] upper = cachedFiltered(source, chain, sy);
+                    float[] lower = cachedFiltered(source, chain, Math.min(sy + 1, lastRow));
+                    accumulateRow(upper, lower, fy, columns, weight, region.width);
+                }
+
+                chain.applyPointOps(targetOut, region.width, region.left, region.top + ty);
+                quantizeRow(targetOut, pixels, ty * region.width, region.width, rounding);
+            }
+        }
+
+        private void accumulateRow(float[] upper, float[] lower, float fy, Taps columns,
+                                   float weight, int width) {
+            int lastColumn = (sourceWidth - 1) * 3;
+            for (int tx = 0, o = 0; tx < width; tx++, o += 3) {
+                float r = 0f, g = 0f, b = 0f;
+                for (int j = 0; j < columns.tapsPerPixel; j++) {
+                    int k = tx * columns.tapsPerPixel + j;
+                    int i0 = columns.index[k] * 3;
+                    int i1 = Math.min(i0 + 3, lastColumn);
+                    float fx = columns.frac[k];
+                    float w00 = (1f - fx) * (1f - fy);
+                    float w01 = fx * (1f - fy);
+                    float w10 = (1f - fx) * fy;
+                    float w11 = fx * fy;
+                    r += upper[i0] * w00 + upper[i1] * w01 + lower[i0] * w10 + lower[i1] * w11;
+                    g += upper[i0 + 1] * w00 + upper[i1 + 1] * w01 + lower[i0 + 1] * w10 + lower[i1 + 1] * w11;
+                    b += upper[i0 + 2] * w00 + upper[i1 + 2] * w01 + lower[i0 + 2] * w10 + lower[i1 + 2] * w11;
+                }
+                targetOut[o] += r * weight;
+                targetOut[o + 1] += g * weight;
+                targetOut[o + 2] += b * weight;
+            }
+        }
+
+        private void ensureFilteredCache(int size) {
+            if (filtered.length < size) {
+                filtered = new float[size][];
+                filteredRow = new int[size];
+                for (int i = 0; i < size; i++) {
+                    filtered[i] = new float[sourceWidth * 3];
+                }
+            }
+            Arrays.fill(filteredRow, -1);
+        }
+
+        private float[] cachedFiltered(Source source, PostProcessChain chain, int sy) {
+            int slot = sy % filtered.length;
+            if (filteredRow[slot] != sy) {
+                filter(source, chain, sy, filtered[slot]);
+                filteredRow[slot] = sy;
+            }
+            return filtered[slot];
+        }
+
+        /**
+         * Source row sy after the stencil op (or just decoded when the chain has none)
+         */
+        private float[] filter(Source source, PostProcessChain chain, int sy, float[] out) {
+            if (!chain.hasStencil()) {
+                source.decodeRow(sy, out);
+                return out;
+            }
+            int lastRow = source.height() - 1;
+            float[] above = fetch(source, Math.max(sy - 1, 0));
+            float[] center = fetch(source, sy);
+            float[] below = fetch(source, Math.min(sy + 1, lastRow));
+            chain.getStencil().applyRow(above, center, below, out, sourceWidth);
+            return out;
+        }
+
+        private float[] fetch(Source source, int y) {
+            int slot = y % 3;
+            if (decodedRow[slot] != y) {
+                source.decodeRow(y, decoded[slot]);
+                decodedRow[slot] = y;
+            }
+            return decoded[slot];
+        }
+    }
+
+    static void quantizeRow(float[] rgb, int[] pixels, int offset, int width, float rounding) {
+        for (int x = 0, i = 0; x < width; x++, i += 3) {
+            int r = toByte(rgb[i] + rounding);
+            int g = toByte(rgb[i + 1] + rounding);
+            int b = toByte(rgb[i + 2] + rounding);
+            pixels[offset + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    private static int toByte(float v) {
+        return (int) (Math.max(0f, Math.min(1f, v)) * 255);
+    }
+
+    // ---- Sources over the cached tensor arrays ----
+
+    public static Source float32(float[] data, int width, int height) {
+        return new Float32Source(data, width, height);
+    }
+
+    public static Source uint8(byte[] data, int width, int height) {
+        return new ByteSource(data, width, height, 0);
+    }
+
+    public static Source int8(byte[] data, int width, int height) {
+        return new ByteSource(data, width, height, 128);
+    }
+
+    private static final class Float32Source implements Source {
+        private final float[] data;
+        private final int width;
+        private final int height;
+
+        Float32Source(float[] data, int width, int height) {
+            this.data = data;
+            this.width = width;
+            this.height = height;
+        }
+
+        @Override
+        public int width() {
+            return width;
+        }
+
+        @Override
+        public int height() {
+            return height;
+        }
+
+        @Override
+        public void decodeRow(int y, float[] dst) {
+            int base = y * width * 3;
+            for (int i = 0; i < width * 3; i++) {
+                dst[i] = normalize(data[base + i]);
+            }
+        }
+
+        @Override
+        public float roundingOffset() {
+            // 與 packRow 一致：浮點輸出直接截斷
+            return 0f;
+        }
+
+        @Override
+        public void packRow(int y, int x0, int count, int[] dst, int offset) {
+            int base = (y * width + x0) * 3;
+            for (int x = 0, i = base; x < count; x++, i += 3) {
+                int r = toByte(normalize(data[i]));
+                int g = toByte(normalize(data[i + 1]));
+                int b = toByte(normalize(data[i + 2]));
+                dst[offset + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+            }
+        }
+
+        private static float normalize(float value) {
+            // Handle both [0,1] and [-1,1] ranges for different model types
+            return value < 0 ? (value + 1.0f) / 2.0f : value;
+        }
+    }
+
+    /**
+     * UINT8 (bias 0) or INT8 (bias 128) tensor data
+     */
+    private static final class ByteSource implements Source {
+        private static final float BYTE_TO_FLOAT = Constants.RGB_TO_FLOAT_MULTIPLIER;
+
+        private final byte[] data;
+        private final int width;
+        private final int height;
+        private final int bias;
+
+        ByteSource(byte[] data, int width, int height, int bias) {
+            this.data = data;
+            this.width = width;
+            this.height = height;
+            this.bias = bias;
+        }
+
+        @Override
+        public int width() {
+            return width;
+        }
+
+        @Override
+        public int height() {
+            return height;
+        }
+
+        @Override
+        public void decodeRow(int y, float[] dst) {
+            int base = y * width * 3;
+            for (int i = 0; i < width * 3; i++) {
+                dst[i] = ((data[base + i] + bias) & 0xFF) * BYTE_TO_FLOAT;
+            }
+        }
+
+        @Override
+        public float roundingOffset() {
+            // 半個 LSB 讓量化時的截斷還原為原值；在後處理之後才加，不經過 gamma 曲線
+            return 0.5f * BYTE_TO_FLOAT;
+        }
+
+        @Override
+        public void packRow(int y, int x0, int count, int[] dst, int offset) {
+            int base = (y * width + x0) * 3;
+            for (int x = 0, i = base; x < count; x++, i += 3) {
+                int r = (data[i] + bias) & 0xFF;
+                int g = (data[i + 1] + bias) & 0xFF;
+                int b = (data[i + 2] + bias) & 0xFF;
+                dst[offset + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+            }
+        }
+    }
+}
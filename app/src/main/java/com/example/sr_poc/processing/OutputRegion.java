@@ -0,0 +1,82 @@
+package com.example.sr_poc.processing;
+
+/**
+ * 輸出 kernel 要產生的目標網格視窗。
+ * 目標像素 (tx, ty) 的中心對應到模型輸出座標
+ * (originX + tx * stepX, originY + ty * stepY)（以像素中心為整數）。
+ * left/top 為此視窗在最終輸出圖上的位置。
+ */
+public final class OutputRegion {
+
+    public final int left;
+    public final int top;
+    public final int width;
+    public final int height;
+    public final double originX;
+    public final double originY;
+    public final double stepX;
+    public final double stepY;
+
+    public OutputRegion(int left, int top, int width, int height,
+                        double originX, double originY, double stepX, double stepY) {
+        this.left = left;
+        this.top = top;
+        this.width = width;
+        this.height = height;
+        this.originX = originX;
+        this.originY = originY;
+        this.stepX = stepX;
+        this.stepY = stepY;
+    }
+
+    /**
+     * Whole model output at its native scale
+     */
+    public static OutputRegion identity(int width, int height) {
+        return new OutputRegion(0, 0, width, height, 0, 0, 1, 1);
+    }
+
+    /**
+     * Whole model output resampled to an exact target size
+     */
+    public static OutputRegion scaled(int sourceWidth, int sourceHeight, int targetWidth, int targetHeight) {
+        double stepX = (double) sourceWidth / targetWidth;
+        double stepY = (double) sourceHeight / targetHeight;
+        return new OutputRegion(0, 0, targetWidth, targetHeight,
+                                0.5 * stepX - 0.5, 0.5 * stepY - 0.5, stepX, stepY);
+    }
+
+    /**
+     * True when every target pixel maps onto exactly one source pixel
+     */
+    public boolean isUnitScale() {
+        return stepX == 1.0 && stepY == 1.0
+            && originX == Math.rint(originX) && originY == Math.rint(originY);
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (!(o instanceof OutputRegion)) return false;
+        OutputRegion other = (OutputRegion) o;
+        return left == other.left && top == other.top
+            && width == other.width && height == other.height
+            && originX == other.originX && originY == other.originY
+            && stepX == other.stepX && stepY == other.stepY;
+    }
+
+    @Override
+    public int hashCode() {
+        int result = width * 31 + height;
+        result = result * 31 + Double.hashCode(originX);
+        result = result * 31 + Double.hashCode(originY);
+        result = result * 31 + Double.hashCode(stepX);
+        return result * 31 + Double.hashCode(stepY);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("OutputRegion[%dx%d @(%d,%d) origin=(%.2f,%.2f) step=(%.3f,%.3f)]",
+                             width, height, left, top, originX, originY, stepX, stepY);
+    }
+}
@@ -0,0 +1,214 @@
+package com.example.sr_poc.processing;
+
+import android.content.res.AssetManager;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.graphics.BitmapRegionDecoder;
+import android.graphics.Rect;
+import android.os.Build;
+import android.util.Log;
+
+import com.example.sr_poc.utils.BitmapPool;
+import com.example.sr_poc.utils.Constants;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 大圖解碼：直接從asset串流解碼（AssetInputStream 由原生端直接讀取asset，不在heap複製整個檔案），
+ * 寫入呼叫端提供（或池中取得）的 Bitmap。
+ * JPEG/WebP 大圖以多個 BitmapRegionDecoder 依列分段平行解碼到池中的strip，再以重用的列緩衝複製進target；
+ * PNG 為單一 zlib 串流無法分段，單線程以 inBitmap 直接解碼進target。
+ */
+public final class ParallelImageDecoder {
+
+    private static final String TAG = "ParallelImageDecoder";
+    private static final int MIN_STRIP_ROWS = 256;
+    private static final int COPY_ROWS = 32; // strip複製到target時每次搬移的列數
+
+    private static ExecutorService executor;
+
+    // 每個解碼執行緒重用的複製緩衝
+    private static final ThreadLocal<int[]> copyBuffer = new ThreadLocal<>();
+
+    private final BitmapPool pool;
+    private final int threads;
+
+    public ParallelImageDecoder(BitmapPool pool) {
+        this.pool = pool;
+        this.threads = Math.min(Runtime.getRuntime().availableProcessors(), Constants.MAX_CONVERSION_THREADS);
+    }
+
+    private static synchronized ExecutorService getExecutor(int threads) {
+        if (executor == null) {
+            AtomicInteger counter = new AtomicInteger();
+            executor = Executors.newFixedThreadPool(threads, r -> {
+                Thread thread = new Thread(r, "ImageDecoder-" + counter.incrementAndGet());
+                thread.setPriority(Thread.NORM_PRIORITY);
+                return thread;
+            });
+        }
+        return executor;
+    }
+
+    /**
+     * 解碼asset圖片；target不為null且尺寸相符時直接寫入target
+     */
+    public Bitmap decodeAsset(AssetManager assets, String path, Bitmap target) throws IOException {
+        long start = System.currentTimeMillis();
+        BitmapFactory.Options bounds = new BitmapFactory.Options();
+        bounds.inJustDecodeBounds = true;
+        try (InputStream in = assets.open(path)) {
+            BitmapFactory.decodeStream(in, null, bounds);
+        }
+        int width = bounds.outWidth;
+        int height = bounds.outHeight;
+        if (width <= 0 || height <= 0) {
+            throw new IOException("Unrecognized image data: " + path);
+        }
+
+        if (target == null || target.getWidth() != width || target.getHeight() != height
+            || !target.isMutable() || target.getConfig() != Bitmap.Config.ARGB_8888) {
+            target = pool != null ? pool.acquire(width, height)
+                                  : Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        }
+
+        boolean splittable = "image/jpeg".equals(bounds.outMimeType) || "image/webp".equals(bounds.outMimeType);
+        int strips = Math.min(threads, height / MIN_STRIP_ROWS);
+        boolean parallel = splittable && strips > 1 && (long) width * height >= Constants.LARGE_IMAGE_PIXEL_THRESHOLD;
+        if (parallel) {
+            decodeStrips(assets, path, target, strips);
+        } else {
+            decodeWhole(assets, path, target);
+        }
+        Log.d(TAG, String.format("%s: decoded %dx%d %s in %d ms (%s)", path, width, height, bounds.outMimeType,
+                                 System.currentTimeMillis() - start, parallel ? strips + " strips" : "single pass"));
+        return target;
+    }
+
+    /**
+     * 只解碼指定區域到target（例如分塊處理的輸入暫存），target尺寸需等於區域大小
+     */
+    public static Bitmap decodeRegion(BitmapRegionDecoder decoder, Rect region, Bitmap target) {
+        BitmapFactory.Options options = new BitmapFactory.Options();
+        options.inPreferredConfig = Bitmap.Config.ARGB_8888;
+        options.inBitmap = target;
+        return decoder.decodeRegion(region, options);
+    }
+
+    private static void decodeWhole(AssetManager assets, String path, Bitmap target) throws IOException {
+        BitmapFactory.Options options = new BitmapFactory.Options();
+        options.inPreferredConfig = Bitmap.Config.ARGB_8888;
+        options.inMutable = true;
+        options.inBitmap = target;
+        Bitmap decoded;
+        try (InputStream in = assets.open(path)) {
+            decoded = BitmapFactory.decodeStream(in, null, options);
+        }
+        if (decoded == null) {
+            throw new IOException("Decode failed: " + path);
+        }
+    }
+
+    private void decodeStrips(AssetManager assets, String path, Bitmap target, int strips) throws IOException {
+        int width = target.getWidth();
+        int height = target.getHeight();
+        int stripHeight = (height + strips - 1) / strips;
+
+        // 每個工作有自己的 region decoder，彼此不共用解碼狀態
+        List<Future<?>> futures = new ArrayList<>(strips);
+        for (int i = 0; i < strips; i++) {
+            int top = i * stripHeight;
+            int bottom = Math.min(height, top + stripHeight);
+            if (top >= bottom) {
+                break;
+            }
+            futures.add(getExecutor(threads).submit(() -> {
+                decodeStrip(assets, path, target, new Rect(0, top, width, bottom));
+                return null;
+            }));
+        }
+
+        IOException failure = null;
+        for (Future<?> future : futures) {
+            try {
+                future.get();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                failure = new IOException("Interrupted while decoding", e);
+            } catch (ExecutionException e) {
+                failure = new IOException("Strip decode failed", e.getCause());
+            }
+        }
+        // 等全部strip結束才回報，避免失敗後仍有工作寫入target
+        if (failure != null) {
+            throw failure;
+        }
+    }
+
+    private void decodeStrip(AssetManager assets, String path, Bitmap target, Rect rect) throws IOException {
+        Bitmap strip = pool != null ? pool.acquire(rect.width(), rect.height()) : null;
+        try (InputStream in = assets.open(path)) {
+            BitmapRegionDecoder decoder = newRegionDecoder(in);
+            Bitmap decoded;
+            try {
+                decoded = decodeRegion(decoder, rect, strip);
+            } finally {
+                decoder.recycle();
+            }
+            if (decoded == null) {
+                throw new IOException("Region decode failed for " + rect);
+            }
+            if (decoded != strip) {
+                // 沒有池或 inBitmap 不適用時由解碼器配置
+                if (pool != null) {
+                    pool.release(strip);
+                }
+                strip = decoded;
+            }
+            copyRows(strip, target, rect.top);
+        } finally {
+            if (pool != null) {
+                pool.release(strip);
+            } else if (strip != null) {
+                strip.recycle();
+            }
+        }
+    }
+
+    /**
+     * 以每執行緒重用的緩衝分批把strip複製到target的 top 列起；各strip寫入target上不重疊的列
+     */
+    private static void copyRows(Bitmap strip, Bitmap target, int top) {
+        int width = strip.getWidth();
+        int height = strip.getHeight();
+        int[] buffer = copyBuffer.get();
+        if (buffer == null || buffer.length < width * COPY_ROWS) {
+            buffer = new int[width * COPY_ROWS];
+            copyBuffer.set(buffer);
+        }
+        for (int y = 0; y < height; y += COPY_ROWS) {
+            int rows = Math.min(COPY_ROWS, height - y);
+            strip.getPixels(buffer, 0, width, 0, y, width, rows);
+            target.setPixels(buffer, 0, width, 0, top + y, width, rows);
+        }
+    }
+
+    @SuppressWarnings("deprecation")
+    private static BitmapRegionDecoder newRegionDecoder(InputStream in) throws IOException {
+        BitmapRegionDecoder decoder = Build.VERSION.SDK_INT >= Build.VERSION_CODES.S
+            ? BitmapRegionDecoder.newInstance(in)
+            : BitmapRegionDecoder.newInstance(in, false);
+        if (decoder == null) {
+            throw new IOException("Unsupported image for region decoding");
+        }
+        return decoder;
+    }
+}
@@ -0,0 +1,342 @@
+package com.example.sr_poc.processing;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.ArrayDeque;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.zip.Adler32;
+import java.util.zip.CRC32;
+import java.util.zip.Deflater;
+
+/**
+ * 平行 PNG 編碼：輸出依列切成 strip，各 strip 在執行緒池中獨立做 filter + deflate，
+ * 非最後一段以 SYNC_FLUSH 結尾使位元組對齊，依序串接成單一 zlib 串流（adler32 以 combine 合併），
+ * 每段寫成一個 IDAT chunk。列可以分批串流寫入（例如分塊處理每完成一排tile）。
+ * 不依賴 Android API。
+ */
+public final class ParallelPngEncoder {
+
+    private static final byte[] SIGNATURE = {(byte) 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    private static final int ADLER_BASE = 65521;
+    private static final int FILTER_PAETH = 4;
+
+    private final OutputStream out;
+    private final int width;
+    private final int height;
+    private final boolean alpha;
+    private final int bytesPerPixel;
+    private final ExecutorService executor;
+    private final int level;
+    private final int stripRows;
+    private final int maxInFlight;
+    private final ArrayDeque<Future<Strip>> pending = new ArrayDeque<>();
+
+    private int rowsSubmitted;
+    private int[] previousRow; // 上一段的最後一列，供 Paeth filter 使用
+    private long adler = 1;
+    private boolean headerWritten;
+    private boolean finished;
+
+    // 各階段耗時（filter/deflate 為所有執行緒的累計CPU時間）
+    private final AtomicLong filterNanos = new AtomicLong();
+    private final AtomicLong deflateNanos = new AtomicLong();
+    private long writeNanos;
+    private long waitNanos;
+    private long startNanos;
+    private long totalNanos;
+    private long compressedBytes;
+    private int stripCount;
+
+    private static final class Strip {
+        final byte[] data;
+        final int length;
+        final long adler;
+        final long rawLength;
+
+        Strip(byte[] data, int length, long adler, long rawLength) {
+            this.data = data;
+            this.length = length;
+            this.adler = adler;
+            this.rawLength = rawLength;
+        }
+    }
+
+    /**
+     * @param stripRows 每個平行壓縮單位的列數
+     * @param maxInFlight 同時在壓縮中的 strip 上限（控制記憶體）
+     */
+    public ParallelPngEncoder(OutputStream out, int width, int height, boolean alpha,
+                              ExecutorService executor, int level, int stripRows, int maxInFlight) {
+        if (width <= 0 || height <= 0) {
+            throw new IllegalArgumentException("Invalid size " + width + "x" + height);
+        }
+        this.out = out;
+        this.width = width;
+        this.height = height;
+        this.alpha = alpha;
+        this.bytesPerPixel = alpha ? 4 : 3;
+        this.executor = executor;
+        this.level = level;
+        this.stripRows = Math.max(1, stripRows);
+        this.maxInFlight = Math.max(1, maxInFlight);
+    }
+
+    /**
+     * 依序加入下一批列（ARGB，非預乘）。pixels 的所有權轉移給編碼器，呼叫後不可再修改。
+     */
+    public void writeRows(int[] pixels, int rowCount) throws IOException {
+        if (finished) {
+            throw new IllegalStateException("Encoder already finished");
+        }
+        if (rowsSubmitted + rowCount > height) {
+            throw new IllegalArgumentException("Too many rows: " + (rowsSubmitted + rowCount) + " > " + height);
+        }
+        if (!headerWritten) {
+            startNanos = System.nanoTime();
+            writeHeader();
+            headerWritten = true;
+        }
+
+        for (int first = 0; first < rowCount; first += stripRows) {
+            int rows = Math.min(stripRows, rowCount - first);
+            int offset = first * width;
+            int[] abovePixels = first == 0 ? previousRow : pixels;
+            int aboveOffset = first == 0 ? 0 : offset - width;
+            boolean last = rowsSubmitted + rows == height;
+
+            pending.add(executor.submit(() -> compressStrip(pixels, offset, rows, abovePixels, aboveOffset, last)));
+            rowsSubmitted += rows;
+            stripCount++;
+
+            while (pending.size() > maxInFlight) {
+                writeStrip(pending.poll());
+            }
+        }
+
+        // 保留最後一列的副本，下一批的第一列需要它
+        previousRow = new int[width];
+        System.arraycopy(pixels, (rowCount - 1) * width, previousRow, 0, width);
+    }
+
+    /**
+     * 等待剩餘的 strip、寫出 zlib trailer 與 IEND
+     */
+    public void finish() throws IOException {
+        if (finished) {
+            return;
+        }
+        if (rowsSubmitted != height) {
+            throw new IllegalStateException("Only " + rowsSubmitted + " of " + height + " rows written");
+        }
+        while (!pending.isEmpty()) {
+            writeStrip(pending.poll());
+        }
+
+        long start = System.nanoTime();
+        byte[] trailer = {
+            (byte) (adler >>> 24), (byte) (adler >>> 16), (byte) (adler >>> 8), (byte) adler
+        };
+        writeChunk("IDAT", trailer, 0, trailer.length);
+        writeChunk("IEND", new byte[0], 0, 0);
+        out.flush();
+        writeNanos += System.nanoTime() - start;
+
+        finished = true;
+        totalNanos = System.nanoTime() - startNanos;
+    }
+
+    /**
+     * 取消尚未完成的壓縮工作（失敗或中止時使用）
+     */
+    public void abort() {
+        for (Future<Strip> future : pending) {
+            future.cancel(true);
+        }
+        pending.clear();
+        finished = true;
+    }
+
+    public long getCompressedBytes() {
+        return compressedBytes;
+    }
+
+    /**
+     * Per-stage timing summary
+     */
+    public String getReport() {
+        return String.format("PNG %dx%d%s: %d strips, filter %.1f ms cpu, deflate %.1f ms cpu, "
+                             + "wait %.1f ms, write %.1f ms, wall %.1f ms, %d KB",
+                             width, height, alpha ? " RGBA" : " RGB", stripCount,
+                             filterNanos.get() / 1e6, deflateNanos.get() / 1e6,
+                             waitNanos / 1e6, writeNanos / 1e6, totalNanos / 1e6, compressedBytes / 1024);
+    }
+
+    private void writeHeader() throws IOException {
+        out.write(SIGNATURE);
+        byte[] ihdr = new byte[13];
+        putInt(ihdr, 0, width);
+        putInt(ihdr, 4, height);
+        ihdr[8] = 8;                       // bit depth
+        ihdr[9] = (byte) (alpha ? 6 : 2);  // color type RGBA / RGB
+        ihdr[10] = 0;                      // deflate
+        ihdr[11] = 0;                      // adaptive filtering
+        ihdr[12] = 0;                      // no interlace
+        writeChunk("IHDR", ihdr, 0, ihdr.length);
+
+        // zlib header (CMF/FLG)，deflate 資料由各 strip 接續
+        byte[] zlibHeader = {0x78, (byte) 0x9C};
+        writeChunk("IDAT", zlibHeader, 0, zlibHeader.length);
+    }
+
+    private void writeStrip(Future<Strip> future) throws IOException {
+        Strip strip;
+        long waitStart = System.nanoTime();
+        try {
+            strip = future.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Interrupted while encoding", e);
+        } catch (ExecutionException e) {
+            throw new IOException("Strip compression failed", e.getCause());
+        }
+        long writeStart = System.nanoTime();
+        waitNanos += writeStart - waitStart;
+
+        writeChunk("IDAT", strip.data, 0, strip.length);
+        adler = adler32Combine(adler, strip.adler, strip.rawLength);
+        compressedBytes += strip.length;
+        writeNanos += System.nanoTime() - writeStart;
+    }
+
+    private Strip compressStrip(int[] pixels, int offset, int rows, int[] above, int aboveOffset, boolean last) {
+        long start = System.nanoTime();
+        int rowBytes = width * bytesPerPixel;
+        byte[] raw = new byte[rows * (rowBytes + 1)];
+        byte[] previous = new byte[rowBytes];
+        byte[] current = new byte[rowBytes];
+
+        if (above != null) {
+            unpackRow(above, aboveOffset, previous);
+        }
+        // 影像第一列之上視為全0，與PNG規範一致
+        for (int r = 0; r < rows; r++) {
+            unpackRow(pixels, offset + r * width, current);
+            int base = r * (rowBytes + 1);
+            raw[base] = FILTER_PAETH;
+            paethFilter(current, previous, raw, base + 1);
+            byte[] swap = previous;
+            previous = current;
+            current = swap;
+        }
+
+        Adler32 checksum = new Adler32();
+        checksum.update(raw, 0, raw.length);
+        long filtered = System.nanoTime();
+        filterNanos.addAndGet(filtered - start);
+
+        Deflater deflater = new Deflater(level, true);
+        try {
+            deflater.setInput(raw);
+            byte[] buffer = new byte[Math.max(1024, raw.length / 2)];
+            int length = 0;
+            if (last) {
+                deflater.finish();
+                while (!deflater.finished()) {
+                    if (length == buffer.length) buffer = grow(buffer);
+                    length += deflater.deflate(buffer, length, buffer.length - length);
+                }
+            } else {
+                // SYNC_FLUSH：輸出位元組對齊且不含final block，可與下一段直接串接
+                while (true) {
+                    if (length == buffer.length) buffer = grow(buffer);
+                    int n = deflater.deflate(buffer, length, buffer.length - length, Deflater.SYNC_FLUSH);
+                    length += n;
+                    if (length < buffer.length) {
+                        break;
+                    }
+                }
+            }
+            deflateNanos.addAndGet(System.nanoTime() - filtered);
+            return new Strip(buffer, length, checksum.getValue(), raw.length);
+        } finally {
+            deflater.end();
+        }
+    }
+
+    private void unpackRow(int[] pixels, int offset, byte[] row) {
+        int p = 0;
+        for (int x = 0; x < width; x++) {
+            int argb = pixels[offset + x];
+            row[p++] = (byte) (argb >> 16);
+            row[p++] = (byte) (argb >> 8);
+            row[p++] = (byte) argb;
+            if (alpha) {
+                row[p++] = (byte) (argb >>> 24);
+            }
+        }
+    }
+
+    private void paethFilter(byte[] current, byte[] previous, byte[] dst, int dstOffset) {
+        int length = current.length;
+        for (int i = 0; i < length; i++) {
+            int a = i >= bytesPerPixel ? current[i - bytesPerPixel] & 0xFF : 0;
+            int b = previous[i] & 0xFF;
+            int c = i >= bytesPerPixel ? previous[i - bytesPerPixel] & 0xFF : 0;
+            int p = a + b - c;
+            int pa = Math.abs(p - a);
+            int pb = Math.abs(p - b);
+            int pc = Math.abs(p - c);
+            int predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+            dst[dstOffset + i] = (byte) ((current[i] & 0xFF) - predictor);
+        }
+    }
+
+    private void writeChunk(String type, byte[] data, int offset, int length) throws IOException {
+        byte[] header = new byte[8];
+        putInt(header, 0, length);
+        for (int i = 0; i < 4; i++) {
+            header[4 + i] = (byte) type.charAt(i);
+        }
+        CRC32 crc = new CRC32();
+        crc.update(header, 4, 4);
+        crc.update(data, offset, length);
+
+        out.write(header);
+        out.write(data, offset, length);
+        byte[] crcBytes = new byte[4];
+        putInt(crcBytes, 0, (int) crc.getValue());
+        out.write(crcBytes);
+    }
+
+    private static byte[] grow(byte[] buffer) {
+        byte[] larger = new byte[buffer.length * 2];
+        System.arraycopy(buffer, 0, larger, 0, buffer.length);
+        return larger;
+    }
+
+    private static void putInt(byte[] dst, int offset, int value) {
+        dst[offset] = (byte) (value >>> 24);
+        dst[offset + 1] = (byte) (value >>> 16);
+        dst[offset + 2] = (byte) (value >>> 8);
+        dst[offset + 3] = (byte) value;
+    }
+
+    /**
+     * adler32(A || B) from adler32(A), adler32(B) and len(B), as in zlib's adler32_combine
+     */
+    static long adler32Combine(long adler1, long adler2, long length2) {
+        long remainder = length2 % ADLER_BASE;
+        long sum1 = adler1 & 0xFFFF;
+        long sum2 = (remainder * sum1) % ADLER_BASE;
+        sum1 += (adler2 & 0xFFFF) + ADLER_BASE - 1;
+        sum2 += ((adler1 >>> 16) & 0xFFFF) + ((adler2 >>> 16) & 0xFFFF) + ADLER_BASE - remainder;
+        if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+        if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+        if (sum2 >= ((long) ADLER_BASE << 1)) sum2 -= ((long) ADLER_BASE << 1);
+        if (sum2 >= ADLER_BASE) sum2 -= ADLER_BASE;
+        return (sum2 << 16) | sum1;
+    }
+}
@@ -0,0 +1,264 @@
+package com.example.sr_poc.processing;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+
+/**
+ * SR 後處理鏈：在輸出轉換 kernel 內逐列融合執行，不額外掃描整張圖。
+ * 所有運算在 [0,1] 的 RGB float 列上進行，最後由 kernel 量化成 ARGB。
+ * 最多一個 3x3 stencil（先執行），之後依序執行逐像素運算，dither 永遠在最後。
+ */
+public final class PostProcessChain {
+
+    public static final PostProcessChain EMPTY = new Builder().build();
+
+    /**
+     * Per-pixel op applied in place on an interleaved RGB row;
+     * (x0, y) is the row's first pixel in final output coordinates
+     */
+    public interface PointOp {
+        void applyRow(float[] rgb, int width, int x0, int y);
+
+        /**
+         * 用於結果快取的指紋；自訂運算有參數時應覆寫並包含所有參數
+         */
+        default String describe() {
+            return getClass().getName();
+        }
+    }
+
+    /**
+     * 3x3 stencil op reading three source rows and writing one output row
+     */
+    public interface StencilOp {
+        void applyRow(float[] above, float[] center, float[] below, float[] out, int width);
+
+        /**
+         * 用於結果快取的指紋；自訂運算有參數時應覆寫並包含所有參數
+         */
+        default String describe() {
+            return getClass().getName();
+        }
+    }
+
+    private final StencilOp stencil;
+    private final PointOp[] pointOps;
+    private final boolean dithered;
+
+    private PostProcessChain(StencilOp stencil, List<PointOp> pointOps, boolean dithered) {
+        this.stencil = stencil;
+        this.pointOps = pointOps.toArray(new PointOp[0]);
+        this.dithered = dithered;
+    }
+
+    public boolean isEmpty() {
+        return stencil == null && pointOps.length == 0;
+    }
+
+    public StencilOp getStencil() {
+        return stencil;
+    }
+
+    public boolean hasStencil() {
+        return stencil != null;
+    }
+
+    /**
+     * 最後一步為 dither 時，門檻本身即是量化前的捨入偏移，kernel 不再另加
+     */
+    public boolean isDithered() {
+        return dithered;
+    }
+
+    /**
+     * Run every point op on one row starting at output pixel (x0, y)
+     */
+    public void applyPointOps(float[] rgb, int width, int x0, int y) {
+        for (PointOp op : pointOps) {
+            op.applyRow(rgb, width, x0, y);
+        }
+    }
+
+    public int getOpCount() {
+        return pointOps.length + (stencil != null ? 1 : 0);
+    }
+
+    /**
+     * 依執行順序列出各運算與參數，例如 "sharpen(0.5000),gamma(2.2000),dither"；空鏈為 "none"
+     */
+    public String describe() {
+        if (isEmpty()) {
+            return "none";
+        }
+        StringBuilder builder = new StringBuilder();
+        if (stencil != null) {
+            builder.append(stencil.describe());
+        }
+        for (PointOp op : pointOps) {
+            if (builder.length() > 0) {
+                builder.append(',');
+            }
+            builder.append(op.describe());
+        }
+        return builder.toString();
+    }
+
+    public static final class Builder {
+        private StencilOp stencil;
+        private final List<PointOp> pointOps = new ArrayList<>();
+        private PointOp dither;
+
+        public Builder stencil(StencilOp op) {
+            if (stencil != null) {
+                throw new IllegalStateException("Only one stencil op can be fused into the output pass");
+            }
+            stencil = op;
+            return this;
+        }
+
+        public Builder add(PointOp op) {
+            pointOps.add(op);
+            return this;
+        }
+
+        public Builder sharpen(float amount) {
+            return amount > 0f ? stencil(new SharpenOp(amount)) : this;
+        }
+
+        public Builder gamma(float gamma) {
+            return (gamma > 0f && gamma != 1f) ? add(CurveOp.gamma(gamma)) : this;
+        }
+
+        public Builder srgbEncode() {
+            return add(CurveOp.srgbEncode());
+        }
+
+        public Builder dither() {
+            dither = new BayerDitherOp();
+            return this;
+        }
+
+        public PostProcessChain build() {
+            List<PointOp> ops = new ArrayList<>(pointOps);
+            if (dither != null) {
+                ops.add(dither);
+            }
+            return new PostProcessChain(stencil, Collections.unmodifiableList(ops), dither != null);
+        }
+    }
+
+    // ---- Built-in ops ----
+
+    /**
+     * Unsharp mask using the 4-neighbour average as the blurred estimate
+     */
+    public static final class SharpenOp implements StencilOp {
+        private final float amount;
+
+        public SharpenOp(float amount) {
+            this.amount = amount;
+        }
+
+        @Override
+        public void applyRow(float[] above, float[] center, float[] below, float[] out, int width) {
+            int last = (width - 1) * 3;
+            for (int i = 0; i < width * 3; i++) {
+                int left = i >= 3 ? i - 3 : i;
+                int right = i < last ? i + 3 : i;
+                float c = center[i];
+                float blur = (above[i] + below[i] + center[left] + center[right]) * 0.25f;
+                out[i] = c + amount * (c - blur);
+            }
+        }
+
+        @Override
+        public String describe() {
+            return String.format(Locale.US, "sharpen(%.4f)", amount);
+        }
+    }
+
+    /**
+     * Transfer curve evaluated through a lookup table with linear interpolation
+     */
+    public static final class CurveOp implements PointOp {
+        private static final int LUT_SIZE = 1024;
+
+        private final float[] lut = new float[LUT_SIZE + 1];
+        private final String name;
+
+        private CurveOp(String name, Curve curve) {
+            this.name = name;
+            for (int i = 0; i <= LUT_SIZE; i++) {
+                lut[i] = (float) curve.apply((double) i / LUT_SIZE);
+            }
+        }
+
+        interface Curve {
+            double apply(double v);
+        }
+
+        public static CurveOp gamma(float gamma) {
+            final double exponent = 1.0 / gamma;
+            return new CurveOp(String.format(Locale.US, "gamma(%.4f)", gamma), v -> Math.pow(v, exponent));
+        }
+
+        public static CurveOp srgbEncode() {
+            return new CurveOp("srgb", v -> v <= 0.0031308 ? v * 12.92 : 1.055 * Math.pow(v, 1.0 / 2.4) - 0.055);
+        }
+
+        @Override
+        public void applyRow(float[] rgb, int width, int x0, int y) {
+            for (int i = 0; i < width * 3; i++) {
+                float v = rgb[i];
+                if (v <= 0f) {
+                    rgb[i] = lut[0];
+                } else if (v >= 1f) {
+                    rgb[i] = lut[LUT_SIZE];
+                } else {
+                    float pos = v * LUT_SIZE;
+                    int idx = (int) pos;
+                    float frac = pos - idx;
+                    rgb[i] = lut[idx] + (lut[idx + 1] - lut[idx]) * frac;
+                }
+            }
+        }
+
+        @Override
+        public String describe() {
+            return name;
+        }
+    }
+
+    /**
+     * 4x4 ordered dither; adds a sub-LSB threshold (mean 0.5 LSB) before the kernel truncates to 8 bits.
+     * The pattern is anchored to output coordinates so tiles and bands line up without seams.
+     */
+    public static final class BayerDitherOp implements PointOp {
+        private static final float[] THRESHOLDS = new float[16];
+
+        static {
+            int[] bayer = {0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5};
+            for (int i = 0; i < 16; i++) {
+                THRESHOLDS[i] = (bayer[i] + 0.5f) / 16f / 255f;
+            }
+        }
+
+        @Override
+        public void applyRow(float[] rgb, int width, int x0, int y) {
+            int rowBase = (y & 3) * 4;
+            for (int x = x0, i = 0; x < x0 + width; x++, i += 3) {
+                float t = THRESHOLDS[rowBase + (x & 3)];
+                rgb[i] += t;
+                rgb[i + 1] += t;
+                rgb[i + 2] += t;
+            }
+        }
+
+        @Override
+        public String describe() {
+            return "dither";
+        }
+    }
+}
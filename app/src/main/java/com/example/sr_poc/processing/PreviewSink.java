@@ -0,0 +1,47 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+
+import com.example.sr_poc.TileProcessor;
+
+/**
+ * 輸出大到本程序放不下時，把分塊處理完成的列以整數倍率取樣成預覽圖；
+ * 完整輸出只存在於串流的輸出帶，記憶體與輸出高度無關
+ */
+public final class PreviewSink implements TileProcessor.RowListener {
+
+    private final int width;
+    private final int factor;
+    private final Bitmap preview;
+    private final int[] row;
+    private final int[] sampled;
+
+    public PreviewSink(int width, int height, int factor) {
+        this.width = width;
+        this.factor = factor;
+        this.preview = Bitmap.createBitmap((width + factor - 1) / factor, (height + factor - 1) / factor,
+                                           Bitmap.Config.ARGB_8888);
+        this.row = new int[width];
+        this.sampled = new int[preview.getWidth()];
+    }
+
+    @Override
+    public void onRowsComplete(Bitmap pixels, int sourceTop, int top, int bottom) {
+        int first = (top + factor - 1) / factor * factor;
+        for (int y = first; y < bottom; y += factor) {
+            pixels.getPixels(row, 0, width, 0, sourceTop + (y - top), width, 1);
+            for (int x = 0; x < sampled.length; x++) {
+                sampled[x] = row[x * factor];
+            }
+            preview.setPixels(sampled, 0, sampled.length, 0, y / factor, sampled.length, 1);
+        }
+    }
+
+    public int getFactor() {
+        return factor;
+    }
+
+    public Bitmap getPreview() {
+        return preview;
+    }
+}
@@ -3,12 +3,26 @@ package com.example.sr_poc.processing;
 import android.graphics.Bitmap;
 import android.util.Log;
 
+import com.example.sr_poc.AtlasProcessor;
 import com.example.sr_poc.ConfigManager;
 import com.example.sr_poc.ImageManager;
 import com.example.sr_poc.PerformanceMonitor;
 import com.example.sr_poc.ThreadSafeSRProcessor;
 import com.example.sr_poc.TileProcessor;
+import com.example.sr_poc.utils.EnergyMeter;
+import com.example.sr_poc.utils.MemorySampler;
 import com.example.sr_poc.utils.MemoryUtils;
+import com.example.sr_poc.utils.MetricsRegistry;
+import com.example.sr_poc.utils.StageTrace;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicBoolean;
 
 public class ProcessingController {
     
@@ -17,6 +31,15 @@ public class ProcessingController {
     private final ThreadSafeSRProcessor srProcessor;
     private final ConfigManager configManager;
     private final ImageManager imageManager;
+    private SpeculativeScheduler speculativeScheduler;
+    private ResultStore resultStore;
+    private TileWorkerPool workerPool;
+    private EnergyMeter energyMeter;
+    private MemorySampler memorySampler;
+    private TelemetryLog telemetryLog;
+    private WorkloadRecorder workloadRecorder;
+    private File largeResultDirectory;
+    private volatile TileTimings lastTileTimings;
     
     public interface ProcessingCallback {
         void onStart();
@@ -24,6 +47,26 @@ public class ProcessingController {
         void onSuccess(Bitmap resultBitmap, String timeMessage);
         void onError(String error);
         void onComplete();
+        
+        /**
+         * 輸出超過本程序heap時呼叫，取代 onSuccess：完整結果已串流寫成 fullResult（PNG，所有權轉移給呼叫端），
+         * preview 只是 1/factor 的取樣預覽。預設把預覽當成結果交給 onSuccess 並刪除檔案
+         */
+        default void onPreviewSuccess(Bitmap preview, int factor, File fullResult, String timeMessage) {
+            fullResult.delete();
+            onSuccess(preview, timeMessage);
+        }
+    }
+    
+    public interface BatchProcessingCallback {
+        void onSuccess(List<Bitmap> resultBitmaps, String timeMessage);
+        void onError(String error);
+    }
+    
+    public interface FileProcessingCallback {
+        void onProgress(String message);
+        void onSuccess(File outputFile, String timeMessage);
+        void onError(String error);
     }
     
     public ProcessingController(ThreadSafeSRProcessor srProcessor, ConfigManager configManager, ImageManager imageManager) {
@@ -33,59 +76,492 @@ public class ProcessingController {
     }
     
     public void processImage(ThreadSafeSRProcessor.ProcessingMode mode, boolean forceTiling, ProcessingCallback callback) {
+        processImage(mode, forceTiling, 0, 0, callback);
+    }
+    
+    /**
+     * 以指定輸出尺寸處理（0x0表示依配置的target_scale，未配置則使用模型倍率）
+     */
+    public void processImage(ThreadSafeSRProcessor.ProcessingMode mode, boolean forceTiling,
+                             int targetWidth, int targetHeight, ProcessingCallback callback) {
+        processBitmap(imageManager.getCurrentBitmap(), mode, forceTiling, targetWidth, targetHeight, callback);
+    }
+    
+    /**
+     * 處理指定的輸入（回放擷取的請求序列時使用），流程與processImage相同
+     */
+    public void processBitmap(Bitmap currentBitmap, ThreadSafeSRProcessor.ProcessingMode mode, boolean forceTiling,
+                              int targetWidth, int targetHeight, ProcessingCallback callback) {
         new Thread(() -> {
+            EnergyMeter.Measurement energy = null;
+            MemorySampler.Session memory = null;
+            boolean started = false;
+            PerformanceMonitor.InferenceStats stats = null;
+            Bitmap resultBitmap = null;
+            long startTime = 0;
             try {
                 callback.onStart();
                 
-                Bitmap currentBitmap = imageManager.getCurrentBitmap();
                 if (currentBitmap == null) {
                     callback.onError("No image loaded");
                     return;
                 }
+                if (workloadRecorder != null) {
+                    // 結果儲存稍後查詢時沿用同一個快取的雜湊
+                    String inputHash = resultStore != null ? resultStore.contentHash(currentBitmap) : null;
+                    workloadRecorder.record(currentBitmap, inputHash, mode, forceTiling, targetWidth, targetHeight);
+                }
                 
                 // Check memory before processing
                 MemoryUtils.logMemoryWarningIfNeeded();
                 
                 // Create performance stats
-                PerformanceMonitor.InferenceStats stats = createPerformanceStats(currentBitmap, mode);
+                stats = createPerformanceStats(currentBitmap, mode);
                 
-                long startTime = System.currentTimeMillis();
-                Bitmap resultBitmap;
+                startTime = System.currentTimeMillis();
+                energy = energyMeter != null ? energyMeter.begin() : null;
+                StageTrace trace = new StageTrace();
+                stats.stageTrace = trace;
+                memory = memorySampler != null ? memorySampler.begin(trace) : null;
+                MetricsRegistry.get().jobStarted(trace);
+                started = true;
+                trace.mark("lookup");
                 
                 // Determine processing method
-                boolean shouldUseTiling = forceTiling || 
-                    TileProcessor.shouldUseTileProcessing(currentBitmap, configManager);
-                
+                boolean shouldUseTiling = shouldUseTiling(currentBitmap, forceTiling);
+                stats.usedTileProcessing = shouldUseTiling;
                 if (shouldUseTiling) {
-                    callback.onProgress("Using tile processing for large image");
-                    resultBitmap = processByTiles(currentBitmap, mode, callback);
-                    stats.usedTileProcessing = true;
-                } else {
-                    callback.onProgress("Using direct processing");
-                    resultBitmap = processDirect(currentBitmap, mode);
-                    stats.usedTileProcessing = false;
+                    stats.tileSize = Math.min(srProcessor.getModelInputWidth(), srProcessor.getModelInputHeight());
+                    // 網格只取決於輸入尺寸、tile邊長與overlap，與倍率無關
+                    TilePlan plan = new TilePlan(currentBitmap.getWidth(), currentBitmap.getHeight(),
+                                                 stats.tileSize, configManager.getOverlapPixels(), 1);
+                    stats.tilesX = plan.getTilesX();
+                    stats.tilesY = plan.getTilesY();
+                }
+                
+                // 先查詢已儲存的結果：命中時只需解碼
+                File fullResult = null;
+                String storeKey = null;
+                if (resultStore != null) {
+                    ThreadSafeSRProcessor.ProcessingMode resolvedMode = mode != null ? mode : srProcessor.getCurrentMode();
+                    storeKey = resultStore.keyFor(currentBitmap, resolvedMode, shouldUseTiling, targetWidth, targetHeight,
+                                                  srProcessor.getPostProcessChain());
+                    resultBitmap = resultStore.get(storeKey);
+                    if (resultBitmap != null) {
+                        callback.onProgress("Loaded stored result");
+                        if (speculativeScheduler != null) {
+                            speculativeScheduler.cancel();
+                        }
+                    }
+                }
+                boolean fromStore = resultBitmap != null;
+                stats.resultSource = fromStore ? "store" : "render";
+                
+                // 背景預先處理的結果若條件相符則直接接手（進行中則提升優先權並等待）
+                if (resultBitmap == null && speculativeScheduler != null) {
+                    resultBitmap = speculativeScheduler.claim(currentBitmap, mode, shouldUseTiling,
+                                                              targetWidth, targetHeight);
+                    if (resultBitmap != null) {
+                        stats.resultSource = "speculative";
+                        callback.onProgress("Using speculative result");
+                    }
+                }
+                
+                if (resultBitmap == null) {
+                    trace.mark("render");
+                    callback.onProgress(shouldUseTiling ? "Using tile processing for large image"
+                                                        : "Using direct processing");
+                    int previewFactor = shouldUseTiling ? previewFactor(currentBitmap, targetWidth, targetHeight) : 1;
+                    if (previewFactor > 1) {
+                        callback.onProgress("Output exceeds heap, streaming tiles to file with 1/" + previewFactor
+                                            + " preview");
+                        fullResult = newLargeResultFile();
+                        resultBitmap = renderPreview(currentBitmap, mode, targetWidth, targetHeight, previewFactor,
+                                                     fullResult, callback);
+                        if (resultBitmap != null) {
+                            stats.previewFactor = previewFactor;
+                            int[] outputSize = outputSize(currentBitmap.getWidth(), currentBitmap.getHeight(),
+                                                          resolveTargetSize(currentBitmap, targetWidth, targetHeight));
+                            stats.outputWidth = outputSize[0];
+                            stats.outputHeight = outputSize[1];
+                        }
+                        // 預覽不是完整結果，不寫入store（store命中時會整張解碼）
+                        storeKey = null;
+                    } else {
+                        // 分塊處理時邊產生邊編碼寫入store，不必等全圖完成
+                        ResultStore.StreamingWrite streamingWrite = storeKey != null && shouldUseTiling
+                            ? resultStore.beginStreamingWrite(storeKey) : null;
+                        resultBitmap = render(currentBitmap, mode, shouldUseTiling, targetWidth, targetHeight, null,
+                                              streamingWrite != null ? streamingWrite.getRowListener() : null,
+                                              callback);
+                        if (streamingWrite != null) {
+                            if (resultBitmap != null) {
+                                streamingWrite.commit();
+                            } else {
+                                streamingWrite.abort();
+                            }
+                            storeKey = null;
+                        }
+                    }
+                }
+                
+                if (resultBitmap != null && storeKey != null && !fromStore) {
+                    trace.mark("store");
+                    resultStore.put(storeKey, resultBitmap);
                 }
                 
                 long endTime = System.currentTimeMillis();
-                completeProcessing(stats, resultBitmap, endTime - startTime, callback);
+                trace.finish();
+                if (energy != null) {
+                    EnergyMeter.Energy used = energy.end();
+                    stats.energyJoules = used.isValid() ? used.joules : -1;
+                }
+                if (memory != null) {
+                    stats.memoryReport = memory.end();
+                }
+                completeProcessing(stats, resultBitmap, fullResult, endTime - startTime, callback);
                 
             } catch (OutOfMemoryError e) {
                 Log.e(TAG, "Out of memory error", e);
+                if (stats != null) {
+                    stats.status = "oom";
+                    stats.error = String.valueOf(e.getMessage());
+                }
                 callback.onError("Out of memory! Try closing other apps.");
             } catch (Exception e) {
                 Log.e(TAG, "Exception during processing", e);
+                if (stats != null) {
+                    stats.status = "error";
+                    stats.error = e.getClass().getSimpleName() + ": " + e.getMessage();
+                }
                 callback.onError("Error: " + e.getClass().getSimpleName());
             } finally {
+                if (energy != null) {
+                    energy.end();
+                }
+                if (memory != null) {
+                    MemorySampler.Report report = memory.end();
+                    if (stats != null && stats.memoryReport == null) {
+                        stats.memoryReport = report;
+                    }
+                }
+                if (started) {
+                    MetricsRegistry.get().jobFinished();
+                }
+                // 成功與失敗的工作都留下一筆紀錄
+                if (stats != null && telemetryLog != null) {
+                    if (stats.inferenceTime == 0) {
+                        stats.inferenceTime = System.currentTimeMillis() - startTime;
+                    }
+                    telemetryLog.record(stats, resultBitmap);
+                }
                 callback.onComplete();
             }
         }).start();
     }
     
+    /**
+     * 處理一組小圖（縮圖、圖示）；啟用atlas時多張圖共用一次推理。
+     * 結果與輸入順序相同，每張輸出為原尺寸乘以模型倍率，失敗項目為null。
+     */
+    public void processImages(List<Bitmap> images, ThreadSafeSRProcessor.ProcessingMode mode,
+                              BatchProcessingCallback callback) {
+        new Thread(() -> {
+            try {
+                long startTime = System.currentTimeMillis();
+                List<Bitmap> results;
+                
+                if (configManager.isAtlasEnabled()) {
+                    AtlasProcessor atlasProcessor = new AtlasProcessor(srProcessor, configManager);
+                    atlasProcessor.setProcessingMode(mode);
+                    results = atlasProcessor.process(images);
+                } else {
+                    results = new ArrayList<>(images.size());
+                    for (Bitmap image : images) {
+                        results.add(processDirect(image, mode, new int[] {0, 0}, null));
+                    }
+                }
+                
+                long totalTime = System.currentTimeMillis() - startTime;
+                callback.onSuccess(results, String.format("Processed %d images in %d ms", images.size(), totalTime));
+            } catch (OutOfMemoryError e) {
+                Log.e(TAG, "Out of memory error", e);
+                callback.onError("Out of memory! Try closing other apps.");
+            } catch (Exception e) {
+                Log.e(TAG, "Exception during batch processing", e);
+                callback.onError("Error: " + e.getClass().getSimpleName());
+            }
+        }).start();
+    }
+    
+    /**
+     * 設定背景預先處理排程器；processImage會先嘗試接手其結果
+     */
+    public void setSpeculativeScheduler(SpeculativeScheduler speculativeScheduler) {
+        this.speculativeScheduler = speculativeScheduler;
+    }
+    
+    /**
+     * 設定持久化結果儲存；processImage會在推理前先查詢
+     */
+    public void setResultStore(ResultStore resultStore) {
+        this.resultStore = resultStore;
+    }
+    
+    /**
+     * 設定後分塊處理的tile推理交給worker程序
+     */
+    public void setWorkerPool(TileWorkerPool workerPool) {
+        this.workerPool = workerPool;
+    }
+    
+    /**
+     * 設定後每個工作都量測能耗，回報每百萬輸出像素的焦耳數
+     */
+    public void setEnergyMeter(EnergyMeter energyMeter) {
+        this.energyMeter = energyMeter;
+    }
+    
+    /**
+     * 設定後每個工作都記錄記憶體時間軸，與階段時間一併輸出
+     */
+    public void setMemorySampler(MemorySampler memorySampler) {
+        this.memorySampler = memorySampler;
+    }
+    
+    /**
+     * 設定後每個完成的工作都附加一筆結構化紀錄
+     */
+    public void setTelemetryLog(TelemetryLog telemetryLog) {
+        this.telemetryLog = telemetryLog;
+    }
+    
+    /**
+     * 輸出超過heap時完整結果的存放目錄；未設定時使用 java.io.tmpdir（App 的 cacheDir）
+     */
+    public void setLargeResultDirectory(File largeResultDirectory) {
+        this.largeResultDirectory = largeResultDirectory;
+    }
+    
+    /**
+     * 設定後記錄每個請求的參數與輸入雜湊，供之後回放
+     */
+    public void setWorkloadRecorder(WorkloadRecorder workloadRecorder) {
+        this.workloadRecorder = workloadRecorder;
+    }
+    
+    /**
+     * 此控制器最近一次分塊處理的逐tile耗時（供結果熱圖使用）；未分塊處理時為null
+     */
+    public TileTimings getLastTileTimings() {
+        return lastTileTimings;
+    }
+    
+    public boolean shouldUseTiling(Bitmap bitmap, boolean forceTiling) {
+        if (forceTiling || TileProcessor.shouldUseTileProcessing(bitmap, configManager)) {
+            return true;
+        }
+        // 有worker時推理的記憶體在worker程序：大於一個tile的輸入都分塊交給worker，本程序只需容納輸出
+        return workerPool != null && (bitmap.getWidth() > srProcessor.getModelInputWidth()
+                                      || bitmap.getHeight() > srProcessor.getModelInputHeight());
+    }
+    
+    /**
+     * 有worker時本程序只需配置輸出圖；輸出超過本程序可用heap的門檻時回傳預覽的取樣倍率（大於1），
+     * 此時改走 processToRows 串流，不配置完整輸出圖（預先處理也據此略過這類輸入）
+     */
+    int previewFactor(Bitmap bitmap, int targetWidth, int targetHeight) {
+        if (workerPool == null) {
+            return 1;
+        }
+        int[] outputSize = outputSize(bitmap.getWidth(), bitmap.getHeight(),
+                                      resolveTargetSize(bitmap, targetWidth, targetHeight));
+        long outputBytes = (long) outputSize[0] * outputSize[1] * 4;
+        long budget = (long) (MemoryUtils.getCurrentMemoryInfo().availableMemoryMB * 1024 * 1024
+                              * configManager.getMemoryThresholdPercentage());
+        if (outputBytes <= budget) {
+            return 1;
+        }
+        return Math.max(2, (int) Math.ceil(Math.sqrt((double) outputBytes / Math.max(1, budget))));
+    }
+    
+    /**
+     * 完整輸出逐排編碼寫入 fullResult，同時取樣成預覽；失敗時刪除檔案並回傳null
+     */
+    private Bitmap renderPreview(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, int targetWidth,
+                                 int targetHeight, int factor, File fullResult, ProcessingCallback callback)
+            throws IOException {
+        int[] targetSize = resolveTargetSize(bitmap, targetWidth, targetHeight);
+        int[] outputSize = outputSize(bitmap.getWidth(), bitmap.getHeight(), targetSize);
+        PreviewSink preview = new PreviewSink(outputSize[0], outputSize[1], factor);
+        boolean completed = false;
+        try (OutputStream out = new BufferedOutputStream(new FileOutputStream(fullResult), 256 * 1024)) {
+            ImageEncoder.PngRowSink png = new ImageEncoder.PngRowSink(out, outputSize[1]);
+            TileProcessor.RowListener rows = (pixels, sourceTop, top, bottom) -> {
+                png.onRowsComplete(pixels, sourceTop, top, bottom);
+                preview.onRowsComplete(pixels, sourceTop, top, bottom);
+            };
+            if (streamRows(new BitmapTileSource(bitmap), mode, targetSize, rows, (done, total) ->
+                    callback.onProgress("Processing tiles: " + done + "/" + total))) {
+                png.finish();
+                completed = true;
+            } else {
+                png.abort();
+            }
+        } finally {
+            if (!completed) {
+                preview.getPreview().recycle();
+                fullResult.delete();
+            }
+        }
+        return completed ? preview.getPreview() : null;
+    }
+    
+    private File newLargeResultFile() throws IOException {
+        File directory = largeResultDirectory != null ? largeResultDirectory
+                                                      : new File(System.getProperty("java.io.tmpdir"));
+        if (!directory.isDirectory() && !directory.mkdirs()) {
+            throw new IOException("Failed to create " + directory);
+        }
+        return new File(directory, "sr-" + System.currentTimeMillis() + ".png");
+    }
+    
+    /**
+     * 同步產生超解析度結果（在呼叫端線程等待）。
+     * cancelled不為null時於tile之間檢查，取消則回傳null；callback可為null。
+     */
+    public Bitmap render(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                         int targetWidth, int targetHeight, AtomicBoolean cancelled, ProcessingCallback callback) {
+        return render(bitmap, mode, useTiling, targetWidth, targetHeight, cancelled, null, callback);
+    }
+    
+    /**
+     * rowListener只在分塊處理時使用，每完成一排tile通知已定案的輸出列
+     */
+    public Bitmap render(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                         int targetWidth, int targetHeight, AtomicBoolean cancelled,
+                         TileProcessor.RowListener rowListener, ProcessingCallback callback) {
+        int[] targetSize = resolveTargetSize(bitmap, targetWidth, targetHeight);
+        if (useTiling) {
+            return processByTiles(bitmap, mode, targetSize, cancelled, rowListener, callback, null);
+        }
+        return processDirect(bitmap, mode, targetSize, null);
+    }
+    
+    /**
+     * 以低優先權同步產生結果（預先處理用）：推理走SR線程的低優先權佇列，只在沒有一般請求時執行。
+     * token取消時在tile之間及單次推理的各階段之間中止並回傳null；提升後改走一般佇列。
+     * 不交給worker程序，避免佔用使用者請求的worker。
+     */
+    public Bitmap renderInBackground(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                                     int targetWidth, int targetHeight, ThreadSafeSRProcessor.BackgroundToken token) {
+        int[] targetSize = resolveTargetSize(bitmap, targetWidth, targetHeight);
+        if (useTiling) {
+            return processByTiles(bitmap, mode, targetSize, token.getCancellationFlag(), null, null, token);
+        }
+        return processDirect(bitmap, mode, targetSize, token);
+    }
+    
+    /**
+     * 超大輸入（無法整張解碼）的分塊串流處理：輸入按需讀取，輸出逐排編碼成PNG檔，
+     * 記憶體只與tile大小及輸出寬度有關。
+     */
+    public void processSource(TileSource source, File outputFile, ThreadSafeSRProcessor.ProcessingMode mode,
+                              FileProcessingCallback callback) {
+        new Thread(() -> {
+            long startTime = System.currentTimeMillis();
+            int[] targetSize = resolveTargetSize(source.getWidth(), source.getHeight(), 0, 0);
+            int outputHeight = targetSize[1] > 0 ? targetSize[1] : source.getHeight() * modelScale();
+            
+            try (OutputStream out = new BufferedOutputStream(new FileOutputStream(outputFile), 256 * 1024)) {
+                ImageEncoder.PngRowSink sink = new ImageEncoder.PngRowSink(out, outputHeight);
+                if (!streamRows(source, mode, targetSize, sink, (completed, total) ->
+                        callback.onProgress("Processing tiles: " + completed + "/" + total))) {
+                    sink.abort();
+                    callback.onError("Tile processing failed");
+                    return;
+                }
+                sink.finish();
+                
+                long totalTime = System.currentTimeMillis() - startTime;
+                callback.onSuccess(outputFile, String.format("Processed %dx%d in %d ms",
+                                                             source.getWidth(), source.getHeight(), totalTime));
+            } catch (IOException e) {
+                Log.e(TAG, "Failed to write " + outputFile, e);
+                callback.onError("Error: " + e.getMessage());
+            } catch (OutOfMemoryError e) {
+                Log.e(TAG, "Out of memory error", e);
+                callback.onError("Out of memory! Try closing other apps.");
+            } finally {
+                try {
+                    source.close();
+                } catch (IOException e) {
+                    Log.w(TAG, "Failed to close tile source", e);
+                }
+            }
+        }).start();
+    }
+    
+    /**
+     * 同 processSource，但輸出寫成 Deep Zoom 金字塔（manifest 為 .dzi 檔）；
+     * manifest 一開始就寫出，tile 邊處理邊產生，檢視器可立即開啟
+     */
+    public void processSourceToPyramid(TileSource source, File manifest, ThreadSafeSRProcessor.ProcessingMode mode,
+                                       FileProcessingCallback callback) {
+        new Thread(() -> {
+            long startTime = System.currentTimeMillis();
+            int[] targetSize = resolveTargetSize(source.getWidth(), source.getHeight(), 0, 0);
+            int[] outputSize = outputSize(source.getWidth(), source.getHeight(), targetSize);
+            int outputWidth = outputSize[0];
+            int outputHeight = outputSize[1];
+            
+            try {
+                PyramidSink sink = new PyramidSink(manifest, outputWidth, outputHeight, configManager);
+                if (!streamRows(source, mode, targetSize, sink, (completed, total) ->
+                        callback.onProgress("Processing tiles: " + completed + "/" + total))) {
+                    sink.abort();
+                    callback.onError("Tile processing failed");
+                    return;
+                }
+                sink.finish();
+                
+                long totalTime = System.currentTimeMillis() - startTime;
+                callback.onSuccess(manifest, String.format("Pyramid %dx%d in %d ms",
+                                                           outputWidth, outputHeight, totalTime));
+            } catch (IOException e) {
+                Log.e(TAG, "Failed to write " + manifest, e);
+                callback.onError("Error: " + e.getMessage());
+            } catch (OutOfMemoryError e) {
+                Log.e(TAG, "Out of memory error", e);
+                callback.onError("Out of memory! Try closing other apps.");
+            } finally {
+                try {
+                    source.close();
+                } catch (IOException e) {
+                    Log.w(TAG, "Failed to close tile source", e);
+                }
+            }
+        }).start();
+    }
+    
+    private boolean streamRows(TileSource source, ThreadSafeSRProcessor.ProcessingMode mode, int[] targetSize,
+                               TileProcessor.RowListener sink, TileProcessor.ProcessCallback progress) {
+        TileProcessor tileProcessor = new TileProcessor(srProcessor, configManager);
+        tileProcessor.setProcessingMode(mode);
+        tileProcessor.setWorkerPool(workerPool);
+        tileProcessor.setTargetSize(targetSize[0], targetSize[1]);
+        tileProcessor.setRowListener(sink);
+        boolean completed = tileProcessor.processToRows(source, progress);
+        lastTileTimings = tileProcessor.getTileTimings();
+        return completed;
+    }
+    
     private PerformanceMonitor.InferenceStats createPerformanceStats(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode) {
         PerformanceMonitor.InferenceStats stats = PerformanceMonitor.createStats();
         stats.inputWidth = bitmap.getWidth();
         stats.inputHeight = bitmap.getHeight();
         stats.accelerator = mode != null ? mode.name() + " (Forced)" : srProcessor.getAcceleratorInfo();
+        stats.model = configManager.getDefaultModelPath();
         
         MemoryUtils.MemoryInfo memInfo = MemoryUtils.getCurrentMemoryInfo();
         stats.memoryBefore = memInfo.usedMemoryMB;
@@ -93,20 +569,88 @@ public class ProcessingController {
         return stats;
     }
     
-    private Bitmap processByTiles(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, ProcessingCallback callback) {
+    /**
+     * 模型的原生倍率，與 TileProcessor 相同由模型輸入/輸出尺寸推得（設定檔的倍率可能與載入的模型不符）
+     */
+    private int modelScale() {
+        return Math.max(srProcessor.getModelOutputWidth() / srProcessor.getModelInputWidth(),
+                        srProcessor.getModelOutputHeight() / srProcessor.getModelInputHeight());
+    }
+    
+    /**
+     * 決定輸出尺寸；回傳 {0, 0} 表示使用模型原生倍率
+     */
+    private int[] resolveTargetSize(Bitmap bitmap, int targetWidth, int targetHeight) {
+        return resolveTargetSize(bitmap.getWidth(), bitmap.getHeight(), targetWidth, targetHeight);
+    }
+    
+    /**
+     * resolveTargetSize 的結果換算成實際輸出尺寸
+     */
+    private int[] outputSize(int inputWidth, int inputHeight, int[] targetSize) {
+        int scale = modelScale();
+        return new int[] {
+            targetSize[0] > 0 ? targetSize[0] : inputWidth * scale,
+            targetSize[1] > 0 ? targetSize[1] : inputHeight * scale
+        };
+    }
+    
+    private int[] resolveTargetSize(int inputWidth, int inputHeight, int targetWidth, int targetHeight) {
+        if (targetWidth > 0 && targetHeight > 0) {
+            return new int[] {targetWidth, targetHeight};
+        }
+        float targetScale = configManager.getTargetOutputScale();
+        if (targetScale > 0f && targetScale != modelScale()) {
+            return new int[] {
+                Math.max(1, Math.round(inputWidth * targetScale)),
+                Math.max(1, Math.round(inputHeight * targetScale))
+            };
+        }
+        return new int[] {0, 0};
+    }
+    
+    private Bitmap processByTiles(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, int[] targetSize,
+                                  AtomicBoolean cancelled, TileProcessor.RowListener rowListener,
+                                  ProcessingCallback callback, ThreadSafeSRProcessor.BackgroundToken background) {
         TileProcessor tileProcessor = new TileProcessor(srProcessor, configManager);
-        return tileProcessor.processByTiles(bitmap, new TileProcessor.ProcessCallback() {
-            @Override
-            public void onProgress(int completed, int total) {
-                String progressMsg = mode != null ? 
-                    "Processing with " + mode.name() + " - tiles: " + completed + "/" + total :
-                    "Processing tiles: " + completed + "/" + total;
-                callback.onProgress(progressMsg);
-            }
-        });
+        tileProcessor.setProcessingMode(mode);
+        if (background != null) {
+            tileProcessor.setBackgroundToken(background);
+        } else {
+            tileProcessor.setWorkerPool(workerPool);
+        }
+        tileProcessor.setTargetSize(targetSize[0], targetSize[1]);
+        tileProcessor.setCancellationFlag(cancelled);
+        tileProcessor.setRowListener(rowListener);
+        Bitmap result;
+        if (callback == null) {
+            result = tileProcessor.processByTiles(bitmap, null);
+        } else {
+            result = tileProcessor.processByTiles(bitmap, new TileProcessor.ProcessCallback() {
+                @Override
+                public void onProgress(int completed, int total) {
+                    String progressMsg = mode != null ? 
+                        "Processing with " + mode.name() + " - tiles: " + completed + "/" + total :
+                        "Processing tiles: " + completed + "/" + total;
+                    callback.onProgress(progressMsg);
+                }
+            });
+        }
+        lastTileTimings = tileProcessor.getTileTimings();
+        if (lastTileTimings != null) {
+            Log.d(TAG, "Tile timings: " + lastTileTimings);
+        }
+        return result;
     }
     
-    private Bitmap processDirect(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode) {
+    private Bitmap processDirect(Bitmap bitmap, ThreadSafeSRProcessor.ProcessingMode mode, int[] targetSize,
+                                 ThreadSafeSRProcessor.BackgroundToken background) {
+        OutputRegion region = null;
+        if (targetSize[0] > 0) {
+            region = OutputRegion.scaled(srProcessor.getModelOutputWidth(), srProcessor.getModelOutputHeight(),
+                                         targetSize[0], targetSize[1]);
+        }
+        
         final Object lock = new Object();
         final Bitmap[] result = new Bitmap[1];
         final boolean[] completed = new boolean[1];
@@ -132,10 +676,10 @@ public class ProcessingController {
             }
         };
         
-        if (mode != null) {
-            srProcessor.processImageWithMode(bitmap, mode, inferenceCallback);
+        if (background != null) {
+            srProcessor.processImageInBackground(bitmap, mode, region, background, inferenceCallback);
         } else {
-            srProcessor.processImage(bitmap, inferenceCallback);
+            srProcessor.processImageWithMode(bitmap, mode, region, inferenceCallback);
         }
         
         // Wait for completion
@@ -153,13 +697,21 @@ public class ProcessingController {
         return result[0];
     }
     
-    private void completeProcessing(PerformanceMonitor.InferenceStats stats, Bitmap resultBitmap, 
+    /**
+     * fullResult 不為null時 resultBitmap 是預覽，輸出尺寸已記錄在 stats
+     */
+    private void completeProcessing(PerformanceMonitor.InferenceStats stats, Bitmap resultBitmap, File fullResult,
                                   long totalTime, ProcessingCallback callback) {
         stats.inferenceTime = totalTime;
         
         if (resultBitmap != null) {
-            stats.outputWidth = resultBitmap.getWidth();
-            stats.outputHeight = resultBitmap.getHeight();
+            if (fullResult == null) {
+                stats.outputWidth = resultBitmap.getWidth();
+                stats.outputHeight = resultBitmap.getHeight();
+            }
+            if (!stats.usedTileProcessing) {
+                MetricsRegistry.get().addOutputPixels((long) stats.outputWidth * stats.outputHeight);
+            }
             
             MemoryUtils.MemoryInfo memInfo = MemoryUtils.getCurrentMemoryInfo();
             stats.memoryAfter = memInfo.usedMemoryMB;
@@ -171,9 +723,20 @@ public class ProcessingController {
                 timeMessage = String.format("Inference time (%s): %d ms", 
                     stats.accelerator.replace(" (Forced)", ""), stats.inferenceTime);
             }
+            if (stats.energyJoules >= 0) {
+                timeMessage += String.format(", %.2f J/MP", stats.getJoulesPerOutputMegapixel());
+            }
             
-            callback.onSuccess(resultBitmap, timeMessage);
+            if (fullResult != null) {
+                timeMessage += String.format(" (%dx%d written to %s, showing 1/%d preview)",
+                                             stats.outputWidth, stats.outputHeight, fullResult.getName(),
+                                             stats.previewFactor);
+                callback.onPreviewSuccess(resultBitmap, stats.previewFactor, fullResult, timeMessage);
+            } else {
+                callback.onSuccess(resultBitmap, timeMessage);
+            }
         } else {
+            stats.status = "null_result";
             callback.onError("Processing returned null result");
         }
     }
@@ -0,0 +1,100 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.os.Build;
+import android.util.Log;
+
+import com.example.sr_poc.ConfigManager;
+import com.example.sr_poc.TileProcessor;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+
+/**
+ * 把分塊處理完成的列直接寫成 Deep Zoom 金字塔（見 PyramidWriter），tile 以 Bitmap.compress 編碼
+ */
+public final class PyramidSink implements TileProcessor.RowListener {
+
+    private static final String TAG = "PyramidSink";
+    private static final int CHUNK_ROWS = 64;
+
+    private final PyramidWriter writer;
+    private final int width;
+    private int[] chunk = new int[0];
+    private IOException failure;
+
+    public PyramidSink(File manifest, int width, int height, ConfigManager config) throws IOException {
+        this.width = width;
+        String extension = config.getPyramidFormat();
+        Bitmap.CompressFormat format = compressFormat(extension);
+        int quality = config.getPyramidQuality();
+        this.writer = new PyramidWriter(manifest, width, height, config.getPyramidTileSize(),
+                                        config.getPyramidOverlap(), extension,
+                                        (argb, w, h, file) -> encodeTile(argb, w, h, file, format, quality),
+                                        ImageEncoder.getExecutor(),
+                                        4 * Runtime.getRuntime().availableProcessors());
+    }
+
+    @Override
+    public void onRowsComplete(Bitmap pixels, int sourceTop, int top, int bottom) {
+        if (failure != null) {
+            return;
+        }
+        try {
+            for (int y = top; y < bottom; y += CHUNK_ROWS) {
+                int rows = Math.min(CHUNK_ROWS, bottom - y);
+                if (chunk.length < width * rows) {
+                    chunk = new int[width * rows];
+                }
+                pixels.getPixels(chunk, 0, width, 0, sourceTop + (y - top), width, rows);
+                writer.writeRows(chunk, 0, rows);
+            }
+        } catch (IOException e) {
+            failure = e;
+            writer.abort();
+        }
+    }
+
+    /**
+     * 寫出剩餘層級；串流過程中發生的錯誤在此拋出
+     */
+    public void finish() throws IOException {
+        if (failure != null) {
+            throw failure;
+        }
+        writer.finish();
+        Log.d(TAG, String.format("Pyramid: %d levels, %d tiles", writer.getLevelCount(), writer.getTilesWritten()));
+    }
+
+    public void abort() {
+        writer.abort();
+    }
+
+    private static void encodeTile(int[] argb, int width, int height, File file,
+                                   Bitmap.CompressFormat format, int quality) throws IOException {
+        Bitmap tile = Bitmap.createBitmap(argb, width, height, Bitmap.Config.ARGB_8888);
+        try (OutputStream out = new BufferedOutputStream(new FileOutputStream(file), 64 * 1024)) {
+            if (!tile.compress(format, quality, out)) {
+                throw new IOException("Tile compress failed: " + file);
+            }
+        } finally {
+            tile.recycle();
+        }
+    }
+
+    @SuppressWarnings("deprecation")
+    private static Bitmap.CompressFormat compressFormat(String extension) {
+        switch (extension) {
+            case "png":
+                return Bitmap.CompressFormat.PNG;
+            case "webp":
+                return Build.VERSION.SDK_INT >= Build.VERSION_CODES.R
+                    ? Bitmap.CompressFormat.WEBP_LOSSY : Bitmap.CompressFormat.WEBP;
+            default:
+                return Bitmap.CompressFormat.JPEG;
+        }
+    }
+}
@@ -0,0 +1,267 @@
+package com.example.sr_poc.processing;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayDeque;
+import java.util.Locale;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+
+/**
+ * Deep Zoom (DZI) 金字塔輸出。全解析度的列由上而下依序寫入，滿一排tile即編碼輸出，
+ * 同時以 2x box filter 逐列縮小餵給較粗的層級；每層只保留一排tile高度的列帶，
+ * 記憶體與輸出寬度成正比，與高度無關。
+ *
+ * 目錄結構：name.dzi + name_files/level/col_row.ext，最大層級為全解析度（與 DZI 規格相同）。
+ */
+public final class PyramidWriter {
+
+    /**
+     * tile 編碼器，可能在多個執行緒上同時被呼叫
+     */
+    public interface TileEncoder {
+        void encode(int[] argb, int width, int height, File file) throws IOException;
+    }
+
+    private final File tilesDir;
+    private final int tileSize;
+    private final int overlap;
+    private final String extension;
+    private final TileEncoder tileEncoder;
+    private final ExecutorService executor;
+    private final int maxInFlight;
+    private final Level[] levels;
+
+    private final ArrayDeque<Future<?>> pending = new ArrayDeque<>();
+    private int tilesWritten;
+
+    /**
+     * @param manifest  .dzi 檔路徑；tile 寫入同名的 _files 目錄
+     * @param extension tile 副檔名（DZI 的 Format 欄位，例如 "jpg"、"png"）
+     */
+    public PyramidWriter(File manifest, int width, int height, int tileSize, int overlap, String extension,
+                         TileEncoder tileEncoder, ExecutorService executor, int maxInFlight) throws IOException {
+        if (width <= 0 || height <= 0 || tileSize <= 0 || overlap < 0) {
+            throw new IllegalArgumentException("Invalid pyramid geometry");
+        }
+        String name = manifest.getName();
+        int dot = name.lastIndexOf('.');
+        this.tilesDir = new File(manifest.getParentFile(), (dot > 0 ? name.substring(0, dot) : name) + "_files");
+        this.tileSize = tileSize;
+        this.overlap = overlap;
+        this.extension = extension;
+        this.tileEncoder = tileEncoder;
+        this.executor = executor;
+        this.maxInFlight = Math.max(1, maxInFlight);
+
+        int maxLevel = 0;
+        while ((1L << maxLevel) < Math.max(width, height)) {
+            maxLevel++;
+        }
+        levels = new Level[maxLevel + 1];
+        for (int i = maxLevel, w = width, h = height; i >= 0; i--, w = (w + 1) / 2, h = (h + 1) / 2) {
+            levels[i] = new Level(i, w, h);
+        }
+
+        // manifest 先寫出，檢視器可在tile陸續產生時就開始載入
+        writeManifest(manifest, width, height);
+    }
+
+    public int getLevelCount() {
+        return levels.length;
+    }
+
+    /**
+     * 寫入全解析度的下一批列（ARGB，列優先，寬度為影像寬度）
+     */
+    public void writeRows(int[] pixels, int offset, int rowCount) throws IOException {
+        Level top = levels[levels.length - 1];
+        for (int y = 0; y < rowCount; y++) {
+            push(top, pixels, offset + y * top.width);
+        }
+    }
+
+    /**
+     * 補齊奇數高度留下的最後一列並等待所有tile寫完
+     */
+    public void finish() throws IOException {
+        for (int i = levels.length - 1; i > 0; i--) {
+            Level level = levels[i];
+            if (level.nextY != level.height) {
+                throw new IOException("Level " + i + " incomplete: " + level.nextY + "/" + level.height);
+            }
+            if (level.hasPending) {
+                level.hasPending = false;
+                downsample(level.pending, level.pending, level.width, level.downRow);
+                push(levels[i - 1], level.downRow, 0);
+            }
+        }
+        while (!pending.isEmpty()) {
+            await(pending.poll());
+        }
+    }
+
+    public void abort() {
+        for (Future<?> future : pending) {
+            future.cancel(true);
+        }
+        pending.clear();
+    }
+
+    public int getTilesWritten() {
+        return tilesWritten;
+    }
+
+    private void push(Level level, int[] row, int offset) throws IOException {
+        System.arraycopy(row, offset, level.band, (level.nextY - level.bandTop) * level.width, level.width);
+        level.nextY++;
+
+        while (level.nextTileRow < level.tileRows
+               && level.nextY >= Math.min(level.height, (level.nextTileRow + 1) * tileSize + overlap)) {
+            emitTileRow(level, level.nextTileRow);
+            level.nextTileRow++;
+            // 保留下一排tile需要的重疊列
+            int newTop = Math.max(0, level.nextTileRow * tileSize - overlap);
+            int keep = level.nextY - newTop;
+            if (newTop > level.bandTop && keep > 0) {
+                System.arraycopy(level.band, (newTop - level.bandTop) * level.width, level.band, 0,
+                                 keep * level.width);
+            }
+            level.bandTop = Math.max(level.bandTop, newTop);
+        }
+
+        if (level.index == 0) {
+            return;
+        }
+        if (!level.hasPending) {
+            System.arraycopy(row, offset, level.pending, 0, level.width);
+            level.hasPending = true;
+        } else {
+            level.hasPending = false;
+            downsample(level.pending, row, offset, level.width, level.downRow);
+            push(levels[level.index - 1], level.downRow, 0);
+        }
+    }
+
+    private void emitTileRow(Level level, int tileRow) throws IOException {
+        int top = Math.max(0, tileRow * tileSize - overlap);
+        int bottom = Math.min(level.height, (tileRow + 1) * tileSize + overlap);
+        File dir = new File(tilesDir, Integer.toString(level.index));
+        if (!dir.isDirectory() && !dir.mkdirs()) {
+            throw new IOException("Cannot create " + dir);
+        }
+
+        for (int col = 0; col < level.tileCols; col++) {
+            int left = Math.max(0, col * tileSize - overlap);
+            int right = Math.min(level.width, (col + 1) * tileSize + overlap);
+            int w = right - left;
+            int h = bottom - top;
+            int[] tile = new int[w * h];
+            for (int y = 0; y < h; y++) {
+                System.arraycopy(level.band, (top - level.bandTop + y) * level.width + left, tile, y * w, w);
+            }
+
+            File file = new File(dir, col + "_" + tileRow + "." + extension);
+            while (pending.size() >= maxInFlight) {
+                await(pending.poll());
+            }
+            pending.add(executor.submit(() -> {
+                tileEncoder.encode(tile, w, h, file);
+                return null;
+            }));
+            tilesWritten++;
+        }
+    }
+
+    /**
+     * 2x box filter：以 SWAR 方式在單一 int 內同時平均四個 8-bit 通道，不需拆解通道
+     */
+    static void downsample(int[] upper, int[] lower, int lowerOffset, int width, int[] dst) {
+        int outWidth = (width + 1) / 2;
+        for (int x = 0; x < outWidth; x++) {
+            int x0 = 2 * x;
+            int x1 = Math.min(x0 + 1, width - 1);
+            dst[x] = average(upper[x0], upper[x1], lower[lowerOffset + x0], lower[lowerOffset + x1]);
+        }
+    }
+
+    static void downsample(int[] upper, int[] lower, int width, int[] dst) {
+        downsample(upper, lower, 0, width, dst);
+    }
+
+    /**
+     * 逐byte四捨五入平均 (a+b+c+d+2)/4。通道分成 R/B 與 A/G 兩組各佔 16-bit，
+     * 四個 8-bit 值相加最多 10 bit 不會溢出到相鄰通道；只取整一次，逐層縮小不會累積偏暗
+     */
+    static int average(int a, int b, int c, int d) {
+        int rb = (((a & 0x00FF00FF) + (b & 0x00FF00FF) + (c & 0x00FF00FF) + (d & 0x00FF00FF) + 0x00020002)
+                  >>> 2) & 0x00FF00FF;
+        int ag = ((((a >>> 8) & 0x00FF00FF) + ((b >>> 8) & 0x00FF00FF) + ((c >>> 8) & 0x00FF00FF)
+                   + ((d >>> 8) & 0x00FF00FF) + 0x00020002) >>> 2) & 0x00FF00FF;
+        return rb | (ag << 8);
+    }
+
+    private void await(Future<?> future) throws IOException {
+        try {
+            future.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            abort();
+            throw new IOException("Interrupted while writing tiles", e);
+        } catch (ExecutionException e) {
+            abort();
+            Throwable cause = e.getCause();
+            throw cause instanceof IOException ? (IOException) cause : new IOException("Tile write failed", cause);
+        }
+    }
+
+    private void writeManifest(File manifest, int width, int height) throws IOException {
+        if (!tilesDir.isDirectory() && !tilesDir.mkdirs()) {
+            throw new IOException("Cannot create " + tilesDir);
+        }
+        File temp = new File(manifest.getPath() + ".tmp");
+        try (Writer writer = new OutputStreamWriter(new FileOutputStream(temp), StandardCharsets.UTF_8)) {
+            writer.write(String.format(Locale.US,
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                + "<Image xmlns=\"http://schemas.microsoft.com/deepzoom/2008\" TileSize=\"%d\" Overlap=\"%d\""
+                + " Format=\"%s\">\n  <Size Width=\"%d\" Height=\"%d\"/>\n</Image>\n",
+                tileSize, overlap, extension, width, height));
+        }
+        if (!temp.renameTo(manifest)) {
+            temp.delete();
+            throw new IOException("Cannot write " + manifest);
+        }
+    }
+
+    private final class Level {
+        final int index;
+        final int width;
+        final int height;
+        final int tileCols;
+        final int tileRows;
+        // 一排tile（含上下重疊）的列帶，bandTop 為其第一列在本層的y
+        final int[] band;
+        final int[] pending;
+        final int[] downRow;
+        int bandTop;
+        int nextY;
+        int nextTileRow;
+        boolean hasPending;
+
+        Level(int index, int width, int height) {
+            this.index = index;
+            this.width = width;
+            this.height = height;
+            this.tileCols = (width + tileSize - 1) / tileSize;
+            this.tileRows = (height + tileSize - 1) / tileSize;
+            this.band = new int[width * Math.min(height, tileSize + 2 * overlap)];
+            this.pending = index > 0 ? new int[width] : null;
+            this.downRow = index > 0 ? new int[(width + 1) / 2] : null;
+        }
+    }
+}
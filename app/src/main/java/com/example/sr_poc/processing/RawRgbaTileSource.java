@@ -0,0 +1,104 @@
+package com.example.sr_poc.processing;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+/**
+ * 未壓縮 RGBA8888（列優先，無padding）檔案的記憶體映射來源。
+ * 單一映射上限為 2GB，因此以列範圍的視窗映射，讀取超出視窗時才重新映射。
+ */
+public final class RawRgbaTileSource implements TileSource {
+
+    private static final long MAX_WINDOW_BYTES = 256L * 1024 * 1024;
+
+    private final RandomAccessFile file;
+    private final FileChannel channel;
+    private final int width;
+    private final int height;
+    private final long dataOffset;
+    private final long rowBytes;
+
+    private MappedByteBuffer window;
+    private int windowTop;
+    private int windowBottom;
+    private byte[] rowScratch = new byte[0];
+
+    /**
+     * @param dataOffset 像素資料在檔案中的起始位置（跳過自訂標頭時使用）
+     */
+    public RawRgbaTileSource(File path, int width, int height, long dataOffset) throws IOException {
+        this.file = new RandomAccessFile(path, "r");
+        this.channel = file.getChannel();
+        this.width = width;
+        this.height = height;
+        this.dataOffset = dataOffset;
+        this.rowBytes = (long) width * 4;
+
+        long expected = dataOffset + rowBytes * height;
+        if (channel.size() < expected) {
+            close();
+            throw new IOException("Raw file too small: " + channel.size() + " < " + expected);
+        }
+    }
+
+    @Override
+    public int getWidth() {
+        return width;
+    }
+
+    @Override
+    public int getHeight() {
+        return height;
+    }
+
+    @Override
+    public void readRegion(int left, int top, int regionWidth, int regionHeight, int[] dst) throws IOException {
+        int bytes = regionWidth * 4;
+        if (rowScratch.length < bytes) {
+            rowScratch = new byte[bytes];
+        }
+
+        for (int y = 0; y < regionHeight; y++) {
+            int row = top + y;
+            ensureWindow(row, top + regionHeight);
+            window.position((int) ((row - windowTop) * rowBytes + (long) left * 4));
+            window.get(rowScratch, 0, bytes);
+
+            int out = y * regionWidth;
+            for (int x = 0, p = 0; x < regionWidth; x++, p += 4) {
+                int r = rowScratch[p] & 0xFF;
+                int g = rowScratch[p + 1] & 0xFF;
+                int b = rowScratch[p + 2] & 0xFF;
+                int a = rowScratch[p + 3] & 0xFF;
+                dst[out + x] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+    }
+
+    /**
+     * 確保row在目前映射視窗內；新視窗盡量涵蓋到 wantedBottom
+     */
+    private void ensureWindow(int row, int wantedBottom) throws IOException {
+        if (window != null && row >= windowTop && row < windowBottom) {
+            return;
+        }
+        int maxRows = (int) Math.max(1, MAX_WINDOW_BYTES / rowBytes);
+        windowTop = row;
+        windowBottom = Math.min(height, Math.max(wantedBottom, row + 1));
+        windowBottom = Math.min(windowBottom, windowTop + maxRows);
+        // 視窗太小時往下延伸，減少逐列讀取時的重新映射次數
+        windowBottom = Math.max(windowBottom, Math.min(height, windowTop + maxRows / 4));
+        window = channel.map(FileChannel.MapMode.READ_ONLY, dataOffset + windowTop * rowBytes,
+                             (windowBottom - windowTop) * rowBytes);
+    }
+
+    @Override
+    public void close() throws IOException {
+        window = null;
+        channel.close();
+        file.close();
+    }
+}
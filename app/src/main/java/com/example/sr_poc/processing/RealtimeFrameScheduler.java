@@ -0,0 +1,334 @@
+package com.example.sr_poc.processing;
+
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.concurrent.Executor;
+
+/**
+ * 即時播放的逐幀超解析度排程，由 vsync 驅動：
+ * 每個 vsync 呈現已完成的結果，並為最新的解碼幀決定路徑——預估（EMA）能在截止前完成就送 SR，
+ * 否則依策略改用傳統放大或直接丟幀。同一時間最多一幀在做 SR，來不及開始就被新幀取代的幀算丟幀。
+ *
+ * 排程器捨棄的幀（被取代的解碼幀與結果、逾時或失敗的結果、放大後的輸入）都交給 FrameSink.discard 釋放；
+ * 呈現出去的幀歸 sink 所有。
+ *
+ * 不依賴 Android，時鐘與執行器可注入，方便在 JVM 上以合成時鐘測試。
+ *
+ * @param <F> 幀的型別（App 端為 Bitmap）
+ */
+public final class RealtimeFrameScheduler<F> {
+
+    public interface Clock {
+        long nanoTime();
+    }
+
+    public interface Upscaler<F> {
+        F upscale(F frame) throws Exception;
+    }
+
+    public interface FrameSink<F> {
+        /**
+         * 在 vsync 時呈現；fallback 表示此幀使用傳統放大
+         */
+        void present(F frame, long vsyncNanos, boolean fallback);
+
+        /**
+         * 排程器不再使用且不會呈現的幀（App 端回收 Bitmap）；可能在任意執行緒呼叫
+         */
+        default void discard(F frame) {
+        }
+    }
+
+    public enum MissPolicy {
+        /** 預估趕不上時丟棄此幀，畫面停留在上一幀 */
+        DROP,
+        /** 預估趕不上時改用傳統放大 */
+        FALLBACK
+    }
+
+    private static final int LATENCY_WINDOW = 512;
+    // 連續因預估超時而略過 SR 這麼多幀後強制試一次，讓成本下降時能回到 SR
+    private static final int PROBE_INTERVAL = 30;
+
+    private final Clock clock;
+    private final Executor srExecutor;
+    private final Upscaler<F> srUpscaler;
+    private final Upscaler<F> fallbackUpscaler;
+    private final FrameSink<F> sink;
+    private final MissPolicy policy;
+    private final long refreshIntervalNanos;
+    private final int budgetFrames;
+    private final double emaAlpha;
+
+    // 以下由 this 保護
+    private F pendingFrame;
+    private long pendingCaptureNanos;
+    private boolean srBusy; // SR 或 fallback 進行中
+    private long busyUntilNanos; // 上一次放大結束的時間（以注入的時鐘計）
+    private F readyFrame;
+    private long readyCaptureNanos;
+    private long readyAtNanos;
+    private boolean readyFallback;
+    private int skippedSr;
+    private double srCostEma = -1;
+    private double fallbackCostEma = -1;
+
+    private long framesIn;
+    private long framesPresented;
+    private long framesFallback;
+    private long droppedSuperseded;
+    private long droppedOverBudget;
+    private long droppedLate;
+    private long droppedErrors;
+    private final long[] latencies = new long[LATENCY_WINDOW];
+    private int latencyCount;
+    private int latencyNext;
+
+    /**
+     * @param budgetFrames 幀從排入 SR 到呈現可用的 vsync 週期數（2 表示下下個 vsync 前須完成）
+     */
+    public RealtimeFrameScheduler(Clock clock, Executor srExecutor, Upscaler<F> srUpscaler,
+                                  Upscaler<F> fallbackUpscaler, FrameSink<F> sink, MissPolicy policy,
+                                  long refreshIntervalNanos, int budgetFrames, double emaAlpha) {
+        this.clock = clock;
+        this.srExecutor = srExecutor;
+        this.srUpscaler = srUpscaler;
+        this.fallbackUpscaler = fallbackUpscaler;
+        this.sink = sink;
+        this.policy = policy;
+        this.refreshIntervalNanos = refreshIntervalNanos;
+        this.budgetFrames = Math.max(1, budgetFrames);
+        this.emaAlpha = emaAlpha;
+    }
+
+    /**
+     * 解碼器每產生一幀呼叫一次；尚未開始處理的舊幀會被取代（計為丟幀）
+     */
+    public void onFrameDecoded(F frame, long captureNanos) {
+        F superseded;
+        synchronized (this) {
+            framesIn++;
+            superseded = pendingFrame;
+            if (superseded != null) {
+                droppedSuperseded++;
+            }
+            pendingFrame = frame;
+            pendingCaptureNanos = captureNanos;
+        }
+        discard(superseded);
+    }
+
+    /**
+     * 停止播放時呼叫：捨棄尚未處理與尚未呈現的幀。進行中的放大完成後仍照常處理
+     */
+    public void clear() {
+        F pending;
+        F ready;
+        synchronized (this) {
+            pending = pendingFrame;
+            ready = readyFrame;
+            pendingFrame = null;
+            readyFrame = null;
+        }
+        discard(pending);
+        discard(ready);
+    }
+
+    /**
+     * 每個 vsync 呼叫：先呈現已完成的幀，再排程最新的待處理幀
+     */
+    public void onVsync(long vsyncNanos) {
+        F present = null;
+        long presentCapture = 0;
+        boolean presentFallback = false;
+        F start = null;
+        F dropped = null;
+        long startCapture = 0;
+        long deadline = 0;
+        boolean useFallback = false;
+
+        synchronized (this) {
+            if (readyFrame != null && readyAtNanos <= vsyncNanos) {
+                present = readyFrame;
+                presentCapture = readyCaptureNanos;
+                presentFallback = readyFallback;
+                readyFrame = null;
+                recordPresented(vsyncNanos - presentCapture, presentFallback);
+            }
+
+            long now = clock.nanoTime();
+            if (pendingFrame != null && !srBusy && now >= busyUntilNanos) {
+                start = pendingFrame;
+                startCapture = pendingCaptureNanos;
+                pendingFrame = null;
+                // 必須在 budgetFrames 個週期後的 vsync 前完成
+                deadline = vsyncNanos + budgetFrames * refreshIntervalNanos;
+                long available = deadline - now;
+                boolean probe = ++skippedSr > PROBE_INTERVAL;
+                if (srCostEma >= 0 && srCostEma > available && !probe) {
+                    if (policy == MissPolicy.FALLBACK && (fallbackCostEma < 0 || fallbackCostEma <= available)) {
+                        useFallback = true;
+                    } else {
+                        droppedOverBudget++;
+                        dropped = start;
+                        start = null;
+                    }
+                }
+                if (start != null) {
+                    srBusy = true;
+                    if (!useFallback) {
+                        skippedSr = 0;
+                    }
+                }
+            }
+        }
+
+        if (present != null) {
+            sink.present(present, vsyncNanos, presentFallback);
+        }
+        discard(dropped);
+        if (start == null) {
+            return;
+        }
+        F frame = start;
+        long capture = startCapture;
+        long frameDeadline = deadline;
+        boolean fallback = useFallback;
+        srExecutor.execute(() -> upscale(frame, capture, frameDeadline, fallback));
+    }
+
+    private void upscale(F frame, long captureNanos, long deadline, boolean fallback) {
+        long begin = clock.nanoTime();
+        F result;
+        try {
+            result = fallback ? fallbackUpscaler.upscale(frame) : srUpscaler.upscale(frame);
+        } catch (Exception e) {
+            result = null;
+        }
+        long end = clock.nanoTime();
+        // 輸入在放大後就不再需要（放大器原樣回傳時除外）
+        if (result != frame) {
+            discard(frame);
+        }
+
+        F discarded = null;
+        synchronized (this) {
+            srBusy = false;
+            busyUntilNanos = end;
+            if (fallback) {
+                fallbackCostEma = ema(fallbackCostEma, end - begin);
+            } else {
+                srCostEma = ema(srCostEma, end - begin);
+            }
+            if (result == null) {
+                droppedErrors++;
+            } else if (end > deadline) {
+                // 已錯過預定的 vsync，呈現只會讓畫面更不連續
+                droppedLate++;
+                discarded = result;
+            } else {
+                discarded = setReady(result, captureNanos, end, fallback);
+            }
+        }
+        discard(discarded);
+    }
+
+    /**
+     * 回傳被取代、需要捨棄的前一個結果
+     */
+    private F setReady(F frame, long captureNanos, long readyAt, boolean fallback) {
+        F superseded = readyFrame;
+        if (superseded != null) {
+            // 前一個結果還沒被 vsync 取走就被更新的結果取代
+            droppedSuperseded++;
+        }
+        readyFrame = frame;
+        readyCaptureNanos = captureNanos;
+        readyAtNanos = readyAt;
+        readyFallback = fallback;
+        return superseded;
+    }
+
+    private void discard(F frame) {
+        if (frame != null) {
+            sink.discard(frame);
+        }
+    }
+
+    private double ema(double current, long sample) {
+        return current < 0 ? sample : current + emaAlpha * (sample - current);
+    }
+
+    private void recordPresented(long motionToPhotonNanos, boolean fallback) {
+        framesPresented++;
+        if (fallback) {
+            framesFallback++;
+        }
+        latencies[latencyNext] = motionToPhotonNanos;
+        latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+        latencyCount = Math.min(latencyCount + 1, LATENCY_WINDOW);
+    }
+
+    public synchronized Stats getStats() {
+        long[] sorted = Arrays.copyOf(latencies, latencyCount);
+        Arrays.sort(sorted);
+        return new Stats(framesIn, framesPresented, framesFallback,
+                         droppedSuperseded, droppedOverBudget, droppedLate, droppedErrors,
+                         percentile(sorted, 0.50), percentile(sorted, 0.95), srCostEma);
+    }
+
+    private static long percentile(long[] sorted, double p) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.min(sorted.length - 1, Math.ceil(p * sorted.length) - 1);
+        return sorted[Math.max(0, index)];
+    }
+
+    public static final class Stats {
+        public final long framesIn;
+        public final long framesPresented;
+        public final long framesFallback;
+        public final long droppedSuperseded;
+        public final long droppedOverBudget;
+        public final long droppedLate;
+        public final long droppedErrors;
+        /** 解碼（capture）到呈現 vsync 的延遲 */
+        public final long motionToPhotonP50Nanos;
+        public final long motionToPhotonP95Nanos;
+        public final double srCostEmaNanos;
+
+        Stats(long framesIn, long framesPresented, long framesFallback, long droppedSuperseded,
+              long droppedOverBudget, long droppedLate, long droppedErrors,
+              long motionToPhotonP50Nanos, long motionToPhotonP95Nanos, double srCostEmaNanos) {
+            this.framesIn = framesIn;
+            this.framesPresented = framesPresented;
+            this.framesFallback = framesFallback;
+            this.droppedSuperseded = droppedSuperseded;
+            this.droppedOverBudget = droppedOverBudget;
+            this.droppedLate = droppedLate;
+            this.droppedErrors = droppedErrors;
+            this.motionToPhotonP50Nanos = motionToPhotonP50Nanos;
+            this.motionToPhotonP95Nanos = motionToPhotonP95Nanos;
+            this.srCostEmaNanos = srCostEmaNanos;
+        }
+
+        public long getDropped() {
+            return droppedSuperseded + droppedOverBudget + droppedLate + droppedErrors;
+        }
+
+        public double getDroppedRate() {
+            return framesIn > 0 ? (double) getDropped() / framesIn : 0;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US,
+                "frames %d, presented %d (%d fallback), dropped %.1f%% [superseded %d, over budget %d, late %d, "
+                + "errors %d], motion-to-photon p50 %.1f ms p95 %.1f ms, SR cost %.1f ms",
+                framesIn, framesPresented, framesFallback, getDroppedRate() * 100, droppedSuperseded,
+                droppedOverBudget, droppedLate, droppedErrors, motionToPhotonP50Nanos / 1e6,
+                motionToPhotonP95Nanos / 1e6, Math.max(0, srCostEmaNanos) / 1e6);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.os.Looper;
+import android.util.Log;
+import android.view.Choreographer;
+import android.view.Display;
+
+import com.example.sr_poc.ConfigManager;
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 影片播放的即時超解析度：解碼幀交給 RealtimeFrameScheduler，由 Choreographer 的 vsync 驅動呈現。
+ * SR 在專用執行緒上同步等待 ThreadSafeSRProcessor；預估趕不上時以雙線性放大代替或丟幀。
+ * 排程器捨棄的幀在此回收；呈現的幀交給 FrameConsumer，由其負責回收。
+ * start/stop 需在主執行緒呼叫（Choreographer 綁定主執行緒 Looper）。
+ */
+public final class RealtimeVideoUpscaler implements Choreographer.FrameCallback {
+
+    private static final String TAG = "RealtimeVideoUpscaler";
+    private static final long STATS_LOG_INTERVAL_NANOS = 5_000_000_000L;
+    private static final long SR_WARN_SECONDS = 1;
+
+    public interface FrameConsumer {
+        /** 在主執行緒、vsync 時呼叫 */
+        void onFramePresented(Bitmap frame, boolean fallback);
+    }
+
+    private final ThreadSafeSRProcessor srProcessor;
+    private final ThreadSafeSRProcessor.ProcessingMode mode;
+    private final int scale;
+    private final HandlerThread srThread;
+    private final Handler srHandler;
+    private final RealtimeFrameScheduler<Bitmap> scheduler;
+    private boolean running;
+    private long lastStatsLog;
+
+    public RealtimeVideoUpscaler(ThreadSafeSRProcessor srProcessor, ThreadSafeSRProcessor.ProcessingMode mode,
+                                 ConfigManager config, Display display, FrameConsumer consumer) {
+        this.srProcessor = srProcessor;
+        this.mode = mode;
+        this.scale = config.getExpectedScaleFactor();
+
+        srThread = new HandlerThread("RealtimeSR", android.os.Process.THREAD_PRIORITY_DISPLAY);
+        srThread.start();
+        srHandler = new Handler(srThread.getLooper());
+
+        float refreshRate = display != null && display.getRefreshRate() > 0 ? display.getRefreshRate() : 60f;
+        RealtimeFrameScheduler.MissPolicy policy = "drop".equals(config.getRealtimeMissPolicy())
+            ? RealtimeFrameScheduler.MissPolicy.DROP : RealtimeFrameScheduler.MissPolicy.FALLBACK;
+
+        scheduler = new RealtimeFrameScheduler<>(
+            System::nanoTime, srHandler::post, this::upscaleSr, this::upscaleClassic,
+            new RealtimeFrameScheduler.FrameSink<Bitmap>() {
+                @Override
+                public void present(Bitmap frame, long vsyncNanos, boolean fallback) {
+                    consumer.onFramePresented(frame, fallback);
+                }
+
+                @Override
+                public void discard(Bitmap frame) {
+                    frame.recycle();
+                }
+            },
+            policy, (long) (1e9 / refreshRate), config.getRealtimeBudgetFrames(), config.getRealtimeCostEmaAlpha());
+        Log.d(TAG, String.format("Realtime SR at %.1f Hz, policy %s, budget %d frames", refreshRate, policy,
+                                 config.getRealtimeBudgetFrames()));
+    }
+
+    /**
+     * 解碼器產生新幀時呼叫（任意執行緒）；幀由本物件接手，呼叫端不可再修改
+     */
+    public void submitFrame(Bitmap frame) {
+        scheduler.onFrameDecoded(frame, System.nanoTime());
+    }
+
+    public void start() {
+        if (Looper.myLooper() != Looper.getMainLooper()) {
+            throw new IllegalStateException("start() must be called on the main thread");
+        }
+        if (!running) {
+            running = true;
+            Choreographer.getInstance().postFrameCallback(this);
+        }
+    }
+
+    public void stop() {
+        running = false;
+        Choreographer.getInstance().removeFrameCallback(this);
+    }
+
+    public void shutdown() {
+        stop();
+        // 排在進行中的放大之後，其結果也會一併回收
+        srHandler.post(scheduler::clear);
+        srThread.quitSafely();
+        Log.d(TAG, "Final: " + scheduler.getStats());
+    }
+
+    public RealtimeFrameScheduler.Stats getStats() {
+        return scheduler.getStats();
+    }
+
+    @Override
+    public void doFrame(long frameTimeNanos) {
+        if (!running) {
+            return;
+        }
+        scheduler.onVsync(frameTimeNanos);
+        if (frameTimeNanos - lastStatsLog > STATS_LOG_INTERVAL_NANOS) {
+            lastStatsLog = frameTimeNanos;
+            Log.d(TAG, scheduler.getStats().toString());
+        }
+        Choreographer.getInstance().postFrameCallback(this);
+    }
+
+    /**
+     * 等到 SR 真正回傳才返回：期間排程器維持 SR 忙碌、不會再排入下一幀，輸入也不會在推理中被回收；
+     * 逾時的結果由排程器判定為遲到並回收
+     */
+    private Bitmap upscaleSr(Bitmap frame) throws Exception {
+        CountDownLatch latch = new CountDownLatch(1);
+        Bitmap[] result = new Bitmap[1];
+        String[] error = new String[1];
+        srProcessor.processImageWithMode(frame, mode, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap resultBitmap, long inferenceTime) {
+                result[0] = resultBitmap;
+                latch.countDown();
+            }
+
+            @Override
+            public void onError(String message) {
+                error[0] = message;
+                latch.countDown();
+            }
+        });
+        if (!latch.await(SR_WARN_SECONDS, TimeUnit.SECONDS)) {
+            Log.w(TAG, "SR exceeded " + SR_WARN_SECONDS + " s, holding the SR lane until it returns");
+            latch.await();
+        }
+        if (result[0] == null) {
+            throw new IllegalStateException(error[0]);
+        }
+        return result[0];
+    }
+
+    private Bitmap upscaleClassic(Bitmap frame) {
+        return Bitmap.createScaledBitmap(frame, frame.getWidth() * scale, frame.getHeight() * scale, true);
+    }
+}
@@ -0,0 +1,55 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.graphics.BitmapRegionDecoder;
+import android.graphics.Rect;
+
+import com.example.sr_poc.utils.BitmapPool;
+
+import java.io.IOException;
+
+/**
+ * 以 BitmapRegionDecoder 按需解碼區域，適用無法整張解碼的大型 JPEG/PNG/WebP
+ */
+public final class RegionDecoderTileSource implements TileSource {
+
+    private final BitmapRegionDecoder decoder;
+    private final BitmapPool pool;
+    private final Rect rect = new Rect();
+
+    public RegionDecoderTileSource(BitmapRegionDecoder decoder, BitmapPool pool) {
+        this.decoder = decoder;
+        this.pool = pool;
+    }
+
+    @Override
+    public int getWidth() {
+        return decoder.getWidth();
+    }
+
+    @Override
+    public int getHeight() {
+        return decoder.getHeight();
+    }
+
+    @Override
+    public void readRegion(int left, int top, int width, int height, int[] dst) throws IOException {
+        rect.set(left, top, left + width, top + height);
+        Bitmap staging = pool.acquire(width, height);
+        Bitmap decoded = ParallelImageDecoder.decodeRegion(decoder, rect, staging);
+        if (decoded == null) {
+            pool.release(staging);
+            throw new IOException("Region decode failed for " + rect);
+        }
+        decoded.getPixels(dst, 0, width, 0, 0, width, height);
+        if (decoded != staging) {
+            decoded.recycle();
+        }
+        pool.release(staging);
+    }
+
+    @Override
+    public void close() {
+        decoder.recycle();
+    }
+}
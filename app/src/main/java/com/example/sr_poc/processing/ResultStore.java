@@ -0,0 +1,387 @@
+package com.example.sr_poc.processing;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.os.Build;
+import android.util.Log;
+
+import com.example.sr_poc.ConfigManager;
+import com.example.sr_poc.ThreadSafeSRProcessor;
+import com.example.sr_poc.TileProcessor;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.Map;
+import java.util.WeakHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * 持久化的超解析度結果儲存：以 (輸入內容雜湊, 模型雜湊, 設定指紋) 為key，
+ * 將編碼後的輸出存在 cacheDir，總大小超過上限時依 LRU 淘汰。
+ * 預設以平行 PNG 編碼（可由分塊處理串流寫入）；設定為 webp 且 API 30+ 時使用無損 WebP。
+ */
+public class ResultStore {
+
+    private static final String TAG = "ResultStore";
+    private static final String DIRECTORY_NAME = "sr_results";
+    private static final String TEMP_SUFFIX = ".tmp";
+
+    private final Context context;
+    private final ConfigManager configManager;
+    private final File directory;
+    private final long maxBytes;
+    private final boolean usePng;
+    private final ExecutorService writer;
+    private final Map<Bitmap, String> contentHashes = new WeakHashMap<>();
+
+    private String modelHash;
+
+    public ResultStore(Context context, ConfigManager configManager) {
+        this.context = context.getApplicationContext();
+        this.configManager = configManager;
+        this.directory = new File(this.context.getCacheDir(), DIRECTORY_NAME);
+        this.maxBytes = configManager.getResultStoreMaxBytes();
+        this.usePng = !"webp".equalsIgnoreCase(configManager.getResultStoreFormat())
+            || Build.VERSION.SDK_INT < Build.VERSION_CODES.R;
+        // 編碼與寫檔在背景單線程進行，不延遲結果顯示
+        this.writer = Executors.newSingleThreadExecutor(r -> {
+            Thread thread = new Thread(r, "ResultStoreWriter");
+            thread.setPriority(Thread.MIN_PRIORITY);
+            return thread;
+        });
+        if (!directory.isDirectory() && !directory.mkdirs()) {
+            Log.w(TAG, "Failed to create " + directory);
+        }
+        // 上次程序中途結束留下的暫存檔（此時不可能有進行中的寫入）
+        writer.execute(this::deleteStaleTemps);
+    }
+
+    /**
+     * 計算結果的key；輸入內容雜湊會依Bitmap實例快取。postProcess 為處理器目前生效的後處理鏈
+     */
+    public String keyFor(Bitmap input, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                         int targetWidth, int targetHeight, PostProcessChain postProcess) {
+        MessageDigest digest = newDigest();
+        digest.update(contentHash(input).getBytes());
+        digest.update(getModelHash().getBytes());
+        digest.update(configFingerprint(mode, useTiling, targetWidth, targetHeight, postProcess).getBytes());
+        return toHex(digest.digest());
+    }
+
+    /**
+     * 有儲存的結果時解碼回傳（並更新其LRU時間），否則回傳null
+     */
+    public Bitmap get(String key) {
+        File file = findFile(key);
+        if (file == null) {
+            return null;
+        }
+
+        long start = System.currentTimeMillis();
+        BitmapFactory.Options options = new BitmapFactory.Options();
+        options.inPreferredConfig = Bitmap.Config.ARGB_8888;
+        options.inMutable = true;
+        Bitmap bitmap = BitmapFactory.decodeFile(file.getAbsolutePath(), options);
+        if (bitmap == null) {
+            Log.w(TAG, "Corrupt stored result, deleting " + file.getName());
+            file.delete();
+            return null;
+        }
+
+        file.setLastModified(System.currentTimeMillis());
+        Log.d(TAG, String.format("Hit %s (%dx%d, %d KB) decoded in %d ms", file.getName(),
+                                 bitmap.getWidth(), bitmap.getHeight(), file.length() / 1024,
+                                 System.currentTimeMillis() - start));
+        return bitmap;
+    }
+
+    /**
+     * 在背景編碼並寫入結果；呼叫端在寫入完成前不可recycle此Bitmap
+     */
+    public void put(String key, Bitmap result) {
+        writer.execute(() -> {
+            try {
+                write(key, result);
+                trim();
+            } catch (IOException | IllegalStateException e) {
+                Log.w(TAG, "Failed to store result " + key, e);
+            }
+        });
+    }
+
+    /**
+     * 分塊處理時串流寫入的結果；commit後才會出現在store中
+     */
+    public final class StreamingWrite {
+        private final String key;
+        private final File temp;
+        private final OutputStream out;
+        private final ImageEncoder.PngRowSink sink;
+
+        StreamingWrite(String key) throws IOException {
+            this.key = key;
+            this.temp = new File(directory, key + ".png" + TEMP_SUFFIX);
+            this.out = new BufferedOutputStream(new FileOutputStream(temp), 256 * 1024);
+            this.sink = new ImageEncoder.PngRowSink(out);
+        }
+
+        public TileProcessor.RowListener getRowListener() {
+            return sink;
+        }
+
+        public void commit() {
+            try {
+                sink.finish();
+                out.close();
+                if (exceedsCapacity(temp)) {
+                    return;
+                }
+                moveIntoPlace(temp, new File(directory, key + ".png"));
+                trim();
+            } catch (IOException e) {
+                Log.w(TAG, "Failed to store streamed result " + key, e);
+                abort();
+            }
+        }
+
+        public void abort() {
+            sink.abort();
+            try {
+                out.close();
+            } catch (IOException ignored) {
+                // 暫存檔即將刪除
+            }
+            temp.delete();
+        }
+    }
+
+    /**
+     * 開始串流寫入（僅PNG格式支援）；不支援時回傳null，改用put()
+     */
+    public StreamingWrite beginStreamingWrite(String key) {
+        if (!usePng) {
+            return null;
+        }
+        try {
+            return new StreamingWrite(key);
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to open streamed result " + key, e);
+            return null;
+        }
+    }
+
+    public void clear() {
+        File[] files = directory.listFiles();
+        if (files != null) {
+            for (File file : files) {
+                file.delete();
+            }
+        }
+    }
+
+    public long getSizeBytes() {
+        long total = 0;
+        File[] files = directory.listFiles();
+        if (files != null) {
+            for (File file : files) {
+                total += file.length();
+            }
+        }
+        return total;
+    }
+
+    public void close() {
+        writer.shutdown();
+    }
+
+    private void write(String key, Bitmap result) throws IOException {
+        String extension = usePng ? ".png" : ".webp";
+        long start = System.currentTimeMillis();
+        File target = new File(directory, key + extension);
+        File temp = new File(directory, key + extension + TEMP_SUFFIX);
+        try (OutputStream out = new BufferedOutputStream(new FileOutputStream(temp), 256 * 1024)) {
+            if (usePng || Build.VERSION.SDK_INT < Build.VERSION_CODES.R) {
+                ImageEncoder.encodePng(result, out);
+            } else {
+                ImageEncoder.encode(result, Bitmap.CompressFormat.WEBP_LOSSLESS, 100, out);
+            }
+        } catch (IOException | RuntimeException e) {
+            temp.delete();
+            throw e;
+        }
+        if (exceedsCapacity(temp)) {
+            return;
+        }
+        moveIntoPlace(temp, target);
+        Log.d(TAG, String.format("Stored %s (%d KB) in %d ms", target.getName(), target.length() / 1024,
+                                 System.currentTimeMillis() - start));
+    }
+
+    /**
+     * 單一結果就超過上限時不儲存（否則trim會把剛寫入的結果連同其他結果一起淘汰）
+     */
+    private boolean exceedsCapacity(File temp) {
+        if (temp.length() <= maxBytes) {
+            return false;
+        }
+        Log.d(TAG, String.format("Not storing %s: %d KB exceeds the %d KB limit", temp.getName(),
+                                 temp.length() / 1024, maxBytes / 1024));
+        temp.delete();
+        return true;
+    }
+
+    /**
+     * 先寫暫存檔再rename，避免中途結束時留下不完整的檔案
+     */
+    private void moveIntoPlace(File temp, File target) throws IOException {
+        if (!temp.renameTo(target)) {
+            temp.delete();
+            throw new IOException("Failed to rename " + temp.getName());
+        }
+    }
+
+    /**
+     * 依最後使用時間淘汰，直到總大小不超過上限；暫存檔可能是進行中的串流寫入，不計入也不淘汰
+     */
+    private synchronized void trim() {
+        File[] files = directory.listFiles(file -> !file.getName().endsWith(TEMP_SUFFIX));
+        if (files == null) {
+            return;
+        }
+        long total = 0;
+        for (File file : files) {
+            total += file.length();
+        }
+        if (total <= maxBytes) {
+            return;
+        }
+
+        Arrays.sort(files, (a, b) -> Long.compare(a.lastModified(), b.lastModified()));
+        for (File file : files) {
+            if (total <= maxBytes) {
+                break;
+            }
+            long length = file.length();
+            if (file.delete()) {
+                total -= length;
+                Log.d(TAG, "Evicted " + file.getName());
+            }
+        }
+    }
+
+    private void deleteStaleTemps() {
+        File[] temps = directory.listFiles(file -> file.getName().endsWith(TEMP_SUFFIX));
+        if (temps != null) {
+            for (File temp : temps) {
+                temp.delete();
+            }
+        }
+    }
+
+    private File findFile(String key) {
+        File webp = new File(directory, key + ".webp");
+        if (webp.isFile()) {
+            return webp;
+        }
+        File png = new File(directory, key + ".png");
+        return png.isFile() ? png : null;
+    }
+
+    /**
+     * 輸入內容雜湊，依Bitmap實例快取；擷取請求序列時也用同一份，不重複計算
+     */
+    String contentHash(Bitmap input) {
+        synchronized (contentHashes) {
+            String cached = contentHashes.get(input);
+            if (cached != null) {
+                return cached;
+            }
+        }
+
+        String hash = hashPixels(input);
+        synchronized (contentHashes) {
+            contentHashes.put(input, hash);
+        }
+        return hash;
+    }
+
+    /**
+     * 輸入內容雜湊（尺寸加上所有像素）；擷取的請求序列也用它標記輸入，兩邊的紀錄可以對照
+     */
+    static String hashPixels(Bitmap input) {
+        int width = input.getWidth();
+        int height = input.getHeight();
+        MessageDigest digest = newDigest();
+        ByteBuffer header = ByteBuffer.allocate(8).order(ByteOrder.BIG_ENDIAN);
+        header.putInt(width).putInt(height);
+        digest.update(header.array());
+
+        // 逐行讀取像素，避免為大圖配置整張int陣列
+        int[] row = new int[width];
+        ByteBuffer rowBytes = ByteBuffer.allocate(width * 4).order(ByteOrder.BIG_ENDIAN);
+        for (int y = 0; y < height; y++) {
+            input.getPixels(row, 0, width, 0, y, width, 1);
+            rowBytes.clear();
+            rowBytes.asIntBuffer().put(row);
+            digest.update(rowBytes.array());
+        }
+        return toHex(digest.digest());
+    }
+
+    private synchronized String getModelHash() {
+        if (modelHash == null) {
+            String modelPath = configManager.getDefaultModelPath();
+            MessageDigest digest = newDigest();
+            byte[] buffer = new byte[64 * 1024];
+            try (InputStream in = context.getAssets().open(modelPath)) {
+                int read;
+                while ((read = in.read(buffer)) > 0) {
+                    digest.update(buffer, 0, read);
+                }
+                modelHash = toHex(digest.digest());
+            } catch (IOException e) {
+                // 無法讀取模型時以路徑代替；不快取，下次再試
+                Log.w(TAG, "Failed to hash model " + modelPath, e);
+                return modelPath;
+            }
+        }
+        return modelHash;
+    }
+
+    private String configFingerprint(ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                                     int targetWidth, int targetHeight, PostProcessChain postProcess) {
+        return String.format(Locale.US,
+            "mode=%s;tiling=%b;overlap=%d;target=%dx%d;targetScale=%.4f;post=%s",
+            mode, useTiling, configManager.getOverlapPixels(), targetWidth, targetHeight,
+            configManager.getTargetOutputScale(), postProcess.describe());
+    }
+
+    private static MessageDigest newDigest() {
+        try {
+            return MessageDigest.getInstance("SHA-256");
+        } catch (NoSuchAlgorithmException e) {
+            throw new IllegalStateException("SHA-256 unavailable", e);
+        }
+    }
+
+    private static String toHex(byte[] bytes) {
+        StringBuilder builder = new StringBuilder(bytes.length * 2);
+        for (byte b : bytes) {
+            builder.append(Character.forDigit((b >> 4) & 0xF, 16));
+            builder.append(Character.forDigit(b & 0xF, 16));
+        }
+        return builder.toString();
+    }
+}
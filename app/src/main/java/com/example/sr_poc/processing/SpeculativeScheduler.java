@@ -0,0 +1,222 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.os.Process;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+/**
+ * 背景預先處理目前顯示的圖片：圖片顯示後延遲一段時間開始超解析度，推理走 SR 線程的低優先權佇列
+ * （只在沒有使用者請求時執行，執行期間推理執行緒降為背景優先權）。
+ * 切換圖片或條件改變時取消（分塊模式在tile之間中止，直接模式在推理各階段之間中止），
+ * 使用者實際要求相同條件的結果時提升為一般佇列並直接接手。
+ */
+public class SpeculativeScheduler {
+
+    private static final String TAG = "SpeculativeScheduler";
+
+    private final ThreadSafeSRProcessor srProcessor;
+    private final ProcessingController renderer;
+    private final long startDelayMs;
+    private final HandlerThread workerThread;
+    private final Handler workerHandler;
+
+    private Job currentJob;
+
+    /**
+     * One speculative render; identified by the exact bitmap instance and the processing parameters
+     */
+    private static final class Job implements Runnable {
+        final Bitmap image;
+        final ThreadSafeSRProcessor.ProcessingMode mode;
+        final boolean useTiling;
+        final int targetWidth;
+        final int targetHeight;
+        final ProcessingController renderer;
+        final AtomicBoolean cancelled = new AtomicBoolean(false);
+        final ThreadSafeSRProcessor.BackgroundToken token = new ThreadSafeSRProcessor.BackgroundToken(cancelled);
+        final CountDownLatch done = new CountDownLatch(1);
+        volatile int threadId;
+        volatile boolean started;
+        Bitmap result;
+        long renderTimeMs;
+
+        Job(Bitmap image, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+            int targetWidth, int targetHeight, ProcessingController renderer) {
+            this.image = image;
+            this.mode = mode;
+            this.useTiling = useTiling;
+            this.targetWidth = targetWidth;
+            this.targetHeight = targetHeight;
+            this.renderer = renderer;
+        }
+
+        boolean matches(Bitmap image, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                        int targetWidth, int targetHeight) {
+            return this.image == image && this.mode == mode && this.useTiling == useTiling
+                && this.targetWidth == targetWidth && this.targetHeight == targetHeight;
+        }
+
+        @Override
+        public void run() {
+            threadId = Process.myTid();
+            started = true;
+            if (token.isPromoted()) {
+                Process.setThreadPriority(Process.THREAD_PRIORITY_DEFAULT);
+            }
+            try {
+                if (cancelled.get()) {
+                    return;
+                }
+                long start = System.currentTimeMillis();
+                Bitmap bitmap = renderer.renderInBackground(image, mode, useTiling, targetWidth, targetHeight, token);
+                renderTimeMs = System.currentTimeMillis() - start;
+                synchronized (this) {
+                    if (cancelled.get()) {
+                        // 最後一個階段之後才取消，結果丟棄
+                        if (bitmap != null) {
+                            bitmap.recycle();
+                        }
+                    } else {
+                        result = bitmap;
+                    }
+                }
+            } catch (Exception | OutOfMemoryError e) {
+                // 在背景線程上的OOM不可讓程序結束，使用者請求時會重新處理
+                Log.w(TAG, "Speculative render failed", e);
+            } finally {
+                // 下一個job的讀取與合成仍從背景優先權開始
+                Process.setThreadPriority(Process.THREAD_PRIORITY_BACKGROUND);
+                done.countDown();
+            }
+        }
+
+        void cancel() {
+            cancelled.set(true);
+            synchronized (this) {
+                if (result != null) {
+                    result.recycle();
+                    result = null;
+                }
+            }
+        }
+    }
+
+    public SpeculativeScheduler(ThreadSafeSRProcessor srProcessor, ProcessingController renderer, long startDelayMs) {
+        this.srProcessor = srProcessor;
+        this.renderer = renderer;
+        this.startDelayMs = startDelayMs;
+        this.workerThread = new HandlerThread("SpeculativeSR", Process.THREAD_PRIORITY_BACKGROUND);
+        this.workerThread.start();
+        this.workerHandler = new Handler(workerThread.getLooper());
+    }
+
+    /**
+     * 圖片顯示時呼叫；相同條件的job已存在則保留，否則取消舊job並排程新的
+     */
+    public synchronized void speculate(Bitmap image, ThreadSafeSRProcessor.ProcessingMode mode, boolean forceTiling) {
+        if (image == null) {
+            return;
+        }
+        ThreadSafeSRProcessor.ProcessingMode resolvedMode = resolve(mode);
+        boolean useTiling = renderer.shouldUseTiling(image, forceTiling);
+        if (currentJob != null && currentJob.matches(image, resolvedMode, useTiling, 0, 0)) {
+            return;
+        }
+        cancelCurrentLocked();
+        // 輸出超過本程序heap時前景只串流出預覽，預先處理會配置完整輸出圖
+        if (useTiling && renderer.previewFactor(image, 0, 0) > 1) {
+            Log.d(TAG, "Not speculating: output exceeds the heap budget");
+            return;
+        }
+
+        currentJob = new Job(image, resolvedMode, useTiling, 0, 0, renderer);
+        workerHandler.postDelayed(currentJob, startDelayMs);
+        Log.d(TAG, "Scheduled speculative " + resolvedMode + (useTiling ? " (tiled)" : "") + " in " + startDelayMs + " ms");
+    }
+
+    /**
+     * 取得相符的預先處理結果：已完成則立即回傳，進行中則提升優先權並等待完成，
+     * 尚未開始則立即執行。不相符時取消舊job並回傳null，由呼叫端走一般流程。
+     * 回傳的Bitmap所有權轉移給呼叫端。
+     */
+    public Bitmap claim(Bitmap image, ThreadSafeSRProcessor.ProcessingMode mode, boolean useTiling,
+                        int targetWidth, int targetHeight) {
+        Job job;
+        synchronized (this) {
+            job = currentJob;
+            if (job == null) {
+                return null;
+            }
+            currentJob = null;
+            if (!job.matches(image, resolve(mode), useTiling, targetWidth, targetHeight)) {
+                job.cancel();
+                return null;
+            }
+
+            if (!job.started) {
+                // 尚未開始：移除延遲並立即執行
+                workerHandler.removeCallbacks(job);
+                workerHandler.postAtFrontOfQueue(job);
+            }
+        }
+
+        promote(job);
+        try {
+            job.done.await();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            job.cancel();
+            return null;
+        }
+
+        synchronized (job) {
+            Bitmap result = job.result;
+            job.result = null;
+            if (result != null) {
+                Log.d(TAG, "Claimed speculative result (rendered in " + job.renderTimeMs + " ms)");
+            }
+            return result;
+        }
+    }
+
+    public synchronized void cancel() {
+        cancelCurrentLocked();
+    }
+
+    public void shutdown() {
+        cancel();
+        workerThread.quitSafely();
+    }
+
+    private void cancelCurrentLocked() {
+        if (currentJob != null) {
+            workerHandler.removeCallbacks(currentJob);
+            currentJob.cancel();
+            currentJob = null;
+        }
+    }
+
+    private void promote(Job job) {
+        // 推理：之後的請求與佇列中尚未執行的請求改走一般佇列，執行中的推理恢復一般優先權
+        srProcessor.promote(job.token);
+        // 讀取tile與合成結果在job執行緒上
+        if (job.started && job.threadId != 0) {
+            try {
+                Process.setThreadPriority(job.threadId, Process.THREAD_PRIORITY_DEFAULT);
+            } catch (IllegalArgumentException | SecurityException e) {
+                Log.w(TAG, "Failed to promote speculative thread", e);
+            }
+        }
+    }
+
+    private ThreadSafeSRProcessor.ProcessingMode resolve(ThreadSafeSRProcessor.ProcessingMode mode) {
+        return mode != null ? mode : srProcessor.getCurrentMode();
+    }
+}
@@ -0,0 +1,210 @@
+package com.example.sr_poc.processing;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.os.Build;
+import android.os.PowerManager;
+import android.util.Log;
+
+import com.example.sr_poc.ConfigManager;
+import com.example.sr_poc.HardwareInfo;
+import com.example.sr_poc.PerformanceMonitor;
+import com.example.sr_poc.utils.MemorySampler;
+import com.example.sr_poc.utils.StageTrace;
+
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * 每個工作一筆結構化紀錄（JSONL），附加到 filesDir/telemetry 下的輪替檔案，供離線彙整整批裝置的效能。
+ * 目前寫入 telemetry.jsonl，超過上限時改名為 telemetry.1.jsonl（依序後移），最多保留 max_files 個檔案。
+ * 取回方式：adb exec-out run-as com.example.sr_poc cat files/telemetry/telemetry.jsonl
+ */
+public class TelemetryLog {
+
+    private static final String TAG = "TelemetryLog";
+    private static final String DIRECTORY_NAME = "telemetry";
+    private static final String ACTIVE_NAME = "telemetry.jsonl";
+    private static final int SCHEMA_VERSION = 1;
+
+    private final ConfigManager configManager;
+    private final PowerManager powerManager;
+    private final File directory;
+    private final long maxFileBytes;
+    private final int maxFiles;
+    private final JSONObject device;
+    private final ExecutorService writer;
+
+    public TelemetryLog(Context context, ConfigManager configManager) {
+        Context appContext = context.getApplicationContext();
+        this.configManager = configManager;
+        this.powerManager = (PowerManager) appContext.getSystemService(Context.POWER_SERVICE);
+        // 放在 filesDir 而非 cacheDir，避免系統清快取時遺失尚未取回的紀錄
+        this.directory = new File(appContext.getFilesDir(), DIRECTORY_NAME);
+        this.maxFileBytes = configManager.getTelemetryMaxFileBytes();
+        this.maxFiles = Math.max(1, configManager.getTelemetryMaxFiles());
+        this.device = deviceProfile();
+        this.writer = Executors.newSingleThreadExecutor(r -> {
+            Thread thread = new Thread(r, "TelemetryWriter");
+            thread.setPriority(Thread.MIN_PRIORITY);
+            return thread;
+        });
+        if (!directory.isDirectory() && !directory.mkdirs()) {
+            Log.w(TAG, "Failed to create " + directory);
+        }
+    }
+
+    /**
+     * 在呼叫端組好紀錄（只讀取已完成的統計），檔案寫入交給背景線程。
+     * 失敗的工作也會記錄，以 status/error 區分；result 可為 null
+     */
+    public void record(PerformanceMonitor.InferenceStats stats, Bitmap result) {
+        String line;
+        try {
+            line = toRecord(stats, result).toString() + "\n";
+        } catch (JSONException e) {
+            Log.w(TAG, "Failed to build telemetry record", e);
+            return;
+        }
+        writer.execute(() -> append(line));
+    }
+
+    public File getDirectory() {
+        return directory;
+    }
+
+    public void close() {
+        writer.shutdown();
+    }
+
+    private JSONObject toRecord(PerformanceMonitor.InferenceStats stats, Bitmap result) throws JSONException {
+        JSONObject record = new JSONObject();
+        record.put("v", SCHEMA_VERSION);
+        record.put("ts", System.currentTimeMillis());
+        record.put("device", device);
+        record.put("model", stats.model);
+        record.put("backend", stats.accelerator);
+        record.put("source", stats.resultSource);
+        record.put("status", stats.status);
+        if (stats.error != null) {
+            record.put("error", stats.error);
+        }
+        record.put("latency_ms", stats.inferenceTime);
+        record.put("input", stats.inputWidth + "x" + stats.inputHeight);
+        record.put("output", stats.outputWidth + "x" + stats.outputHeight);
+        record.put("result_bytes", result != null ? result.getAllocationByteCount() : 0);
+        if (stats.previewFactor > 1) {
+            record.put("preview_factor", stats.previewFactor);
+        }
+
+        JSONObject tiles = new JSONObject();
+        tiles.put("tiled", stats.usedTileProcessing);
+        if (stats.usedTileProcessing) {
+            tiles.put("tile_size", stats.tileSize);
+            tiles.put("tile_count", stats.tilesX * stats.tilesY);
+            tiles.put("grid", stats.tilesX + "x" + stats.tilesY);
+            tiles.put("overlap", configManager.getOverlapPixels());
+        }
+        record.put("tiles", tiles);
+
+        if (stats.stageTrace != null) {
+            JSONObject stages = new JSONObject();
+            for (StageTrace.Stage stage : stats.stageTrace.getStages()) {
+                stages.put(stage.name, stage.getDurationMs());
+            }
+            record.put("stages_ms", stages);
+        }
+
+        MemorySampler.Report memory = stats.memoryReport;
+        JSONObject memoryPeaks = new JSONObject();
+        memoryPeaks.put("before_mb", stats.memoryBefore);
+        memoryPeaks.put("after_mb", stats.memoryAfter);
+        if (memory != null) {
+            memoryPeaks.put("java_kb", memory.peakJavaHeapKb);
+            memoryPeaks.put("native_kb", memory.peakNativeHeapKb);
+            memoryPeaks.put("pss_kb", memory.peakPssKb);
+            memoryPeaks.put("graphics_kb", memory.peakGraphicsKb);
+            memoryPeaks.put("gc", memory.gcCount);
+            memoryPeaks.put("blocking_gc", memory.blockingGcCount);
+        }
+        record.put("memory", memoryPeaks);
+
+        if (stats.energyJoules >= 0) {
+            record.put("joules", stats.energyJoules);
+            record.put("j_per_mp", stats.getJoulesPerOutputMegapixel());
+        }
+        record.put("thermal", thermalStatus());
+        return record;
+    }
+
+    private JSONObject deviceProfile() {
+        JSONObject profile = new JSONObject();
+        try {
+            profile.put("manufacturer", Build.MANUFACTURER);
+            profile.put("model", Build.MODEL);
+            profile.put("soc", HardwareInfo.getSocModel());
+            profile.put("sdk", Build.VERSION.SDK_INT);
+            profile.put("cores", Runtime.getRuntime().availableProcessors());
+            profile.put("max_heap_mb", Runtime.getRuntime().maxMemory() / (1024 * 1024));
+        } catch (JSONException e) {
+            Log.w(TAG, "Failed to build device profile", e);
+        }
+        return profile;
+    }
+
+    /**
+     * PowerManager.THERMAL_STATUS_*（0 = none … 6 = shutdown）；API 29 以下回傳 -1
+     */
+    private int thermalStatus() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q || powerManager == null) {
+            return -1;
+        }
+        return powerManager.getCurrentThermalStatus();
+    }
+
+    private void append(String line) {
+        File active = new File(directory, ACTIVE_NAME);
+        byte[] bytes = line.getBytes(StandardCharsets.UTF_8);
+        if (active.length() > 0 && active.length() + bytes.length > maxFileBytes) {
+            rotate();
+        }
+        try (OutputStream out = new FileOutputStream(active, true)) {
+            out.write(bytes);
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to append telemetry record", e);
+        }
+    }
+
+    /**
+     * telemetry.jsonl -> telemetry.1.jsonl -> ... ；超出保留數量的最舊檔案刪除
+     */
+    private void rotate() {
+        File oldest = rotatedFile(maxFiles - 1);
+        if (oldest.exists() && !oldest.delete()) {
+            Log.w(TAG, "Failed to delete " + oldest);
+        }
+        for (int i = maxFiles - 2; i >= 1; i--) {
+            File from = rotatedFile(i);
+            if (from.exists() && !from.renameTo(rotatedFile(i + 1))) {
+                Log.w(TAG, "Failed to rotate " + from);
+            }
+        }
+        // 只保留一個檔案時 oldest 就是目前檔案，上面已刪除
+        File active = new File(directory, ACTIVE_NAME);
+        if (maxFiles > 1 && !active.renameTo(rotatedFile(1))) {
+            Log.w(TAG, "Failed to rotate " + active);
+        }
+    }
+
+    private File rotatedFile(int index) {
+        return index == 0 ? new File(directory, ACTIVE_NAME) : new File(directory, "telemetry." + index + ".jsonl");
+    }
+}
@@ -0,0 +1,485 @@
+package com.example.sr_poc.processing;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import org.tensorflow.lite.DataType;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+
+import com.example.sr_poc.utils.BitmapConverter;
+
+/**
+ * 依模型輸入/輸出 dtype 特化的轉換管線。
+ * 每個模型只建立一次，只持有該 dtype 組合實際需要的緩衝區，
+ * 推理路徑上不再逐次查詢 tensor 的 dataType。
+ * batchCapacity > 1 時直接緩衝區可容納多張影像（NHWC 的 N 維），暫存陣列仍只有一份。
+ */
+public final class TensorPipeline {
+
+    private static final String TAG = "TensorPipeline";
+
+    private final InputStage inputStage;
+    private final OutputStage outputStage;
+    private final int batchCapacity;
+
+    private TensorPipeline(InputStage inputStage, OutputStage outputStage, int batchCapacity) {
+        this.inputStage = inputStage;
+        this.outputStage = outputStage;
+        this.batchCapacity = batchCapacity;
+    }
+
+    /**
+     * Build the pipeline for the given tensor shapes (NHWC) and data types
+     */
+    public static TensorPipeline create(int[] inputShape, DataType inputType,
+                                        int[] outputShape, DataType outputType,
+                                        BandWorkers workers) {
+        return create(inputShape, inputType, outputShape, outputType, workers, 1);
+    }
+
+    /**
+     * Build a pipeline whose direct buffers hold up to batchCapacity images
+     */
+    public static TensorPipeline create(int[] inputShape, DataType inputType,
+                                        int[] outputShape, DataType outputType,
+                                        BandWorkers workers, int batchCapacity) {
+        int inputWidth = inputShape[2];
+        int inputHeight = inputShape[1];
+        int outputWidth = outputShape[2];
+        int outputHeight = outputShape[1];
+
+        try {
+            InputStage input = createInputStage(inputType, inputWidth, inputHeight, batchCapacity);
+            OutputStage output = createOutputStage(outputType, outputWidth, outputHeight, batchCapacity, workers);
+            TensorPipeline pipeline = new TensorPipeline(input, output, batchCapacity);
+
+            Log.d(TAG, String.format("Pipeline %s x%d: resident %.1fMB (input %.1fMB, output %.1fMB)",
+                pipeline.describe(), batchCapacity,
+                pipeline.getResidentBytes() / (1024.0 * 1024.0),
+                input.residentBytes() / (1024.0 * 1024.0),
+                output.residentBytes() / (1024.0 * 1024.0)));
+            return pipeline;
+
+        } catch (OutOfMemoryError e) {
+            Log.e(TAG, "Out of memory allocating pipeline buffers", e);
+            throw new RuntimeException("Insufficient memory for pipeline buffers", e);
+        }
+    }
+
+    private static InputStage createInputStage(DataType type, int width, int height, int batch) {
+        switch (type) {
+            case FLOAT32:
+                return new Float32Input(width, height, batch);
+            case UINT8:
+                return new Uint8Input(width, height, batch);
+            case INT8:
+                return new Int8Input(width, height, batch);
+            default:
+                throw new IllegalArgumentException("Unsupported input data type: " + type);
+        }
+    }
+
+    private static OutputStage createOutputStage(DataType type, int width, int height, int batch,
+                                                 BandWorkers workers) {
+        switch (type) {
+            case FLOAT32:
+                return new Float32Output(width, height, batch, workers);
+            case UINT8:
+                return new Uint8Output(width, height, batch, workers);
+            case INT8:
+                return new Int8Output(width, height, batch, workers);
+            default:
+                throw new IllegalArgumentException("Unsupported output data type: " + type);
+        }
+    }
+
+    /**
+     * Copy bitmap pixels into the model input buffer (bitmap must match model input size)
+     */
+    public void writeInput(Bitmap bitmap) {
+        writeInput(bitmap, 0);
+    }
+
+    /**
+     * Copy bitmap pixels into batch slot index of the input buffer
+     */
+    public void writeInput(Bitmap bitmap, int index) {
+        bitmap.getPixels(inputStage.pixels, 0, inputStage.width, 0, 0, inputStage.width, inputStage.height);
+        inputStage.convert(index);
+        inputStage.buffer.rewind();
+    }
+
+    /**
+     * Copy model-input-sized ARGB pixels (e.g. a mapped shared-memory view) into batch slot index,
+     * reading from the buffer's position 0
+     */
+    public void writeInput(IntBuffer pixels, int index) {
+        pixels.rewind();
+        pixels.get(inputStage.pixels);
+        inputStage.convert(index);
+        inputStage.buffer.rewind();
+    }
+
+    public ByteBuffer getInputBuffer() {
+        return getInputBuffer(1);
+    }
+
+    public ByteBuffer getOutputBuffer() {
+        return getOutputBuffer(1);
+    }
+
+    /**
+     * Input buffer view sized exactly for a batch of count images
+     */
+    public ByteBuffer getInputBuffer(int count) {
+        return view(inputStage.buffer, inputStage.sliceBytes, count);
+    }
+
+    /**
+     * Output buffer view sized exactly for a batch of count images
+     */
+    public ByteBuffer getOutputBuffer(int count) {
+        return view(outputStage.buffer, outputStage.sliceBytes, count);
+    }
+
+    private ByteBuffer view(ByteBuffer buffer, int sliceBytes, int count) {
+        buffer.rewind();
+        if (count == batchCapacity) {
+            return buffer;
+        }
+        // 解釋器要求緩衝區容量與tensor大小完全一致
+        ByteBuffer duplicate = buffer.duplicate();
+        duplicate.limit(sliceBytes * count);
+        return duplicate.slice().order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Convert the model output buffer into a new ARGB_8888 bitmap
+     */
+    public Bitmap readOutput() {
+        return readOutput(null, 0);
+    }
+
+    public Bitmap readOutput(OutputRegion region) {
+        return readOutput(region, 0);
+    }
+
+    /**
+     * Convert batch slot index of the output buffer into a bitmap covering the given target-grid window.
+     * The window is resampled inside the conversion pass, so the full-scale output is never materialized.
+     */
+    public Bitmap readOutput(OutputRegion region, int index) {
+        if (region == null) {
+            region = outputStage.identity;
+        }
+        Bitmap bitmap = Bitmap.createBitmap(region.width, region.height, Bitmap.Config.ARGB_8888);
+        readOutput(region, index, bitmap);
+        return bitmap;
+    }
+
+    /**
+     * Convert into a caller-owned mutable bitmap at least region-sized; nothing is allocated in steady state
+     */
+    public void readOutput(OutputRegion region, int index, Bitmap dst) {
+        if (region == null) {
+            region = outputStage.identity;
+        }
+        int[] pixels = outputStage.convert(region, index);
+
+        // Bitmap.setPixels 直接從緩存數組複製，避免額外的 int[] 分配
+        dst.setPixels(pixels, 0, region.width, 0, 0, region.width, region.height);
+    }
+
+    /**
+     * Convert into a caller-owned ARGB buffer (row stride region.width) from position 0,
+     * e.g. a mapped shared-memory view, without going through a bitmap
+     */
+    public void readOutput(OutputRegion region, int index, IntBuffer dst) {
+        if (region == null) {
+            region = outputStage.identity;
+        }
+        int[] pixels = outputStage.convert(region, index);
+        dst.rewind();
+        dst.put(pixels, 0, region.width * region.height);
+    }
+
+    public int getOutputWidth() {
+        return outputStage.width;
+    }
+
+    public int getOutputHeight() {
+        return outputStage.height;
+    }
+
+    public int getBatchCapacity() {
+        return batchCapacity;
+    }
+
+    /**
+     * Post ops fused into the output conversion pass
+     */
+    public void setPostProcessChain(PostProcessChain chain) {
+        outputStage.kernel.setChain(chain);
+    }
+
+    public PostProcessChain getPostProcessChain() {
+        return outputStage.kernel.getChain();
+    }
+
+    public long getResidentBytes() {
+        return inputStage.residentBytes() + outputStage.residentBytes();
+    }
+
+    public String describe() {
+        return inputStage.typeName() + "->" + outputStage.typeName();
+    }
+
+    private static ByteBuffer allocateDirect(int bytes) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(bytes);
+        buffer.order(ByteOrder.nativeOrder());
+        return buffer;
+    }
+
+    // ---- Input stages ----
+
+    private abstract static class InputStage {
+        final int width;
+        final int height;
+        final int[] pixels;
+        final int sliceBytes;
+        final ByteBuffer buffer;
+
+        InputStage(int width, int height, int bytesPerElement, int batch) {
+            this.width = width;
+            this.height = height;
+            this.pixels = new int[width * height];
+            this.sliceBytes = width * height * 3 * bytesPerElement;
+            this.buffer = allocateDirect(sliceBytes * batch);
+        }
+
+        /** Convert pixels into batch slot index of the direct buffer */
+        abstract void convert(int index);
+
+        abstract String typeName();
+
+        long residentBytes() {
+            return (long) pixels.length * 4 + buffer.capacity();
+        }
+    }
+
+    private static final class Float32Input extends InputStage {
+        private final float[] floats;
+        private final FloatBuffer floatView;
+
+        Float32Input(int width, int height, int batch) {
+            super(width, height, 4, batch);
+            floats = new float[width * height * 3];
+            floatView = buffer.asFloatBuffer();
+        }
+
+        @Override
+        void convert(int index) {
+            BitmapConverter.convertPixelsToFloat32(pixels, floats);
+            floatView.position(index * floats.length);
+            floatView.put(floats);
+        }
+
+        @Override
+        String typeName() {
+            return "FLOAT32";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + (long) floats.length * 4;
+        }
+    }
+
+    private static final class Uint8Input extends InputStage {
+        private final byte[] bytes;
+
+        Uint8Input(int width, int height, int batch) {
+            super(width, height, 1, batch);
+            bytes = new byte[width * height * 3];
+        }
+
+        @Override
+        void convert(int index) {
+            BitmapConverter.convertPixelsToUint8(pixels, bytes);
+            buffer.position(index * sliceBytes);
+            buffer.put(bytes);
+        }
+
+        @Override
+        String typeName() {
+            return "UINT8";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + bytes.length;
+        }
+    }
+
+    private static final class Int8Input extends InputStage {
+        private final byte[] bytes;
+
+        Int8Input(int width, int height, int batch) {
+            super(width, height, 1, batch);
+            bytes = new byte[width * height * 3];
+        }
+
+        @Override
+        void convert(int index) {
+            BitmapConverter.convertPixelsToInt8(pixels, bytes);
+            buffer.position(index * sliceBytes);
+            buffer.put(bytes);
+        }
+
+        @Override
+        String typeName() {
+            return "INT8";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + bytes.length;
+        }
+    }
+
+    // ---- Output stages ----
+
+    private abstract static class OutputStage {
+        final int width;
+        final int height;
+        final int[] pixels;
+        final int sliceBytes;
+        final ByteBuffer buffer;
+        final OutputKernel kernel;
+        final OutputRegion identity;
+        OutputKernel.Source source;
+        int[] regionPixels;
+
+        OutputStage(int width, int height, int bytesPerElement, int batch, BandWorkers workers) {
+            this.width = width;
+            this.height = height;
+            this.pixels = new int[width * height];
+            this.sliceBytes = width * height * 3 * bytesPerElement;
+            this.buffer = allocateDirect(sliceBytes * batch);
+            this.kernel = new OutputKernel(workers);
+            this.identity = OutputRegion.identity(width, height);
+        }
+
+        /** Copy batch slot index out of the direct buffer into the staging array */
+        abstract void fill(int index);
+
+        /**
+         * Returns the array holding region.width * region.height converted pixels
+         */
+        int[] convert(OutputRegion region, int index) {
+            fill(index);
+            int needed = region.width * region.height;
+            int[] target = pixels;
+            if (needed > pixels.length) {
+                // 放大到比模型倍率更大的目標時才需要額外空間
+                if (regionPixels == null || regionPixels.length < needed) {
+                    regionPixels = new int[needed];
+                }
+                target = regionPixels;
+            }
+            kernel.run(source, region, target);
+            return target;
+        }
+
+        abstract String typeName();
+
+        long residentBytes() {
+            long bytes = (long) pixels.length * 4 + buffer.capacity();
+            return regionPixels != null ? bytes + (long) regionPixels.length * 4 : bytes;
+        }
+    }
+
+    private static final class Float32Output extends OutputStage {
+        private final float[] floats;
+        private final FloatBuffer floatView;
+
+        Float32Output(int width, int height, int batch, BandWorkers workers) {
+            super(width, height, 4, batch, workers);
+            floats = new float[width * height * 3];
+            floatView = buffer.asFloatBuffer();
+            source = OutputKernel.float32(floats, width, height);
+        }
+
+        @Override
+        void fill(int index) {
+            floatView.position(index * floats.length);
+            floatView.get(floats);
+        }
+
+        @Override
+        String typeName() {
+            return "FLOAT32";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + (long) floats.length * 4;
+        }
+    }
+
+    private static final class Uint8Output extends OutputStage {
+        private final byte[] bytes;
+
+        Uint8Output(int width, int height, int batch, BandWorkers workers) {
+            super(width, height, 1, batch, workers);
+            bytes = new byte[width * height * 3];
+            source = OutputKernel.uint8(bytes, width, height);
+        }
+
+        @Override
+        void fill(int index) {
+            buffer.position(index * sliceBytes);
+            buffer.get(bytes);
+        }
+
+        @Override
+        String typeName() {
+            return "UINT8";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + bytes.length;
+        }
+    }
+
+    private static final class Int8Output extends OutputStage {
+        private final byte[] bytes;
+
+        Int8Output(int width, int height, int batch, BandWorkers workers) {
+            super(width, height, 1, batch, workers);
+            bytes = new byte[width * height * 3];
+            source = OutputKernel.int8(bytes, width, height);
+        }
+
+        @Override
+        void fill(int index) {
+            buffer.position(index * sliceBytes);
+            buffer.get(bytes);
+        }
+
+        @Override
+        String typeName() {
+            return "INT8";
+        }
+
+        @Override
+        long residentBytes() {
+            return super.residentBytes() + bytes.length;
+        }
+    }
+}
@@ -0,0 +1,356 @@
+package com.example.sr_poc.processing;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.zip.DataFormatException;
+import java.util.zip.Inflater;
+
+/**
+ * 分塊（或分條）TIFF 來源：只讀取與請求區域相交的 TIFF tile，並以 LRU 快取解壓後的 tile。
+ * 支援 classic TIFF 與 BigTIFF、8-bit 灰階/RGB/RGBA、chunky 排列、無壓縮與 deflate、水平差分 predictor。
+ */
+public final class TiffTileSource implements TileSource {
+
+    private static final int TAG_IMAGE_WIDTH = 256;
+    private static final int TAG_IMAGE_LENGTH = 257;
+    private static final int TAG_BITS_PER_SAMPLE = 258;
+    private static final int TAG_COMPRESSION = 259;
+    private static final int TAG_PHOTOMETRIC = 262;
+    private static final int TAG_STRIP_OFFSETS = 273;
+    private static final int TAG_SAMPLES_PER_PIXEL = 277;
+    private static final int TAG_ROWS_PER_STRIP = 278;
+    private static final int TAG_STRIP_BYTE_COUNTS = 279;
+    private static final int TAG_PLANAR_CONFIGURATION = 284;
+    private static final int TAG_PREDICTOR = 317;
+    private static final int TAG_TILE_WIDTH = 322;
+    private static final int TAG_TILE_LENGTH = 323;
+    private static final int TAG_TILE_OFFSETS = 324;
+    private static final int TAG_TILE_BYTE_COUNTS = 325;
+
+    private static final int COMPRESSION_NONE = 1;
+    private static final int COMPRESSION_ADOBE_DEFLATE = 8;
+    private static final int COMPRESSION_DEFLATE = 32946;
+
+    private final RandomAccessFile file;
+    private final FileChannel channel;
+    private final ByteOrder order;
+    private final boolean bigTiff;
+
+    private final int width;
+    private final int height;
+    private final int samplesPerPixel;
+    private final int compression;
+    private final int predictor;
+    private final int tileWidth;
+    private final int tileHeight;
+    private final int tilesAcross;
+    private final long[] tileOffsets;
+    private final long[] tileByteCounts;
+
+    private final long maxCacheBytes;
+    private long cachedBytes;
+    private final LinkedHashMap<Integer, byte[]> cache = new LinkedHashMap<>(16, 0.75f, true);
+    private final Inflater inflater = new Inflater();
+
+    public TiffTileSource(File path, long maxCacheBytes) throws IOException {
+        this.file = new RandomAccessFile(path, "r");
+        this.channel = file.getChannel();
+        this.maxCacheBytes = maxCacheBytes;
+        try {
+            ByteBuffer header = read(0, 16, ByteOrder.LITTLE_ENDIAN);
+            int byteOrderMark = header.getShort(0) & 0xFFFF;
+            if (byteOrderMark == 0x4949) {
+                order = ByteOrder.LITTLE_ENDIAN;
+            } else if (byteOrderMark == 0x4D4D) {
+                order = ByteOrder.BIG_ENDIAN;
+            } else {
+                throw new IOException("Not a TIFF file");
+            }
+            header.order(order);
+            int magic = header.getShort(2) & 0xFFFF;
+            if (magic == 42) {
+                bigTiff = false;
+            } else if (magic == 43) {
+                bigTiff = true;
+            } else {
+                throw new IOException("Unsupported TIFF magic " + magic);
+            }
+            long ifdOffset = bigTiff ? header.getLong(8) : (header.getInt(4) & 0xFFFFFFFFL);
+
+            Map<Integer, long[]> tags = readIfd(ifdOffset);
+            width = (int) single(tags, TAG_IMAGE_WIDTH, -1);
+            height = (int) single(tags, TAG_IMAGE_LENGTH, -1);
+            samplesPerPixel = (int) single(tags, TAG_SAMPLES_PER_PIXEL, 1);
+            compression = (int) single(tags, TAG_COMPRESSION, COMPRESSION_NONE);
+            predictor = (int) single(tags, TAG_PREDICTOR, 1);
+            int photometric = (int) single(tags, TAG_PHOTOMETRIC, samplesPerPixel >= 3 ? 2 : 1);
+            int planar = (int) single(tags, TAG_PLANAR_CONFIGURATION, 1);
+
+            long[] bits = tags.get(TAG_BITS_PER_SAMPLE);
+            if (bits != null) {
+                for (long b : bits) {
+                    if (b != 8) throw new IOException("Only 8-bit samples are supported");
+                }
+            }
+            if (width <= 0 || height <= 0) {
+                throw new IOException("Missing image dimensions");
+            }
+            if (planar != 1) {
+                throw new IOException("Planar TIFF is not supported");
+            }
+            if (samplesPerPixel != 1 && samplesPerPixel != 3 && samplesPerPixel != 4) {
+                throw new IOException("Unsupported samples per pixel " + samplesPerPixel);
+            }
+            if ((samplesPerPixel == 1 && photometric != 1) || (samplesPerPixel > 1 && photometric != 2)) {
+                throw new IOException("Unsupported photometric interpretation " + photometric);
+            }
+            if (compression != COMPRESSION_NONE && compression != COMPRESSION_ADOBE_DEFLATE
+                && compression != COMPRESSION_DEFLATE) {
+                throw new IOException("Unsupported TIFF compression " + compression);
+            }
+            if (predictor != 1 && predictor != 2) {
+                throw new IOException("Unsupported predictor " + predictor);
+            }
+
+            if (tags.containsKey(TAG_TILE_OFFSETS)) {
+                tileWidth = (int) single(tags, TAG_TILE_WIDTH, -1);
+                tileHeight = (int) single(tags, TAG_TILE_LENGTH, -1);
+                tileOffsets = tags.get(TAG_TILE_OFFSETS);
+                tileByteCounts = tags.get(TAG_TILE_BYTE_COUNTS);
+            } else {
+                // 分條TIFF：每條視為寬度等於整張圖的tile
+                tileWidth = width;
+                tileHeight = (int) Math.min(height, single(tags, TAG_ROWS_PER_STRIP, height));
+                tileOffsets = tags.get(TAG_STRIP_OFFSETS);
+                tileByteCounts = tags.get(TAG_STRIP_BYTE_COUNTS);
+            }
+            if (tileWidth <= 0 || tileHeight <= 0 || tileOffsets == null || tileByteCounts == null) {
+                throw new IOException("Missing tile/strip layout");
+            }
+            tilesAcross = (width + tileWidth - 1) / tileWidth;
+            int tilesDown = (height + tileHeight - 1) / tileHeight;
+            if (tileOffsets.length < (long) tilesAcross * tilesDown) {
+                throw new IOException("Tile offset table too short");
+            }
+        } catch (IOException | RuntimeException e) {
+            close();
+            throw e;
+        }
+    }
+
+    @Override
+    public int getWidth() {
+        return width;
+    }
+
+    @Override
+    public int getHeight() {
+        return height;
+    }
+
+    public int getTileWidth() {
+        return tileWidth;
+    }
+
+    public int getTileHeight() {
+        return tileHeight;
+    }
+
+    @Override
+    public void readRegion(int left, int top, int regionWidth, int regionHeight, int[] dst) throws IOException {
+        int firstColumn = left / tileWidth;
+        int lastColumn = (left + regionWidth - 1) / tileWidth;
+        int firstRow = top / tileHeight;
+        int lastRow = (top + regionHeight - 1) / tileHeight;
+
+        for (int ty = firstRow; ty <= lastRow; ty++) {
+            for (int tx = firstColumn; tx <= lastColumn; tx++) {
+                byte[] tile = loadTile(ty * tilesAcross + tx);
+                int tileLeft = tx * tileWidth;
+                int tileTop = ty * tileHeight;
+
+                int x0 = Math.max(left, tileLeft);
+                int x1 = Math.min(left + regionWidth, Math.min(width, tileLeft + tileWidth));
+                int y0 = Math.max(top, tileTop);
+                int y1 = Math.min(top + regionHeight, Math.min(height, tileTop + tileHeight));
+
+                for (int y = y0; y < y1; y++) {
+                    int src = ((y - tileTop) * tileWidth + (x0 - tileLeft)) * samplesPerPixel;
+                    int out = (y - top) * regionWidth + (x0 - left);
+                    for (int x = x0; x < x1; x++, src += samplesPerPixel) {
+                        dst[out++] = toArgb(tile, src);
+                    }
+                }
+            }
+        }
+    }
+
+    private int toArgb(byte[] tile, int offset) {
+        if (samplesPerPixel == 1) {
+            int v = tile[offset] & 0xFF;
+            return 0xFF000000 | (v << 16) | (v << 8) | v;
+        }
+        int r = tile[offset] & 0xFF;
+        int g = tile[offset + 1] & 0xFF;
+        int b = tile[offset + 2] & 0xFF;
+        int a = samplesPerPixel == 4 ? tile[offset + 3] & 0xFF : 0xFF;
+        return (a << 24) | (r << 16) | (g << 8) | b;
+    }
+
+    private byte[] loadTile(int index) throws IOException {
+        byte[] cached = cache.get(index);
+        if (cached != null) {
+            return cached;
+        }
+
+        int expected = tileWidth * tileHeight * samplesPerPixel;
+        int stored = (int) tileByteCounts[index];
+        byte[] raw = new byte[stored];
+        readFully(tileOffsets[index], raw);
+
+        byte[] pixels;
+        if (compression == COMPRESSION_NONE) {
+            pixels = raw.length >= expected ? raw : Arrays.copyOf(raw, expected);
+        } else {
+            pixels = new byte[expected];
+            inflater.reset();
+            inflater.setInput(raw);
+            try {
+                int total = 0;
+                while (total < expected && !inflater.finished()) {
+                    int n = inflater.inflate(pixels, total, expected - total);
+                    if (n == 0 && (inflater.needsInput() || inflater.needsDictionary())) {
+                        break; // 最後一條strip可能較短
+                    }
+                    total += n;
+                }
+            } catch (DataFormatException e) {
+                throw new IOException("Corrupt deflate data in tile " + index, e);
+            }
+        }
+
+        if (predictor == 2) {
+            undoHorizontalPredictor(pixels);
+        }
+
+        cache.put(index, pixels);
+        cachedBytes += pixels.length;
+        evict();
+        return pixels;
+    }
+
+    private void undoHorizontalPredictor(byte[] pixels) {
+        int rowBytes = tileWidth * samplesPerPixel;
+        for (int row = 0; row < tileHeight; row++) {
+            int base = row * rowBytes;
+            for (int i = samplesPerPixel; i < rowBytes; i++) {
+                pixels[base + i] = (byte) (pixels[base + i] + pixels[base + i - samplesPerPixel]);
+            }
+        }
+    }
+
+    private void evict() {
+        Iterator<Map.Entry<Integer, byte[]>> iterator = cache.entrySet().iterator();
+        while (cachedBytes > maxCacheBytes && cache.size() > 1 && iterator.hasNext()) {
+            cachedBytes -= iterator.next().getValue().length;
+            iterator.remove();
+        }
+    }
+
+    private Map<Integer, long[]> readIfd(long offset) throws IOException {
+        int countSize = bigTiff ? 8 : 2;
+        int entrySize = bigTiff ? 20 : 12;
+        ByteBuffer countBuffer = read(offset, countSize, order);
+        long count = bigTiff ? countBuffer.getLong(0) : (countBuffer.getShort(0) & 0xFFFF);
+        if (count <= 0 || count > 4096) {
+            throw new IOException("Invalid IFD entry count " + count);
+        }
+
+        ByteBuffer entries = read(offset + countSize, (int) count * entrySize, order);
+        Map<Integer, long[]> tags = new HashMap<>();
+        for (int i = 0; i < count; i++) {
+            int base = i * entrySize;
+            int tag = entries.getShort(base) & 0xFFFF;
+            int type = entries.getShort(base + 2) & 0xFFFF;
+            long valueCount = bigTiff ? entries.getLong(base + 4) : (entries.getInt(base + 4) & 0xFFFFFFFFL);
+            int valueFieldOffset = base + (bigTiff ? 12 : 8);
+            int valueFieldSize = bigTiff ? 8 : 4;
+
+            int typeSize = typeSize(type);
+            if (typeSize == 0 || valueCount > Integer.MAX_VALUE / 8) {
+                continue; // 不需要的型別
+            }
+            long byteLength = valueCount * typeSize;
+            ByteBuffer values;
+            if (byteLength <= valueFieldSize) {
+                values = entries.duplicate().order(order);
+                values.position(valueFieldOffset);
+                values = values.slice().order(order);
+            } else {
+                long valuesOffset = bigTiff ? entries.getLong(valueFieldOffset)
+                                            : (entries.getInt(valueFieldOffset) & 0xFFFFFFFFL);
+                values = read(valuesOffset, (int) byteLength, order);
+            }
+
+            long[] parsed = new long[(int) valueCount];
+            for (int v = 0; v < valueCount; v++) {
+                switch (type) {
+                    case 1: parsed[v] = values.get(v) & 0xFF; break;
+                    case 3: parsed[v] = values.getShort(v * 2) & 0xFFFF; break;
+                    case 4: parsed[v] = values.getInt(v * 4) & 0xFFFFFFFFL; break;
+                    default: parsed[v] = values.getLong(v * 8); break;
+                }
+            }
+            tags.put(tag, parsed);
+        }
+        return tags;
+    }
+
+    private static int typeSize(int type) {
+        switch (type) {
+            case 1: return 1;   // BYTE
+            case 3: return 2;   // SHORT
+            case 4: return 4;   // LONG
+            case 16: return 8;  // LONG8 (BigTIFF)
+            default: return 0;
+        }
+    }
+
+    private static long single(Map<Integer, long[]> tags, int tag, long defaultValue) {
+        long[] values = tags.get(tag);
+        return values != null && values.length > 0 ? values[0] : defaultValue;
+    }
+
+    private ByteBuffer read(long position, int length, ByteOrder byteOrder) throws IOException {
+        byte[] bytes = new byte[length];
+        readFully(position, bytes);
+        return ByteBuffer.wrap(bytes).order(byteOrder);
+    }
+
+    private void readFully(long position, byte[] dst) throws IOException {
+        ByteBuffer buffer = ByteBuffer.wrap(dst);
+        while (buffer.hasRemaining()) {
+            int n = channel.read(buffer, position + buffer.position());
+            if (n < 0) {
+                throw new IOException("Unexpected end of TIFF at " + (position + buffer.position()));
+            }
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        inflater.end();
+        cache.clear();
+        channel.close();
+        file.close();
+    }
+}
@@ -0,0 +1,192 @@
+package com.example.sr_poc.processing;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * 分塊幾何規劃：輸入切塊位置、每塊在輸出圖上負責的區域，以及對應的目標網格視窗。
+ * 相鄰分塊的分界落在 overlap 中線，每個輸出像素只由一個分塊寫入。
+ */
+public final class TilePlan {
+
+    /**
+     * One model-sized tile of the input
+     */
+    public static final class Tile {
+        public final int index;
+        public final int column;
+        public final int row;
+
+        // 輸入圖上的實際內容範圍（邊界tile會小於tileSize，需padding）
+        public final int inputLeft;
+        public final int inputTop;
+        public final int inputWidth;
+        public final int inputHeight;
+
+        // 此tile在模型倍率輸出圖上負責的範圍 [left, right)
+        public final int ownLeft;
+        public final int ownTop;
+        public final int ownRight;
+        public final int ownBottom;
+
+        Tile(int index, int column, int row, int inputLeft, int inputTop, int inputWidth, int inputHeight,
+             int ownLeft, int ownTop, int ownRight, int ownBottom) {
+            this.index = index;
+            this.column = column;
+            this.row = row;
+            this.inputLeft = inputLeft;
+            this.inputTop = inputTop;
+            this.inputWidth = inputWidth;
+            this.inputHeight = inputHeight;
+            this.ownLeft = ownLeft;
+            this.ownTop = ownTop;
+            this.ownRight = ownRight;
+            this.ownBottom = ownBottom;
+        }
+    }
+
+    private final int inputWidth;
+    private final int inputHeight;
+    private final int tileSize;
+    private final int overlapPixels;
+    private final int scale;
+    private final int tilesX;
+    private final int tilesY;
+    private final List<Tile> tiles;
+
+    public TilePlan(int inputWidth, int inputHeight, int tileSize, int overlapPixels, int scale) {
+        if (overlapPixels >= tileSize) {
+            throw new IllegalArgumentException("Overlap " + overlapPixels + " must be smaller than tile size " + tileSize);
+        }
+        this.inputWidth = inputWidth;
+        this.inputHeight = inputHeight;
+        this.tileSize = tileSize;
+        this.overlapPixels = overlapPixels;
+        this.scale = scale;
+        this.tilesX = countTiles(inputWidth);
+        this.tilesY = countTiles(inputHeight);
+
+        List<Tile> list = new ArrayList<>(tilesX * tilesY);
+        for (int y = 0; y < tilesY; y++) {
+            for (int x = 0; x < tilesX; x++) {
+                list.add(createTile(list.size(), x, y));
+            }
+        }
+        this.tiles = Collections.unmodifiableList(list);
+    }
+
+    private int countTiles(int length) {
+        if (length <= tileSize) {
+            return 1;
+        }
+        int step = tileSize - overlapPixels;
+        return 1 + (int) Math.ceil((double) (length - tileSize) / step);
+    }
+
+    private Tile createTile(int index, int x, int y) {
+        int step = tileSize - overlapPixels;
+        int left = x * step;
+        int top = y * step;
+        int width = Math.min(tileSize, inputWidth - left);
+        int height = Math.min(tileSize, inputHeight - top);
+
+        return new Tile(index, x, y, left, top, width, height,
+            boundary(x, tilesX, inputWidth), boundary(y, tilesY, inputHeight),
+            boundary(x + 1, tilesX, inputWidth), boundary(y + 1, tilesY, inputHeight));
+    }
+
+    /**
+     * Output coordinate where tile i starts owning pixels (overlap midline)
+     */
+    private int boundary(int i, int count, int inputLength) {
+        if (i <= 0) {
+            return 0;
+        }
+        if (i >= count) {
+            return inputLength * scale;
+        }
+        int step = tileSize - overlapPixels;
+        return (i * step) * scale + (overlapPixels * scale) / 2;
+    }
+
+    public List<Tile> getTiles() {
+        return tiles;
+    }
+
+    public int getTileCount() {
+        return tiles.size();
+    }
+
+    public int getTilesX() {
+        return tilesX;
+    }
+
+    public int getTilesY() {
+        return tilesY;
+    }
+
+    public int getTileSize() {
+        return tileSize;
+    }
+
+    public int getScale() {
+        return scale;
+    }
+
+    public int getOverlapPixels() {
+        return overlapPixels;
+    }
+
+    public int getInputWidth() {
+        return inputWidth;
+    }
+
+    public int getInputHeight() {
+        return inputHeight;
+    }
+
+    public int getOutputWidth() {
+        return inputWidth * scale;
+    }
+
+    public int getOutputHeight() {
+        return inputHeight * scale;
+    }
+
+    /**
+     * Target-grid window written by a tile when the full result is resampled to targetWidth x targetHeight.
+     * Source coordinates are local to the tile's model output.
+     */
+    public OutputRegion regionFor(Tile tile, int targetWidth, int targetHeight) {
+        double sx = (double) targetWidth / getOutputWidth();
+        double sy = (double) targetHeight / getOutputHeight();
+
+        int left = firstTargetPixel(tile.ownLeft, sx);
+        int right = firstTargetPixel(tile.ownRight, sx);
+        int top = firstTargetPixel(tile.ownTop, sy);
+        int bottom = firstTargetPixel(tile.ownBottom, sy);
+        if (tile.ownRight == getOutputWidth()) right = targetWidth;
+        if (tile.ownBottom == getOutputHeight()) bottom = targetHeight;
+
+        double stepX = 1.0 / sx;
+        double stepY = 1.0 / sy;
+        double originX = (left + 0.5) * stepX - 0.5 - (double) tile.inputLeft * scale;
+        double originY = (top + 0.5) * stepY - 0.5 - (double) tile.inputTop * scale;
+        return new OutputRegion(left, top, Math.max(0, right - left), Math.max(0, bottom - top),
+                                originX, originY, stepX, stepY);
+    }
+
+    /**
+     * First target pixel whose centre maps at or beyond the given output coordinate
+     */
+    private static int firstTargetPixel(int outputCoord, double targetScale) {
+        return (int) Math.ceil(outputCoord * targetScale - 0.5);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("TilePlan[%dx%d, tile=%d, overlap=%d, x%d, %dx%d tiles]",
+                             inputWidth, inputHeight, tileSize, overlapPixels, scale, tilesX, tilesY);
+    }
+}
@@ -0,0 +1,20 @@
+package com.example.sr_poc.processing;
+
+import java.io.Closeable;
+import java.io.IOException;
+
+/**
+ * 分塊處理的輸入來源：依需要讀取區域像素，不要求整張圖載入記憶體。
+ * 同一個來源只會被一個線程讀取（TileProcessor 的預讀線程）。
+ */
+public interface TileSource extends Closeable {
+
+    int getWidth();
+
+    int getHeight();
+
+    /**
+     * Reads the given rectangle as ARGB pixels into dst (row stride = width)
+     */
+    void readRegion(int left, int top, int width, int height, int[] dst) throws IOException;
+}
@@ -0,0 +1,165 @@
+package com.example.sr_poc.processing;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+
+/**
+ * 一次分塊處理中每個tile的耗時、執行後端與處理決策，座標為在最終輸出圖上負責的範圍。
+ * 用於比較邊緣與高紋理區域在各 delegate 上的耗時差異（ImageComparisonView 可畫成熱圖）。
+ */
+public final class TileTimings {
+
+    public enum Decision {
+        INFERRED, // 本程序推理
+        ROUTED,   // 交給worker程序
+        RETRIED,  // worker失敗後改在本程序推理
+        SKIPPED,  // 在目標網格上沒有像素，不需推理
+        FAILED
+    }
+
+    public static final class Record {
+        public final int column;
+        public final int row;
+        public final int left;
+        public final int top;
+        public final int width;
+        public final int height;
+        public final long latencyNanos;
+        public final String backend;
+        public final Decision decision;
+
+        Record(int column, int row, int left, int top, int width, int height, long latencyNanos,
+               String backend, Decision decision) {
+            this.column = column;
+            this.row = row;
+            this.left = left;
+            this.top = top;
+            this.width = width;
+            this.height = height;
+            this.latencyNanos = latencyNanos;
+            this.backend = backend;
+            this.decision = decision;
+        }
+    }
+
+    private final int outputWidth;
+    private final int outputHeight;
+    // 以平行陣列保存，分塊迴圈中 add 不配置物件；Record 在讀取時才建立
+    private int count;
+    private int[] columns;
+    private int[] rows;
+    private OutputRegion[] regions;
+    private long[] latencies;
+    private String[] backends;
+    private Decision[] decisions;
+    private List<Record> snapshot;
+    private long maxLatencyNanos;
+    private long minLatencyNanos = Long.MAX_VALUE;
+
+    public TileTimings(int outputWidth, int outputHeight) {
+        this(outputWidth, outputHeight, 16);
+    }
+
+    /**
+     * @param capacity 預期的tile數，超過時才擴充
+     */
+    public TileTimings(int outputWidth, int outputHeight, int capacity) {
+        this.outputWidth = outputWidth;
+        this.outputHeight = outputHeight;
+        allocate(Math.max(1, capacity));
+    }
+
+    public synchronized void add(int column, int row, OutputRegion region, long latencyNanos, String backend,
+                                 Decision decision) {
+        if (count == columns.length) {
+            allocate(count * 2);
+        }
+        columns[count] = column;
+        rows[count] = row;
+        regions[count] = region;
+        latencies[count] = latencyNanos;
+        backends[count] = backend;
+        decisions[count] = decision;
+        count++;
+        snapshot = null;
+        if (decision != Decision.SKIPPED && decision != Decision.FAILED) {
+            maxLatencyNanos = Math.max(maxLatencyNanos, latencyNanos);
+            minLatencyNanos = Math.min(minLatencyNanos, latencyNanos);
+        }
+    }
+
+    public synchronized List<Record> getRecords() {
+        if (snapshot == null) {
+            List<Record> records = new ArrayList<>(count);
+            for (int i = 0; i < count; i++) {
+                OutputRegion region = regions[i];
+                records.add(new Record(columns[i], rows[i], region.left, region.top, region.width, region.height,
+                                       latencies[i], backends[i], decisions[i]));
+            }
+            snapshot = Collections.unmodifiableList(records);
+        }
+        return snapshot;
+    }
+
+    private void allocate(int capacity) {
+        columns = columns == null ? new int[capacity] : Arrays.copyOf(columns, capacity);
+        rows = rows == null ? new int[capacity] : Arrays.copyOf(rows, capacity);
+        regions = regions == null ? new OutputRegion[capacity] : Arrays.copyOf(regions, capacity);
+        latencies = latencies == null ? new long[capacity] : Arrays.copyOf(latencies, capacity);
+        backends = backends == null ? new String[capacity] : Arrays.copyOf(backends, capacity);
+        decisions = decisions == null ? new Decision[capacity] : Arrays.copyOf(decisions, capacity);
+    }
+
+    public int getOutputWidth() {
+        return outputWidth;
+    }
+
+    public int getOutputHeight() {
+        return outputHeight;
+    }
+
+    public synchronized long getMaxLatencyNanos() {
+        return maxLatencyNanos;
+    }
+
+    /**
+     * 沒有任何推理過的tile時回傳 0
+     */
+    public synchronized long getMinLatencyNanos() {
+        return minLatencyNanos == Long.MAX_VALUE ? 0 : minLatencyNanos;
+    }
+
+    @Override
+    public synchronized String toString() {
+        long[] inferred = new long[count];
+        int inferredCount = 0;
+        int skipped = 0;
+        int failed = 0;
+        int slowest = -1;
+        for (int i = 0; i < count; i++) {
+            if (decisions[i] == Decision.SKIPPED) {
+                skipped++;
+            } else if (decisions[i] == Decision.FAILED) {
+                failed++;
+            } else {
+                inferred[inferredCount++] = latencies[i];
+                if (slowest < 0 || latencies[i] > latencies[slowest]) {
+                    slowest = i;
+                }
+            }
+        }
+        if (slowest < 0) {
+            return String.format(Locale.US, "%d tiles, none inferred (%d skipped, %d failed)",
+                                 count, skipped, failed);
+        }
+        long[] sorted = Arrays.copyOf(inferred, inferredCount);
+        Arrays.sort(sorted);
+        return String.format(Locale.US,
+            "%d tiles: p50 %.1fms, max %.1fms at (%d,%d) on %s, %d skipped, %d failed",
+            count, sorted[(inferredCount - 1) / 2] / 1e6, latencies[slowest] / 1e6,
+            columns[slowest], rows[slowest], backends[slowest], skipped, failed);
+    }
+}
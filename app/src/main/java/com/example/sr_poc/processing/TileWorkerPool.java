@@ -0,0 +1,278 @@
+package com.example.sr_poc.processing;
+
+import android.annotation.TargetApi;
+import android.content.ComponentName;
+import android.content.Context;
+import android.content.Intent;
+import android.content.ServiceConnection;
+import android.graphics.Bitmap;
+import android.os.Build;
+import android.os.IBinder;
+import android.os.Parcel;
+import android.os.RemoteException;
+import android.os.SharedMemory;
+import android.system.ErrnoException;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.io.Closeable;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 管理多個 TileWorkerService 程序。每個worker有自己的heap（不受本程序 maxMemory 限制），
+ * 崩潰只影響該worker：進行中的tile回報失敗（由 TileProcessor 改在本程序重跑），worker重新綁定。
+ */
+@TargetApi(Build.VERSION_CODES.Q)
+public final class TileWorkerPool implements Closeable {
+
+    private static final String TAG = "TileWorkerPool";
+    private static final long CONNECT_TIMEOUT_SECONDS = 10;
+
+    private final Context context;
+    private final Worker[] workers;
+    private final BlockingQueue<Worker> idle;
+    private final ExecutorService executor;
+    private volatile boolean closed;
+
+    /**
+     * bindIsolatedService 需要 API 29
+     */
+    public static boolean isSupported() {
+        return Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q;
+    }
+
+    public TileWorkerPool(Context context, int workerCount) {
+        this.context = context.getApplicationContext();
+        this.workers = new Worker[workerCount];
+        this.idle = new ArrayBlockingQueue<>(workerCount);
+        AtomicInteger counter = new AtomicInteger();
+        this.executor = Executors.newFixedThreadPool(workerCount,
+            r -> new Thread(r, "TileWorkerClient-" + counter.incrementAndGet()));
+
+        for (int i = 0; i < workerCount; i++) {
+            workers[i] = new Worker("worker" + i);
+            workers[i].bind();
+            idle.add(workers[i]);
+        }
+    }
+
+    public int getWorkerCount() {
+        return workers.length;
+    }
+
+    /**
+     * worker處理一個tile的結果
+     */
+    public static final class Result {
+        public final Bitmap bitmap;      // region大小
+        public final long workerNanos;   // worker程序內的處理耗時，不含等待空閒worker與傳輸
+
+        Result(Bitmap bitmap, long workerNanos) {
+            this.bitmap = bitmap;
+            this.workerNanos = workerNanos;
+        }
+    }
+
+    /**
+     * 非同步處理一個已補齊的tile（tileSize x tileSize ARGB）
+     */
+    public Future<Result> submit(int[] pixels, int tileSize, OutputRegion region,
+                                 ThreadSafeSRProcessor.ProcessingMode mode) {
+        return executor.submit(() -> {
+            Worker worker = idle.take();
+            try {
+                return worker.run(pixels, tileSize, region, mode);
+            } finally {
+                idle.put(worker);
+            }
+        });
+    }
+
+    @Override
+    public void close() {
+        closed = true;
+        executor.shutdownNow();
+        for (Worker worker : workers) {
+            worker.unbind();
+        }
+    }
+
+    private final class Worker implements ServiceConnection {
+        private final String instanceName;
+        private volatile IBinder binder;
+        private volatile CountDownLatch connected = new CountDownLatch(1);
+
+        // 以下只在持有此worker的執行緒存取
+        private SharedMemory inputMemory;
+        private SharedMemory outputMemory;
+        private ByteBuffer input;
+        private ByteBuffer output;
+        private IntBuffer inputPixels;
+        private IntBuffer outputPixels;
+        private int[] resultPixels;
+        private int initializedTileSize;
+        private IBinder initializedBinder;
+
+        Worker(String instanceName) {
+            this.instanceName = instanceName;
+        }
+
+        void bind() {
+            Intent intent = new Intent(context, TileWorkerService.class);
+            if (!context.bindIsolatedService(intent, Context.BIND_AUTO_CREATE, instanceName,
+                                             Runnable::run, this)) {
+                Log.e(TAG, "Cannot bind " + instanceName);
+            }
+        }
+
+        void unbind() {
+            try {
+                context.unbindService(this);
+            } catch (IllegalArgumentException e) {
+                // 未曾綁定成功
+            }
+            releaseBuffers();
+        }
+
+        Result run(int[] pixels, int tileSize, OutputRegion region, ThreadSafeSRProcessor.ProcessingMode mode)
+                throws IOException, InterruptedException, ErrnoException {
+            IBinder remote = awaitBinder();
+            int outputBytes = region.width * region.height * 4;
+            if (remote != initializedBinder || initializedTileSize != tileSize || output.capacity() < outputBytes) {
+                init(remote, tileSize, outputBytes);
+            }
+
+            // tile像素直接寫入共享記憶體，worker從映射轉進輸入tensor
+            inputPixels.clear();
+            inputPixels.put(pixels, 0, tileSize * tileSize);
+
+            long workerNanos;
+            Parcel data = Parcel.obtain();
+            Parcel reply = Parcel.obtain();
+            try {
+                data.writeInterfaceToken(TileWorkerService.DESCRIPTOR);
+                data.writeString(mode != null ? mode.name() : "");
+                data.writeInt(region.left);
+                data.writeInt(region.top);
+                data.writeInt(region.width);
+                data.writeInt(region.height);
+                data.writeDouble(region.originX);
+                data.writeDouble(region.originY);
+                data.writeDouble(region.stepX);
+                data.writeDouble(region.stepY);
+                transact(remote, TileWorkerService.TRANSACTION_RUN, data, reply);
+                workerNanos = reply.readLong();
+            } finally {
+                data.recycle();
+                reply.recycle();
+            }
+
+            // worker已把結果轉換寫入輸出映射（ARGB，列寬region.width）
+            int count = region.width * region.height;
+            if (resultPixels == null || resultPixels.length < count) {
+                resultPixels = new int[count];
+            }
+            outputPixels.clear();
+            outputPixels.get(resultPixels, 0, count);
+            Bitmap result = Bitmap.createBitmap(region.width, region.height, Bitmap.Config.ARGB_8888);
+            result.setPixels(resultPixels, 0, region.width, 0, 0, region.width, region.height);
+            return new Result(result, workerNanos);
+        }
+
+        private void init(IBinder remote, int tileSize, int outputBytes) throws IOException, ErrnoException {
+            releaseBuffers();
+            inputMemory = SharedMemory.create(instanceName + "-in", tileSize * tileSize * 4);
+            outputMemory = SharedMemory.create(instanceName + "-out", outputBytes);
+            input = inputMemory.mapReadWrite();
+            output = outputMemory.mapReadWrite();
+            inputPixels = input.order(ByteOrder.nativeOrder()).asIntBuffer();
+            outputPixels = output.order(ByteOrder.nativeOrder()).asIntBuffer();
+
+            Parcel data = Parcel.obtain();
+            Parcel reply = Parcel.obtain();
+            try {
+                data.writeInterfaceToken(TileWorkerService.DESCRIPTOR);
+                data.writeParcelable(inputMemory, 0);
+                data.writeParcelable(outputMemory, 0);
+                transact(remote, TileWorkerService.TRANSACTION_INIT, data, reply);
+            } finally {
+                data.recycle();
+                reply.recycle();
+            }
+            initializedBinder = remote;
+            initializedTileSize = tileSize;
+        }
+
+        private void transact(IBinder remote, int code, Parcel data, Parcel reply) throws IOException {
+            try {
+                remote.transact(code, data, reply, 0);
+            } catch (RemoteException e) {
+                // 多半是worker程序已死；等onBindingDied/onServiceDisconnected後重新連線
+                throw new IOException(instanceName + " transaction failed", e);
+            }
+            if (reply.readInt() == 0) {
+                throw new IOException(instanceName + ": " + reply.readString());
+            }
+        }
+
+        private IBinder awaitBinder() throws IOException, InterruptedException {
+            if (!connected.await(CONNECT_TIMEOUT_SECONDS, TimeUnit.SECONDS) || binder == null) {
+                throw new IOException(instanceName + " not connected");
+            }
+            return binder;
+        }
+
+        private void releaseBuffers() {
+            if (input != null) {
+                SharedMemory.unmap(input);
+                SharedMemory.unmap(output);
+                inputMemory.close();
+                outputMemory.close();
+                input = null;
+                output = null;
+                inputPixels = null;
+                outputPixels = null;
+            }
+            initializedTileSize = 0;
+            initializedBinder = null;
+        }
+
+        @Override
+        public void onServiceConnected(ComponentName name, IBinder service) {
+            binder = service;
+            connected.countDown();
+            Log.d(TAG, instanceName + " connected");
+        }
+
+        @Override
+        public void onServiceDisconnected(ComponentName name) {
+            // 程序崩潰；系統會自動重啟並再次呼叫onServiceConnected
+            Log.w(TAG, instanceName + " disconnected");
+            binder = null;
+            connected = new CountDownLatch(1);
+        }
+
+        @Override
+        public void onBindingDied(ComponentName name) {
+            Log.w(TAG, instanceName + " binding died, rebinding");
+            binder = null;
+            connected = new CountDownLatch(1);
+            context.unbindService(this);
+            if (!closed) {
+                bind();
+            }
+        }
+    }
+}
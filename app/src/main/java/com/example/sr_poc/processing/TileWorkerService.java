@@ -0,0 +1,208 @@
+package com.example.sr_poc.processing;
+
+import android.annotation.TargetApi;
+import android.app.Service;
+import android.content.Intent;
+import android.graphics.Bitmap;
+import android.os.Binder;
+import android.os.Build;
+import android.os.IBinder;
+import android.os.Parcel;
+import android.os.SharedMemory;
+import android.system.ErrnoException;
+import android.util.Log;
+
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 在獨立(isolated)程序中執行tile推理的服務，每個實例有自己的heap與interpreter。
+ * tile像素經由 SharedMemory 傳遞，Binder只傳送區域參數；協定見 TRANSACTION_* 常數。
+ * 兩端以原生位元組序的 int 檢視映射區（ARGB），推理直接從輸入映射轉進 tensor、把結果寫進輸出映射，不經過 Bitmap。
+ */
+@TargetApi(Build.VERSION_CODES.Q)
+public class TileWorkerService extends Service {
+
+    private static final String TAG = "TileWorkerService";
+
+    static final String DESCRIPTOR = "com.example.sr_poc.processing.TileWorker";
+
+    /** in: SharedMemory input（tileSize²個ARGB）, SharedMemory output；out: int ok, String error */
+    static final int TRANSACTION_INIT = IBinder.FIRST_CALL_TRANSACTION;
+    /**
+     * in: String mode（空字串表示預設）, OutputRegion 欄位；out: int ok, String error,
+     * long 本tile在worker內的處理耗時（ns，從送進處理器到結果寫入輸出映射，不含客戶端排隊）
+     */
+    static final int TRANSACTION_RUN = IBinder.FIRST_CALL_TRANSACTION + 1;
+
+    private static final long INIT_TIMEOUT_SECONDS = 60;
+    private static final long TILE_TIMEOUT_SECONDS = 30;
+
+    private ThreadSafeSRProcessor processor;
+    private SharedMemory inputMemory;
+    private SharedMemory outputMemory;
+    private ByteBuffer input;
+    private ByteBuffer output;
+    private IntBuffer inputPixels;
+    private IntBuffer outputPixels;
+    // 上一個tile的推理；逾時後SR線程可能仍在寫輸出映射，下一次使用前須等它結束
+    private CountDownLatch previous;
+    private long lastTileNanos;
+
+    private final Binder binder = new Binder() {
+        @Override
+        protected boolean onTransact(int code, Parcel data, Parcel reply, int flags) {
+            if (code != TRANSACTION_INIT && code != TRANSACTION_RUN) {
+                return false;
+            }
+            data.enforceInterface(DESCRIPTOR);
+            String error;
+            try {
+                error = code == TRANSACTION_INIT ? init(data) : run(data);
+            } catch (RuntimeException | ErrnoException | OutOfMemoryError e) {
+                Log.e(TAG, "Transaction " + code + " failed", e);
+                error = e.toString();
+            }
+            reply.writeInt(error == null ? 1 : 0);
+            reply.writeString(error);
+            if (code == TRANSACTION_RUN) {
+                reply.writeLong(error == null ? lastTileNanos : 0);
+            }
+            return true;
+        }
+    };
+
+    @Override
+    public IBinder onBind(Intent intent) {
+        return binder;
+    }
+
+    private synchronized String init(Parcel data) throws ErrnoException {
+        SharedMemory newInput = data.readParcelable(SharedMemory.class.getClassLoader());
+        SharedMemory newOutput = data.readParcelable(SharedMemory.class.getClassLoader());
+        if (!awaitPrevious()) {
+            newInput.close();
+            newOutput.close();
+            return "Previous tile still running";
+        }
+
+        releaseBuffers();
+        inputMemory = newInput;
+        outputMemory = newOutput;
+        input = inputMemory.mapReadOnly();
+        output = outputMemory.mapReadWrite();
+        inputPixels = input.order(ByteOrder.nativeOrder()).asIntBuffer();
+        outputPixels = output.order(ByteOrder.nativeOrder()).asIntBuffer();
+
+        if (processor != null) {
+            return null;
+        }
+        processor = new ThreadSafeSRProcessor(this);
+        CountDownLatch latch = new CountDownLatch(1);
+        String[] failure = new String[1];
+        processor.initialize((success, message) -> {
+            if (!success) {
+                failure[0] = message;
+            }
+            latch.countDown();
+        });
+        if (!await(latch, INIT_TIMEOUT_SECONDS)) {
+            return "Worker init timed out";
+        }
+        Log.d(TAG, "Worker ready: " + processor.getAcceleratorInfo());
+        return failure[0];
+    }
+
+    private synchronized String run(Parcel data) {
+        if (processor == null) {
+            return "Worker not initialized";
+        }
+        String modeName = data.readString();
+        ThreadSafeSRProcessor.ProcessingMode mode = modeName == null || modeName.isEmpty()
+            ? null : ThreadSafeSRProcessor.ProcessingMode.valueOf(modeName);
+        OutputRegion region = new OutputRegion(data.readInt(), data.readInt(), data.readInt(), data.readInt(),
+                                               data.readDouble(), data.readDouble(),
+                                               data.readDouble(), data.readDouble());
+
+        if (!awaitPrevious()) {
+            return "Previous tile still running";
+        }
+
+        CountDownLatch latch = new CountDownLatch(1);
+        String[] failure = new String[1];
+        boolean[] succeeded = new boolean[1];
+        long[] elapsed = new long[1];
+        previous = latch;
+        lastTileNanos = 0;
+        long start = System.nanoTime();
+        processor.processPixels(inputPixels, outputPixels, mode, region, new ThreadSafeSRProcessor.InferenceCallback() {
+            @Override
+            public void onResult(Bitmap unused, long inferenceTime) {
+                elapsed[0] = System.nanoTime() - start;
+                succeeded[0] = true;
+                latch.countDown();
+            }
+
+            @Override
+            public void onError(String error) {
+                failure[0] = error;
+                latch.countDown();
+            }
+        });
+        if (!await(latch, TILE_TIMEOUT_SECONDS)) {
+            return "Tile timed out";
+        }
+        previous = null;
+        if (!succeeded[0]) {
+            return failure[0] != null ? failure[0] : "No result";
+        }
+        lastTileNanos = elapsed[0];
+        return null;
+    }
+
+    private boolean awaitPrevious() {
+        if (previous != null && !await(previous, TILE_TIMEOUT_SECONDS)) {
+            return false;
+        }
+        previous = null;
+        return true;
+    }
+
+    private static boolean await(CountDownLatch latch, long seconds) {
+        try {
+            return latch.await(seconds, TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return false;
+        }
+    }
+
+    private void releaseBuffers() {
+        if (input != null) {
+            SharedMemory.unmap(input);
+            SharedMemory.unmap(output);
+            inputMemory.close();
+            outputMemory.close();
+            input = null;
+            output = null;
+            inputPixels = null;
+            outputPixels = null;
+        }
+    }
+
+    @Override
+    public synchronized void onDestroy() {
+        super.onDestroy();
+        // 先結束SR線程，確保沒有推理仍在寫輸出映射
+        if (processor != null) {
+            processor.close();
+            processor = null;
+        }
+        releaseBuffers();
+    }
+}
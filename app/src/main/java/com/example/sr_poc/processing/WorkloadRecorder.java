@@ -0,0 +1,156 @@
+package com.example.sr_poc.processing;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.os.SystemClock;
+import android.util.Log;
+
+import com.example.sr_poc.ConfigManager;
+import com.example.sr_poc.ThreadSafeSRProcessor;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.util.HashSet;
+import java.util.Set;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * 擷取模式：記錄每個請求的參數、時間點與輸入雜湊（格式見 WorkloadTrace），
+ * 寫到 filesDir/workload/workload-{開始時間}.tsv；設定 capture_inputs 時輸入另存為 inputs/{雜湊}.png。
+ * 回放：裝置上用 WorkloadReplayer，主機上用 host 的 WorkloadReplay 對守護程序送出。
+ */
+public class WorkloadRecorder {
+
+    private static final String TAG = "WorkloadRecorder";
+    private static final String DIRECTORY_NAME = "workload";
+    private static final String INPUTS_DIRECTORY = "inputs";
+
+    private final File directory;
+    private final File traceFile;
+    private final boolean captureInputs;
+    private final ExecutorService writer;
+    private final Set<String> capturedInputs = new HashSet<>();
+
+    private long originMs = -1;
+
+    public WorkloadRecorder(Context context, ConfigManager configManager) {
+        this.directory = new File(context.getApplicationContext().getFilesDir(), DIRECTORY_NAME);
+        this.traceFile = new File(directory, "workload-" + System.currentTimeMillis() + ".tsv");
+        this.captureInputs = configManager.isWorkloadCaptureInputs();
+        this.writer = Executors.newSingleThreadExecutor(r -> {
+            Thread thread = new Thread(r, "WorkloadWriter");
+            thread.setPriority(Thread.MIN_PRIORITY);
+            return thread;
+        });
+        File required = captureInputs ? new File(directory, INPUTS_DIRECTORY) : directory;
+        if (!required.isDirectory() && !required.mkdirs()) {
+            Log.w(TAG, "Failed to create " + required);
+        }
+        writer.execute(() -> append(WorkloadTrace.HEADER));
+    }
+
+    /**
+     * 在請求開始處理前呼叫。inputHash 為 ResultStore 依實例快取的內容雜湊（未啟用結果儲存時為 null）。
+     * 呼叫端線程不計算雜湊也不編碼：擷取輸入時只複製一份，雜湊與 PNG 編碼在寫入線程進行；
+     * 沒有雜湊又不擷取時以 Bitmap 實例標記輸入（回放時同一標記共用一張合成影像）。
+     */
+    public void record(Bitmap input, String inputHash, ThreadSafeSRProcessor.ProcessingMode mode,
+                       boolean forceTiling, int targetWidth, int targetHeight) {
+        long offsetMs;
+        synchronized (this) {
+            long now = SystemClock.elapsedRealtime();
+            if (originMs < 0) {
+                originMs = now;
+            }
+            offsetMs = now - originMs;
+        }
+
+        int width = input.getWidth();
+        int height = input.getHeight();
+        String modeName = mode != null ? mode.name() : null;
+        Bitmap copy = captureInputs && (inputHash == null || !isCaptured(inputHash))
+            ? input.copy(Bitmap.Config.ARGB_8888, false) : null;
+        // null 表示在寫入線程由副本計算
+        String hash = inputHash != null ? inputHash : copy == null ? instanceTag(input) : null;
+
+        writer.execute(() -> {
+            String entryHash = hash != null ? hash : ResultStore.hashPixels(copy);
+            String inputFile = null;
+            if (captureInputs) {
+                String path = INPUTS_DIRECTORY + "/" + entryHash + ".png";
+                boolean captured = copy != null ? captureInput(copy, entryHash, new File(directory, path))
+                                                : isCaptured(entryHash);
+                if (captured) {
+                    inputFile = path;
+                }
+            }
+            if (copy != null) {
+                copy.recycle();
+            }
+            append(new WorkloadTrace.Entry(offsetMs, width, height, modeName, forceTiling, targetWidth,
+                                           targetHeight, entryHash, inputFile).toLine());
+        });
+    }
+
+    public File getTraceFile() {
+        return traceFile;
+    }
+
+    public void close() {
+        writer.shutdown();
+    }
+
+    private boolean isCaptured(String hash) {
+        synchronized (capturedInputs) {
+            return capturedInputs.contains(hash);
+        }
+    }
+
+    private static String instanceTag(Bitmap input) {
+        return "bitmap-" + Integer.toHexString(System.identityHashCode(input));
+    }
+
+    /**
+     * 同一輸入只存一次（在寫入線程執行）
+     */
+    private boolean captureInput(Bitmap input, String hash, File target) {
+        synchronized (capturedInputs) {
+            if (capturedInputs.contains(hash) || target.isFile()) {
+                capturedInputs.add(hash);
+                return true;
+            }
+        }
+        File temp = new File(target.getPath() + ".tmp");
+        try (OutputStream out = new BufferedOutputStream(new FileOutputStream(temp), 256 * 1024)) {
+            ImageEncoder.encodePng(input, out);
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to capture input " + hash, e);
+            temp.delete();
+            return false;
+        }
+        if (!temp.renameTo(target)) {
+            temp.delete();
+            return target.isFile();
+        }
+        synchronized (capturedInputs) {
+            capturedInputs.add(hash);
+        }
+        return true;
+    }
+
+    private void append(String line) {
+        try (Writer out = new OutputStreamWriter(new FileOutputStream(traceFile, true), StandardCharsets.UTF_8)) {
+            out.write(line);
+            out.write('\n');
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to append to " + traceFile, e);
+        }
+    }
+}
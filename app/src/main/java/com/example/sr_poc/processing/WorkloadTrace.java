@@ -0,0 +1,102 @@
+package com.example.sr_poc.processing;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Locale;
+
+/**
+ * 擷取的請求序列格式（App 與主機共用）：每行一個請求，以 tab 分隔，# 開頭為註解。
+ * <pre>
+ * offset_ms  width  height  mode  tiling  target_width  target_height  input_hash  input_file
+ * </pre>
+ * mode 為 ProcessingMode 名稱或 AUTO；input_hash 為輸入內容雜湊，既無結果儲存也未擷取輸入時為
+ * "bitmap-" 開頭的實例標記；input_file 為相對於紀錄檔目錄的路徑，未擷取輸入時為 "-"。
+ */
+public final class WorkloadTrace {
+
+    public static final String HEADER = "# sr-workload v1\toffset_ms\twidth\theight\tmode\ttiling"
+        + "\ttarget_width\ttarget_height\tinput_hash\tinput_file";
+    public static final String AUTO_MODE = "AUTO";
+    private static final String NO_FILE = "-";
+
+    public static final class Entry {
+        public final long offsetMs;
+        public final int width;
+        public final int height;
+        public final String mode;
+        public final boolean tiling;
+        public final int targetWidth;
+        public final int targetHeight;
+        public final String inputHash;
+        public final String inputFile; // 未擷取輸入時為 null
+
+        public Entry(long offsetMs, int width, int height, String mode, boolean tiling,
+                     int targetWidth, int targetHeight, String inputHash, String inputFile) {
+            this.offsetMs = offsetMs;
+            this.width = width;
+            this.height = height;
+            this.mode = mode != null ? mode : AUTO_MODE;
+            this.tiling = tiling;
+            this.targetWidth = targetWidth;
+            this.targetHeight = targetHeight;
+            this.inputHash = inputHash;
+            this.inputFile = inputFile;
+        }
+
+        public String toLine() {
+            return String.format(Locale.US, "%d\t%d\t%d\t%s\t%b\t%d\t%d\t%s\t%s", offsetMs, width, height, mode,
+                                 tiling, targetWidth, targetHeight, inputHash,
+                                 inputFile != null ? inputFile : NO_FILE);
+        }
+
+        public static Entry parse(String line) {
+            String[] fields = line.split("\t");
+            if (fields.length != 9) {
+                throw new IllegalArgumentException("Expected 9 fields, got " + fields.length + ": " + line);
+            }
+            return new Entry(Long.parseLong(fields[0]), Integer.parseInt(fields[1]), Integer.parseInt(fields[2]),
+                             fields[3], Boolean.parseBoolean(fields[4]), Integer.parseInt(fields[5]),
+                             Integer.parseInt(fields[6]), fields[7], NO_FILE.equals(fields[8]) ? null : fields[8]);
+        }
+    }
+
+    private WorkloadTrace() {
+        // Prevent instantiation
+    }
+
+    /**
+     * 依 offset 排序後回傳（並行請求寫入的順序不一定與開始時間一致）
+     */
+    public static List<Entry> read(File file) throws IOException {
+        List<Entry> entries = new ArrayList<>();
+        try (BufferedReader reader = new BufferedReader(
+                new InputStreamReader(new FileInputStream(file), StandardCharsets.UTF_8))) {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                if (!line.isEmpty() && !line.startsWith("#")) {
+                    entries.add(Entry.parse(line));
+                }
+            }
+        }
+        entries.sort(Comparator.comparingLong(entry -> entry.offsetMs));
+        return entries;
+    }
+
+    /**
+     * 回放時的輸入檔；未擷取輸入或檔案不存在時回傳 null（改用紀錄的尺寸產生合成影像）
+     */
+    public static File inputFileFor(File traceFile, Entry entry) {
+        if (entry.inputFile == null) {
+            return null;
+        }
+        File input = new File(traceFile.getAbsoluteFile().getParentFile(), entry.inputFile);
+        return input.isFile() ? input : null;
+    }
+}
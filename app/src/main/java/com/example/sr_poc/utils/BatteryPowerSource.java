@@ -0,0 +1,64 @@
+package com.example.sr_poc.utils;
+
+import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
+import android.os.BatteryManager;
+
+/**
+ * 由 BatteryManager 的瞬時電流與電池電壓估算整機功率。
+ * 充電中量到的是淨電流，量測能耗時應拔除充電器。
+ */
+public final class BatteryPowerSource implements EnergyMeter.PowerSource {
+
+    private static final long VOLTAGE_REFRESH_NANOS = 1_000_000_000L;
+
+    private final Context context;
+    private final BatteryManager batteryManager;
+    private double cachedVolts = -1;
+    private long voltageReadNanos;
+
+    public BatteryPowerSource(Context context) {
+        this.context = context.getApplicationContext();
+        this.batteryManager = (BatteryManager) context.getSystemService(Context.BATTERY_SERVICE);
+    }
+
+    /**
+     * 部分裝置不提供 CURRENT_NOW（回傳 0 或 Integer.MIN_VALUE）
+     */
+    public boolean isSupported() {
+        if (batteryManager == null) {
+            return false;
+        }
+        int current = batteryManager.getIntProperty(BatteryManager.BATTERY_PROPERTY_CURRENT_NOW);
+        return current != 0 && current != Integer.MIN_VALUE && readVolts() > 0;
+    }
+
+    @Override
+    public synchronized double readWatts() {
+        if (batteryManager == null) {
+            return -1;
+        }
+        int microamps = batteryManager.getIntProperty(BatteryManager.BATTERY_PROPERTY_CURRENT_NOW);
+        double volts = readVolts();
+        if (microamps == Integer.MIN_VALUE || volts <= 0) {
+            return -1;
+        }
+        // 放電電流的正負號依廠商而異
+        return Math.abs(microamps) / 1e6 * volts;
+    }
+
+    /**
+     * 電壓只能由 sticky broadcast 取得，變化緩慢，每秒更新一次即可
+     */
+    private synchronized double readVolts() {
+        long now = System.nanoTime();
+        if (cachedVolts <= 0 || now - voltageReadNanos > VOLTAGE_REFRESH_NANOS) {
+            Intent battery = context.registerReceiver(null, new IntentFilter(Intent.ACTION_BATTERY_CHANGED));
+            int millivolts = battery != null ? battery.getIntExtra(BatteryManager.EXTRA_VOLTAGE, -1) : -1;
+            cachedVolts = millivolts > 0 ? millivolts / 1000.0 : -1;
+            voltageReadNanos = now;
+        }
+        return cachedVolts;
+    }
+}
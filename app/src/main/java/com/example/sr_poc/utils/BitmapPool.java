@@ -0,0 +1,103 @@
+package com.example.sr_poc.utils;
+
+import android.graphics.Bitmap;
+
+import java.util.ArrayDeque;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+
+/**
+ * 以尺寸為key的可變 ARGB_8888 Bitmap 池，供解碼(inBitmap)與分塊暫存重複使用，
+ * 總大小超過上限時回收最早放回的Bitmap。
+ */
+public final class BitmapPool {
+
+    private final long maxBytes;
+    private final Map<Long, ArrayDeque<Bitmap>> buckets = new HashMap<>();
+    private long pooledBytes;
+    private int hits;
+    private int misses;
+
+    public BitmapPool(long maxBytes) {
+        this.maxBytes = maxBytes;
+    }
+
+    /**
+     * 取得指定尺寸的可變Bitmap；內容未清除，呼叫端需完整覆寫
+     */
+    public synchronized Bitmap acquire(int width, int height) {
+        ArrayDeque<Bitmap> bucket = buckets.get(key(width, height));
+        while (bucket != null && !bucket.isEmpty()) {
+            Bitmap bitmap = bucket.pollLast();
+            pooledBytes -= bitmap.getAllocationByteCount();
+            if (!bitmap.isRecycled()) {
+                hits++;
+                return bitmap;
+            }
+        }
+        misses++;
+        return Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+    }
+
+    /**
+     * 放回池中；不符合條件的Bitmap直接recycle
+     */
+    public synchronized void release(Bitmap bitmap) {
+        if (bitmap == null || bitmap.isRecycled()) {
+            return;
+        }
+        if (!bitmap.isMutable() || bitmap.getConfig() != Bitmap.Config.ARGB_8888
+            || bitmap.getAllocationByteCount() > maxBytes) {
+            bitmap.recycle();
+            return;
+        }
+
+        long key = key(bitmap.getWidth(), bitmap.getHeight());
+        ArrayDeque<Bitmap> bucket = buckets.get(key);
+        if (bucket == null) {
+            bucket = new ArrayDeque<>();
+            buckets.put(key, bucket);
+        }
+        bucket.addLast(bitmap);
+        pooledBytes += bitmap.getAllocationByteCount();
+        trim();
+    }
+
+    public synchronized void clear() {
+        for (ArrayDeque<Bitmap> bucket : buckets.values()) {
+            for (Bitmap bitmap : bucket) {
+                bitmap.recycle();
+            }
+        }
+        buckets.clear();
+        pooledBytes = 0;
+    }
+
+    public synchronized long getPooledBytes() {
+        return pooledBytes;
+    }
+
+    public synchronized String getStats() {
+        return String.format("BitmapPool[%d KB pooled, %d hits, %d misses]", pooledBytes / 1024, hits, misses);
+    }
+
+    private void trim() {
+        Iterator<ArrayDeque<Bitmap>> iterator = buckets.values().iterator();
+        while (pooledBytes > maxBytes && iterator.hasNext()) {
+            ArrayDeque<Bitmap> bucket = iterator.next();
+            while (pooledBytes > maxBytes && !bucket.isEmpty()) {
+                Bitmap evicted = bucket.pollFirst();
+                pooledBytes -= evicted.getAllocationByteCount();
+                evicted.recycle();
+            }
+            if (bucket.isEmpty()) {
+                iterator.remove();
+            }
+        }
+    }
+
+    private static long key(int width, int height) {
+        return ((long) width << 32) | (height & 0xFFFFFFFFL);
+    }
+}
@@ -0,0 +1,133 @@
+package com.example.sr_poc.utils;
+
+import java.util.Locale;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 以固定間隔取樣功率並對時間積分，得到一段工作消耗的能量。
+ * 功率來源可替換：裝置上為電池電流×電壓，主機端可用固定值或其他量測。
+ *
+ * 量到的是整機功率；同時進行的工作會各自計入全部功率，比較後端時應一次只跑一個工作。
+ */
+public final class EnergyMeter {
+
+    public interface PowerSource {
+        /**
+         * @return 目前功率（瓦）；無法取得時回傳負值，該取樣會被略過
+         */
+        double readWatts();
+    }
+
+    /**
+     * 固定功率，供主機端或測試使用
+     */
+    public static PowerSource constant(double watts) {
+        return () -> watts;
+    }
+
+    private final PowerSource source;
+    private final long intervalMs;
+    private final ScheduledExecutorService sampler = Executors.newSingleThreadScheduledExecutor(r -> {
+        Thread thread = new Thread(r, "EnergySampler");
+        thread.setDaemon(true);
+        return thread;
+    });
+
+    public EnergyMeter(PowerSource source, long intervalMs) {
+        this.source = source;
+        this.intervalMs = Math.max(1, intervalMs);
+    }
+
+    /**
+     * 開始量測；以 Measurement.end() 取得結果
+     */
+    public Measurement begin() {
+        return new Measurement();
+    }
+
+    public void close() {
+        sampler.shutdownNow();
+    }
+
+    public final class Measurement {
+        private final long startNanos = System.nanoTime();
+        private final ScheduledFuture<?> task;
+        // 以下由 this 保護
+        private long lastNanos = -1;
+        private double lastWatts;
+        private double joules;
+        private int samples;
+        private Energy result;
+
+        Measurement() {
+            sample();
+            task = sampler.scheduleAtFixedRate(this::sample, intervalMs, intervalMs, TimeUnit.MILLISECONDS);
+        }
+
+        private synchronized void sample() {
+            if (result != null) {
+                return;
+            }
+            double watts = source.readWatts();
+            if (watts < 0) {
+                return;
+            }
+            long now = System.nanoTime();
+            if (lastNanos >= 0) {
+                // 梯形積分
+                joules += (watts + lastWatts) * 0.5 * (now - lastNanos) / 1e9;
+            }
+            lastNanos = now;
+            lastWatts = watts;
+            samples++;
+        }
+
+        /**
+         * 結束量測（可重複呼叫，只有第一次有效）
+         */
+        public synchronized Energy end() {
+            if (result == null) {
+                task.cancel(false);
+                sample();
+                result = new Energy(joules, System.nanoTime() - startNanos, samples);
+            }
+            return result;
+        }
+    }
+
+    public static final class Energy {
+        public final double joules;
+        public final long durationNanos;
+        public final int samples;
+
+        Energy(double joules, long durationNanos, int samples) {
+            this.joules = joules;
+            this.durationNanos = durationNanos;
+            this.samples = samples;
+        }
+
+        /**
+         * 少於兩個有效取樣時無法積分
+         */
+        public boolean isValid() {
+            return samples >= 2;
+        }
+
+        public double getAverageWatts() {
+            return durationNanos > 0 ? joules * 1e9 / durationNanos : 0;
+        }
+
+        public double joulesPerMegapixel(long outputPixels) {
+            return outputPixels > 0 ? joules * 1e6 / outputPixels : 0;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "%.3f J over %.0f ms (%.2f W avg, %d samples)",
+                                 joules, durationNanos / 1e6, getAverageWatts(), samples);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+package com.example.sr_poc.utils;
+
+import android.os.Build;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.util.Log;
+import android.view.FrameMetrics;
+import android.view.Window;
+
+/**
+ * UI 卡頓量測：以 FrameMetrics 取得每一幀的總耗時，依幀的預定 vsync 時間點查出當時的處理階段
+ * （MetricsRegistry 中最近一個工作的 StageTrace），分別彙整到 JankStats；沒有工作時記為 idle 作為基準。
+ * 期限在 API 31+ 取自 FrameMetrics.DEADLINE，較舊版本使用螢幕更新間隔。
+ */
+public final class JankMonitor implements Window.OnFrameMetricsAvailableListener {
+
+    private static final String TAG = "JankMonitor";
+    private static final String IDLE = "idle";
+    private static final String BUSY = "busy"; // 有工作但不在任何階段內（建立統計、回呼等）
+
+    private final Window window;
+    private final long frameIntervalNanos;
+    private final JankStats stats = new JankStats();
+    private HandlerThread thread;
+    private volatile Handler handler; // report() 可能由處理執行緒呼叫
+    private long unreportedFrames;
+
+    public JankMonitor(Window window, float refreshRate) {
+        this.window = window;
+        this.frameIntervalNanos = (long) (1e9 / (refreshRate > 0 ? refreshRate : 60f));
+    }
+
+    /**
+     * 在主執行緒呼叫；回呼在獨立執行緒處理，不佔用 UI 執行緒
+     */
+    public void start() {
+        if (thread != null) {
+            return;
+        }
+        thread = new HandlerThread("JankMonitor");
+        thread.start();
+        handler = new Handler(thread.getLooper());
+        window.addOnFrameMetricsAvailableListener(this, handler);
+    }
+
+    public void stop() {
+        if (thread == null) {
+            return;
+        }
+        window.removeOnFrameMetricsAvailableListener(this);
+        thread.quitSafely();
+        thread = null;
+        handler = null;
+    }
+
+    @Override
+    public void onFrameMetricsAvailable(Window window, FrameMetrics frameMetrics, int dropCountSinceLastInvocation) {
+        if (frameMetrics.getMetric(FrameMetrics.FIRST_DRAW_FRAME) == 1) {
+            return;
+        }
+        long total = frameMetrics.getMetric(FrameMetrics.TOTAL_DURATION);
+        long deadline = Build.VERSION.SDK_INT >= Build.VERSION_CODES.S
+            ? frameMetrics.getMetric(FrameMetrics.DEADLINE) : frameIntervalNanos;
+        long vsync = Build.VERSION.SDK_INT >= Build.VERSION_CODES.O
+            ? frameMetrics.getMetric(FrameMetrics.INTENDED_VSYNC_TIMESTAMP) : System.nanoTime() - total;
+
+        MetricsRegistry registry = MetricsRegistry.get();
+        String stage = registry.stageAt(vsync);
+        if (stage == null) {
+            stage = registry.getJobsInFlight() > 0 ? BUSY : IDLE;
+        }
+        stats.record(stage, total, deadline);
+        // 監聽端處理太慢時系統略過的幀數，不是UI掉幀；過多表示統計不完整
+        unreportedFrames += dropCountSinceLastInvocation;
+    }
+
+    /**
+     * 輸出目前累積的各階段統計並歸零（例如每個工作完成時呼叫）
+     */
+    public void report() {
+        Runnable report = () -> {
+            Log.i(TAG, "Frame stats by stage" + (unreportedFrames > 0 ? " (" + unreportedFrames + " frames unreported)" : "")
+                       + ":\n" + stats);
+            stats.reset();
+            unreportedFrames = 0;
+        };
+        // 與回呼在同一執行緒執行，不需另外同步 unreportedFrames
+        if (handler != null) {
+            handler.post(report);
+        } else {
+            report.run();
+        }
+    }
+
+    public JankStats getStats() {
+        return stats;
+    }
+}
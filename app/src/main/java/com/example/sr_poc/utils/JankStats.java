@@ -0,0 +1,113 @@
+package com.example.sr_poc.utils;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * 依處理階段彙整 UI 幀耗時：幀數、超過期限的幀、錯過的 vsync 數與耗時分佈（1ms 一格）。
+ * 同一階段只在第一次出現時配置，之後每幀記錄不配置記憶體。
+ */
+public final class JankStats {
+
+    /** 分佈上限；更長的幀都記在最後一格 */
+    static final int MAX_BUCKET_MS = 250;
+
+    public static final class Stage {
+        public final String name;
+        private final int[] histogram = new int[MAX_BUCKET_MS + 1];
+        private int frames;
+        private int jankyFrames;
+        private long missedVsyncs;
+        private long maxNanos;
+
+        Stage(String name) {
+            this.name = name;
+        }
+
+        void record(long durationNanos, long deadlineNanos) {
+            frames++;
+            if (durationNanos > deadlineNanos) {
+                jankyFrames++;
+                // 超過期限的部分以 vsync 為單位進位，即此幀延後呈現的 vsync 數
+                missedVsyncs += (durationNanos - 1) / deadlineNanos;
+            }
+            maxNanos = Math.max(maxNanos, durationNanos);
+            histogram[(int) Math.min(MAX_BUCKET_MS, durationNanos / 1_000_000)]++;
+        }
+
+        public int getFrames() {
+            return frames;
+        }
+
+        public int getJankyFrames() {
+            return jankyFrames;
+        }
+
+        public long getMissedVsyncs() {
+            return missedVsyncs;
+        }
+
+        public double getMaxMs() {
+            return maxNanos / 1e6;
+        }
+
+        /**
+         * 分佈的百分位（以格的上緣計，精度 1ms）
+         */
+        public int percentileMs(double fraction) {
+            long target = (long) Math.ceil(fraction * frames);
+            long seen = 0;
+            for (int ms = 0; ms < histogram.length; ms++) {
+                seen += histogram[ms];
+                if (seen >= target && seen > 0) {
+                    return ms + 1;
+                }
+            }
+            return 0;
+        }
+
+        @Override
+        public String toString() {
+            return String.format(Locale.US, "%s: %d frames, %d janky (%.1f%%), %d missed vsyncs, p50 %dms, p95 %dms, max %.1fms",
+                                 name, frames, jankyFrames, frames > 0 ? jankyFrames * 100.0 / frames : 0.0,
+                                 missedVsyncs, percentileMs(0.50), percentileMs(0.95), getMaxMs());
+        }
+    }
+
+    private final Map<String, Stage> stages = new LinkedHashMap<>();
+
+    public synchronized void record(String stage, long durationNanos, long deadlineNanos) {
+        Stage stats = stages.get(stage);
+        if (stats == null) {
+            stats = new Stage(stage);
+            stages.put(stage, stats);
+        }
+        stats.record(durationNanos, Math.max(1, deadlineNanos));
+    }
+
+    public synchronized List<Stage> getStages() {
+        return new ArrayList<>(stages.values());
+    }
+
+    public synchronized void reset() {
+        stages.clear();
+    }
+
+    @Override
+    public synchronized String toString() {
+        if (stages.isEmpty()) {
+            return "no frames";
+        }
+        StringBuilder builder = new StringBuilder();
+        for (Stage stage : stages.values()) {
+            if (builder.length() > 0) {
+                builder.append('\n');
+            }
+            builder.append(stage);
+        }
+        return builder.toString();
+    }
+}
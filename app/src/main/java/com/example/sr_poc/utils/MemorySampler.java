@@ -0,0 +1,208 @@
+package com.example.sr_poc.utils;
+
+import android.os.Debug;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 工作期間的記憶體時間軸：背景以固定間隔取樣 Java heap、native heap 與 GC 次數，
+ * 每 fullSampleEvery 次另取 PSS 與 graphics（Debug.getMemoryInfo 需讀 smaps，成本較高）。
+ * 取樣以 StageTrace 標記所在階段，報告列出整體與各階段的峰值。
+ *
+ * native heap 包含 TFLite 的 tensor arena；Bitmap 像素（API 26+）與 direct ByteBuffer 也在 native heap。
+ */
+public final class MemorySampler {
+
+    public static final class Sample {
+        public final long offsetMs;
+        public final String stage;
+        public final long javaHeapKb;
+        public final long nativeHeapKb;
+        public final long pssKb;      // -1 表示此取樣未讀 PSS
+        public final long graphicsKb; // -1 表示此取樣未讀 graphics
+        public final long gcCount;
+        public final long blockingGcCount;
+
+        Sample(long offsetMs, String stage, long javaHeapKb, long nativeHeapKb, long pssKb, long graphicsKb,
+               long gcCount, long blockingGcCount) {
+            this.offsetMs = offsetMs;
+            this.stage = stage;
+            this.javaHeapKb = javaHeapKb;
+            this.nativeHeapKb = nativeHeapKb;
+            this.pssKb = pssKb;
+            this.graphicsKb = graphicsKb;
+            this.gcCount = gcCount;
+            this.blockingGcCount = blockingGcCount;
+        }
+    }
+
+    private final long intervalMs;
+    private final int fullSampleEvery;
+    private final ScheduledExecutorService sampler = Executors.newSingleThreadScheduledExecutor(r -> {
+        Thread thread = new Thread(r, "MemorySampler");
+        thread.setDaemon(true);
+        return thread;
+    });
+
+    public MemorySampler(long intervalMs, int fullSampleEvery) {
+        this.intervalMs = Math.max(1, intervalMs);
+        this.fullSampleEvery = Math.max(1, fullSampleEvery);
+    }
+
+    public Session begin(StageTrace trace) {
+        return new Session(trace);
+    }
+
+    public void close() {
+        sampler.shutdownNow();
+    }
+
+    public final class Session {
+        private final StageTrace trace;
+        private final List<Sample> samples = new ArrayList<>();
+        private final ScheduledFuture<?> task;
+        private final Debug.MemoryInfo memoryInfo = new Debug.MemoryInfo();
+        private Report report;
+
+        Session(StageTrace trace) {
+            this.trace = trace;
+            sample(true);
+            task = sampler.scheduleAtFixedRate(() -> sample(false), intervalMs, intervalMs, TimeUnit.MILLISECONDS);
+        }
+
+        private synchronized void sample(boolean forceFull) {
+            if (report != null) {
+                return;
+            }
+            Runtime runtime = Runtime.getRuntime();
+            long javaHeap = (runtime.totalMemory() - runtime.freeMemory()) / 1024;
+            long nativeHeap = Debug.getNativeHeapAllocatedSize() / 1024;
+            long pss = -1;
+            long graphics = -1;
+            if (forceFull || samples.size() % fullSampleEvery == 0) {
+                Debug.getMemoryInfo(memoryInfo);
+                pss = memoryInfo.getTotalPss();
+                graphics = parseStat(memoryInfo.getMemoryStat("summary.graphics"));
+            }
+            samples.add(new Sample((System.nanoTime() - trace.getOriginNanos()) / 1_000_000, trace.current(),
+                                   javaHeap, nativeHeap, pss, graphics,
+                                   parseStat(Debug.getRuntimeStat("art.gc.gc-count")),
+                                   parseStat(Debug.getRuntimeStat("art.gc.blocking-gc-count"))));
+        }
+
+        /**
+         * 結束取樣（含最後一次完整取樣）並產生報告；可重複呼叫
+         */
+        public synchronized Report end() {
+            if (report == null) {
+                task.cancel(false);
+                trace.finish();
+                sample(true);
+                report = new Report(new ArrayList<>(samples), trace);
+            }
+            return report;
+        }
+    }
+
+    private static long parseStat(String value) {
+        if (value == null) {
+            return -1;
+        }
+        try {
+            return Long.parseLong(value.trim());
+        } catch (NumberFormatException e) {
+            return -1;
+        }
+    }
+
+    public static final class Report {
+        public final List<Sample> samples;
+        public final StageTrace trace;
+        public final long peakJavaHeapKb;
+        public final long peakNativeHeapKb;
+        public final long peakPssKb;
+        public final long peakGraphicsKb;
+        public final long gcCount;
+        public final long blockingGcCount;
+
+        Report(List<Sample> samples, StageTrace trace) {
+            this.samples = samples;
+            this.trace = trace;
+            long java = 0, nativeHeap = 0, pss = -1, graphics = -1;
+            for (Sample sample : samples) {
+                java = Math.max(java, sample.javaHeapKb);
+                nativeHeap = Math.max(nativeHeap, sample.nativeHeapKb);
+                pss = Math.max(pss, sample.pssKb);
+                graphics = Math.max(graphics, sample.graphicsKb);
+            }
+            this.peakJavaHeapKb = java;
+            this.peakNativeHeapKb = nativeHeap;
+            this.peakPssKb = pss;
+            this.peakGraphicsKb = graphics;
+            Sample first = samples.get(0);
+            Sample last = samples.get(samples.size() - 1);
+            this.gcCount = first.gcCount >= 0 ? last.gcCount - first.gcCount : -1;
+            this.blockingGcCount = first.blockingGcCount >= 0 ? last.blockingGcCount - first.blockingGcCount : -1;
+        }
+
+        /**
+         * 各階段的 Java heap + native heap 峰值（KB），依階段開始順序
+         */
+        public Map<String, Long> peakByStage() {
+            Map<String, Long> peaks = new LinkedHashMap<>();
+            for (StageTrace.Stage stage : trace.getStages()) {
+                peaks.put(stage.name, 0L);
+            }
+            for (Sample sample : samples) {
+                if (sample.stage != null) {
+                    Long current = peaks.get(sample.stage);
+                    peaks.put(sample.stage, Math.max(current != null ? current : 0,
+                                                     sample.javaHeapKb + sample.nativeHeapKb));
+                }
+            }
+            return peaks;
+        }
+
+        /**
+         * 時間軸的 CSV（offset_ms,stage,java_kb,native_kb,pss_kb,graphics_kb,gc），方便貼到試算表
+         */
+        public String timelineCsv() {
+            StringBuilder builder = new StringBuilder("offset_ms,stage,java_kb,native_kb,pss_kb,graphics_kb,gc\n");
+            for (Sample sample : samples) {
+                builder.append(sample.offsetMs).append(',')
+                       .append(sample.stage != null ? sample.stage : "").append(',')
+                       .append(sample.javaHeapKb).append(',')
+                       .append(sample.nativeHeapKb).append(',')
+                       .append(sample.pssKb).append(',')
+                       .append(sample.graphicsKb).append(',')
+                       .append(sample.gcCount).append('\n');
+            }
+            return builder.toString();
+        }
+
+        @Override
+        public String toString() {
+            StringBuilder stages = new StringBuilder();
+            Map<String, Long> peaks = peakByStage();
+            for (StageTrace.Stage stage : trace.getStages()) {
+                if (stages.length() > 0) {
+                    stages.append(", ");
+                }
+                stages.append(String.format(Locale.US, "%s %dms/%dMB", stage.name, stage.getDurationMs(),
+                                            peaks.get(stage.name) / 1024));
+            }
+            return String.format(Locale.US,
+                "peak Java %dMB, native %dMB, PSS %dMB, graphics %dMB; GC %d (%d blocking); %d samples; stages [%s]",
+                peakJavaHeapKb / 1024, peakNativeHeapKb / 1024, peakPssKb / 1024, peakGraphicsKb / 1024,
+                gcCount, blockingGcCount, samples.size(), stages);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+package com.example.sr_poc.utils;
+
+import android.os.Debug;
+
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.IntSupplier;
+
+/**
+ * 程序內的即時指標：處理路徑只做原子計數與一次volatile寫入，
+ * 記憶體等較貴的讀取只在 snapshot() 時進行（由顯示端依需要輪詢，未顯示時沒有額外成本）。
+ */
+public final class MetricsRegistry {
+
+    private static final MetricsRegistry INSTANCE = new MetricsRegistry();
+
+    public static MetricsRegistry get() {
+        return INSTANCE;
+    }
+
+    public static final class Snapshot {
+        public final long uptimeNanos;
+        public final int jobsInFlight;
+        public final int tilesInFlight;
+        public final int queueDepth;     // -1 表示沒有佇列來源
+        public final long outputPixels;  // 累計，速率由兩次快照相減
+        public final List<StageTrace.Stage> stages; // 最近一個工作的階段，沒有工作時為 null
+        public final long javaHeapKb;
+        public final long nativeHeapKb;
+
+        Snapshot(long uptimeNanos, int jobsInFlight, int tilesInFlight, int queueDepth, long outputPixels,
+                 List<StageTrace.Stage> stages, long javaHeapKb, long nativeHeapKb) {
+            this.uptimeNanos = uptimeNanos;
+            this.jobsInFlight = jobsInFlight;
+            this.tilesInFlight = tilesInFlight;
+            this.queueDepth = queueDepth;
+            this.outputPixels = outputPixels;
+            this.stages = stages;
+            this.javaHeapKb = javaHeapKb;
+            this.nativeHeapKb = nativeHeapKb;
+        }
+
+        /**
+         * 兩次快照之間的輸出速率（百萬像素/秒）
+         */
+        public double megapixelsPerSecondSince(Snapshot previous) {
+            long elapsed = uptimeNanos - previous.uptimeNanos;
+            return elapsed > 0 ? (outputPixels - previous.outputPixels) * 1e3 / elapsed : 0;
+        }
+    }
+
+    private final AtomicInteger jobsInFlight = new AtomicInteger();
+    private final AtomicInteger tilesInFlight = new AtomicInteger();
+    private final AtomicLong outputPixels = new AtomicLong();
+    private volatile StageTrace activeTrace;
+    private volatile IntSupplier queueDepth;
+
+    private MetricsRegistry() {
+    }
+
+    public void jobStarted(StageTrace trace) {
+        jobsInFlight.incrementAndGet();
+        activeTrace = trace;
+    }
+
+    public void jobFinished() {
+        jobsInFlight.decrementAndGet();
+    }
+
+    public void tileStarted() {
+        tilesInFlight.incrementAndGet();
+    }
+
+    public void tileFinished(long pixels) {
+        tilesInFlight.decrementAndGet();
+        outputPixels.addAndGet(pixels);
+    }
+
+    /**
+     * 非分塊路徑在整張完成時一次計入
+     */
+    public void addOutputPixels(long pixels) {
+        outputPixels.addAndGet(pixels);
+    }
+
+    /**
+     * 最近一個工作在指定時間點（System.nanoTime 基準）所在的階段；沒有工作或不在階段內時為 null
+     */
+    public String stageAt(long nanos) {
+        StageTrace trace = activeTrace;
+        return trace != null ? trace.stageAt(nanos) : null;
+    }
+
+    public int getJobsInFlight() {
+        return jobsInFlight.get();
+    }
+
+    public void setQueueDepthSource(IntSupplier queueDepth) {
+        this.queueDepth = queueDepth;
+    }
+
+    public Snapshot snapshot() {
+        StageTrace trace = activeTrace;
+        IntSupplier depth = queueDepth;
+        Runtime runtime = Runtime.getRuntime();
+        return new Snapshot(System.nanoTime(), jobsInFlight.get(), tilesInFlight.get(),
+                            depth != null ? depth.getAsInt() : -1, outputPixels.get(),
+                            trace != null ? trace.getStages() : null,
+                            (runtime.totalMemory() - runtime.freeMemory()) / 1024,
+                            Debug.getNativeHeapAllocatedSize() / 1024);
+    }
+}
@@ -0,0 +1,161 @@
+package com.example.sr_poc.utils;
+
+import android.annotation.TargetApi;
+import android.content.Context;
+import android.os.Build;
+import android.os.PerformanceHintManager;
+import android.os.Process;
+import android.util.Log;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * 推理相關執行緒的排程提示：登記執行緒 ID 並調整優先權，API 31+ 以 PerformanceHintManager
+ * 開一個涵蓋這些執行緒的 session，每個 tile 完成時回報實際耗時，讓 DVFS 依目標時間調整頻率
+ * （短 tile 之間 CPU 常降回低頻）。較舊的 API 只調整優先權。
+ * TFLite 內部的 CPU 執行緒無法取得 ID，不在 session 內。
+ */
+public final class PerformanceHints {
+
+    private static final String TAG = "PerformanceHints";
+
+    private final Context context;
+    private final long targetNanos;
+    private final int threadPriority;
+    private final List<Integer> threadIds = new ArrayList<>();
+
+    private volatile boolean enabled;
+    private volatile boolean background;
+    // 以下由 this 保護
+    private Object session; // PerformanceHintManager.Session；以 Object 保存，API 31 以下不載入該類別
+    private int sessionThreadCount;
+    private boolean unsupported;
+
+    public PerformanceHints(Context context, long targetNanos, int threadPriority, boolean enabled) {
+        this.context = context.getApplicationContext();
+        this.targetNanos = targetNanos;
+        this.threadPriority = threadPriority;
+        this.enabled = enabled;
+    }
+
+    /**
+     * 在要納入的執行緒上呼叫（SR 線程、轉換執行緒）
+     */
+    public synchronized void registerCurrentThread() {
+        int tid = Process.myTid();
+        threadIds.add(tid);
+        if (enabled || background) {
+            setPriority(tid, currentPriority());
+        }
+    }
+
+    /**
+     * 關閉時恢復預設優先權並結束 session（基準測試用來比較前後差異）
+     */
+    public synchronized void setEnabled(boolean enabled) {
+        this.enabled = enabled;
+        applyPriority();
+        if (!enabled) {
+            closeSession();
+        }
+    }
+
+    /**
+     * 低優先權工作（預先處理）期間把所有登記的執行緒降為背景優先權並停止回報，結束後恢復
+     */
+    public synchronized void setBackground(boolean background) {
+        if (this.background == background) {
+            return;
+        }
+        this.background = background;
+        applyPriority();
+    }
+
+    private void applyPriority() {
+        int priority = currentPriority();
+        for (int tid : threadIds) {
+            setPriority(tid, priority);
+        }
+    }
+
+    private int currentPriority() {
+        if (background) {
+            return Process.THREAD_PRIORITY_BACKGROUND;
+        }
+        return enabled ? threadPriority : Process.THREAD_PRIORITY_DEFAULT;
+    }
+
+    public boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * 回報一個 tile（或一次推理）的實際耗時；未啟用或不支援時不做事
+     */
+    public void reportActualWorkDuration(long nanos) {
+        if (!enabled || background || nanos <= 0 || Build.VERSION.SDK_INT < Build.VERSION_CODES.S) {
+            return;
+        }
+        synchronized (this) {
+            // 有新執行緒登記時重建 session，使其涵蓋全部執行緒
+            if (session != null && sessionThreadCount != threadIds.size()) {
+                closeSession();
+            }
+            if (session == null && !unsupported) {
+                session = Api31.createSession(context, threadIds, targetNanos);
+                sessionThreadCount = threadIds.size();
+                if (session == null) {
+                    unsupported = true;
+                    Log.d(TAG, "Performance hint sessions not supported, using thread priorities only");
+                }
+            }
+            if (session != null) {
+                Api31.report(session, nanos);
+            }
+        }
+    }
+
+    public synchronized void close() {
+        closeSession();
+    }
+
+    private void closeSession() {
+        if (session != null) {
+            Api31.close(session);
+            session = null;
+        }
+    }
+
+    private static void setPriority(int tid, int priority) {
+        try {
+            Process.setThreadPriority(tid, priority);
+        } catch (IllegalArgumentException | SecurityException e) {
+            Log.w(TAG, "Failed to set priority " + priority + " for thread " + tid + ": " + e.getMessage());
+        }
+    }
+
+    @TargetApi(Build.VERSION_CODES.S)
+    private static final class Api31 {
+
+        static Object createSession(Context context, List<Integer> threadIds, long targetNanos) {
+            PerformanceHintManager manager = context.getSystemService(PerformanceHintManager.class);
+            if (manager == null || manager.getPreferredUpdateRateNanos() < 0 || threadIds.isEmpty()) {
+                return null;
+            }
+            int[] tids = new int[threadIds.size()];
+            for (int i = 0; i < tids.length; i++) {
+                tids[i] = threadIds.get(i);
+            }
+            return manager.createHintSession(tids, targetNanos);
+        }
+
+        static void report(Object session, long nanos) {
+            ((PerformanceHintManager.Session) session).reportActualWorkDuration(nanos);
+        }
+
+        static void close(Object session) {
+            ((PerformanceHintManager.Session) session).close();
+        }
+    }
+}
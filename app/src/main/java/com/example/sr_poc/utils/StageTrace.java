@@ -0,0 +1,96 @@
+package com.example.sr_poc.utils;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * 工作的階段時間軸：mark() 結束目前階段並開始下一個，finish() 結束最後一個。
+ * 可由任意執行緒查詢某時間點所在的階段（記憶體取樣用來標記每個取樣）。
+ */
+public final class StageTrace {
+
+    public static final class Stage {
+        public final String name;
+        public final long startNanos;
+        long endNanos = -1;
+
+        Stage(String name, long startNanos) {
+            this.name = name;
+            this.startNanos = startNanos;
+        }
+
+        public long getEndNanos() {
+            return endNanos;
+        }
+
+        public long getDurationMs() {
+            return endNanos >= 0 ? (endNanos - startNanos) / 1_000_000 : -1;
+        }
+    }
+
+    private final long originNanos = System.nanoTime();
+    private final List<Stage> stages = new ArrayList<>();
+
+    public long getOriginNanos() {
+        return originNanos;
+    }
+
+    public synchronized void mark(String name) {
+        long now = System.nanoTime();
+        closeCurrent(now);
+        stages.add(new Stage(name, now));
+    }
+
+    public synchronized void finish() {
+        closeCurrent(System.nanoTime());
+    }
+
+    /**
+     * @return 目前進行中的階段名稱，尚未開始或已結束時為 null
+     */
+    public synchronized String current() {
+        if (stages.isEmpty()) {
+            return null;
+        }
+        Stage last = stages.get(stages.size() - 1);
+        return last.endNanos < 0 ? last.name : null;
+    }
+
+    /**
+     * @return 指定時間點（System.nanoTime 基準）所在的階段名稱，不在任何階段內時為 null
+     */
+    public synchronized String stageAt(long nanos) {
+        for (int i = stages.size() - 1; i >= 0; i--) {
+            Stage stage = stages.get(i);
+            if (nanos >= stage.startNanos) {
+                return stage.endNanos < 0 || nanos < stage.endNanos ? stage.name : null;
+            }
+        }
+        return null;
+    }
+
+    public synchronized List<Stage> getStages() {
+        return new ArrayList<>(stages);
+    }
+
+    private void closeCurrent(long now) {
+        if (!stages.isEmpty()) {
+            Stage last = stages.get(stages.size() - 1);
+            if (last.endNanos < 0) {
+                last.endNanos = now;
+            }
+        }
+    }
+
+    @Override
+    public synchronized String toString() {
+        StringBuilder builder = new StringBuilder();
+        for (Stage stage : stages) {
+            if (builder.length() > 0) {
+                builder.append(", ");
+            }
+            builder.append(stage.name).append(' ').append(stage.getDurationMs()).append("ms");
+        }
+        return builder.toString();
+    }
+}
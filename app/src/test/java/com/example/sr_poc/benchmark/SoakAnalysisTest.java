@@ -0,0 +1,72 @@
+package com.example.sr_poc.benchmark;
+
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.Assert.*;
+
+public class SoakAnalysisTest {
+
+    private static final long WINDOW_MS = 60_000;
+
+    @Test
+    public void slopeOfLine() {
+        double[] x = {0, 1, 2, 3};
+        double[] y = {1, 3, 5, 7};
+        assertEquals(2.0, Trend.slope(x, y), 1e-9);
+        assertEquals(0.0, Trend.slope(new double[] {1, 1}, new double[] {0, 5}), 0.0);
+    }
+
+    @Test
+    public void stableRunHasNoRegression() {
+        List<SoakRunner.Window> windows = new ArrayList<>();
+        for (int i = 0; i < 30; i++) {
+            // 延遲與記憶體上下抖動但沒有趨勢
+            windows.add(window(i, 100 + (i % 3) * 2, 200_000 + (i % 2) * 4_000, 50_000 + (i % 4) * 1_000));
+        }
+        assertTrue(SoakRunner.analyze(windows, new SoakRunner.Thresholds()).isEmpty());
+    }
+
+    @Test
+    public void nativeLeakIsFlagged() {
+        List<SoakRunner.Window> windows = new ArrayList<>();
+        for (int i = 0; i < 30; i++) {
+            // 每分鐘洩漏 2MB native（約 120MB/h）
+            windows.add(window(i, 100, 200_000 + i * 2_048, 50_000));
+        }
+        List<String> regressions = SoakRunner.analyze(windows, new SoakRunner.Thresholds());
+        // PSS 包含 native，同樣會被標記；延遲與 Java heap 不應被標記
+        assertEquals(2, regressions.size());
+        assertTrue(regressions.get(0), regressions.get(0).startsWith("native heap growth"));
+        assertTrue(regressions.get(1), regressions.get(1).startsWith("PSS growth"));
+    }
+
+    @Test
+    public void latencyDriftIsFlagged() {
+        List<SoakRunner.Window> windows = new ArrayList<>();
+        for (int i = 0; i < 60; i++) {
+            // 一小時內 p50 從 100ms 漂移到約 160ms
+            windows.add(window(i, 100 + i, 200_000, 50_000));
+        }
+        List<String> regressions = SoakRunner.analyze(windows, new SoakRunner.Thresholds());
+        assertEquals(1, regressions.size());
+        assertTrue(regressions.get(0), regressions.get(0).startsWith("latency drift"));
+    }
+
+    @Test
+    public void warmupWindowIsIgnored() {
+        List<SoakRunner.Window> windows = new ArrayList<>();
+        windows.add(window(0, 400, 100_000, 20_000)); // 首次初始化delegate與分配緩衝
+        for (int i = 1; i < 10; i++) {
+            windows.add(window(i, 100, 200_000, 50_000));
+        }
+        assertTrue(SoakRunner.analyze(windows, new SoakRunner.Thresholds()).isEmpty());
+    }
+
+    private static SoakRunner.Window window(int index, long p50Ms, long nativeKb, long javaKb) {
+        return new SoakRunner.Window(index, (index + 1) * WINDOW_MS, 100, 0, p50Ms, p50Ms * 2, javaKb, nativeKb,
+                                     nativeKb + javaKb, 3, 0);
+    }
+}
@@ -0,0 +1,107 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Test;
+
+import java.util.Arrays;
+import java.util.List;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+public class AtlasPlanTest {
+
+    @Test
+    public void equalCellsFillShelvesThenSpillToNextPage() {
+        // 24x24 加上兩側 gutter 4 為 32x32，一頁 64x64 剛好放四張
+        int[] sizes = {24, 24, 24, 24, 24};
+        AtlasPlan plan = new AtlasPlan(sizes, sizes, 64, 64, 4);
+
+        assertEquals(2, plan.getPageCount());
+        assertEquals(4, plan.getPages().get(0).size());
+        assertEquals(1, plan.getPages().get(1).size());
+        assertTrue(plan.getOversized().isEmpty());
+
+        List<AtlasPlan.Placement> first = plan.getPages().get(0);
+        assertPlacement(first.get(0), 0, 4, 4);
+        assertPlacement(first.get(1), 0, 36, 4);
+        assertPlacement(first.get(2), 0, 4, 36);
+        assertPlacement(first.get(3), 0, 36, 36);
+        assertPlacement(plan.getPages().get(1).get(0), 1, 4, 4);
+    }
+
+    @Test
+    public void imagesThatCannotFitWithGutterAreOversized() {
+        int[] widths = {56, 57, 10, 0};
+        int[] heights = {56, 10, 57, 10};
+        AtlasPlan plan = new AtlasPlan(widths, heights, 64, 64, 4);
+
+        assertEquals(1, plan.getPlacedCount());
+        assertEquals(0, plan.getPages().get(0).get(0).imageIndex);
+        assertPlacement(plan.getPages().get(0).get(0), 0, 4, 4);
+        assertEquals(3, plan.getOversized().size());
+        assertTrue(plan.getOversized().containsAll(Arrays.asList(1, 2, 3)));
+    }
+
+    @Test
+    public void tallestImagesArePackedFirst() {
+        int[] widths = {10, 10, 10};
+        int[] heights = {5, 20, 12};
+        AtlasPlan plan = new AtlasPlan(widths, heights, 128, 128, 2);
+        List<AtlasPlan.Placement> page = plan.getPages().get(0);
+        assertEquals(1, page.get(0).imageIndex);
+        assertEquals(2, page.get(1).imageIndex);
+        assertEquals(0, page.get(2).imageIndex);
+    }
+
+    @Test
+    public void randomImagesArePlacedOnceWithGuttersInsidePageAndApart() {
+        Random random = new Random(42);
+        int count = 200;
+        int[] widths = new int[count];
+        int[] heights = new int[count];
+        for (int i = 0; i < count; i++) {
+            widths[i] = 1 + random.nextInt(80);
+            heights[i] = 1 + random.nextInt(80);
+        }
+        int gutter = 6;
+        AtlasPlan plan = new AtlasPlan(widths, heights, 96, 96, gutter);
+
+        int[] seen = new int[count];
+        for (int index : plan.getOversized()) {
+            seen[index]++;
+        }
+        for (int p = 0; p < plan.getPageCount(); p++) {
+            List<AtlasPlan.Placement> page = plan.getPages().get(p);
+            for (AtlasPlan.Placement placement : page) {
+                seen[placement.imageIndex]++;
+                assertEquals(p, placement.page);
+                assertEquals(widths[placement.imageIndex], placement.width);
+                assertEquals(heights[placement.imageIndex], placement.height);
+                // 內容加上 gutter 必須在頁面內
+                assertTrue(placement.x - gutter >= 0 && placement.y - gutter >= 0);
+                assertTrue(placement.x + placement.width + gutter <= 96);
+                assertTrue(placement.y + placement.height + gutter <= 96);
+            }
+            for (int a = 0; a < page.size(); a++) {
+                for (int b = a + 1; b < page.size(); b++) {
+                    assertFalse("cells overlap on page " + p, cellsOverlap(page.get(a), page.get(b), gutter));
+                }
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            assertEquals("image " + i, 1, seen[i]);
+        }
+        assertEquals(count - plan.getOversized().size(), plan.getPlacedCount());
+    }
+
+    private static boolean cellsOverlap(AtlasPlan.Placement a, AtlasPlan.Placement b, int gutter) {
+        return a.x - gutter < b.x + b.width + gutter && b.x - gutter < a.x + a.width + gutter
+            && a.y - gutter < b.y + b.height + gutter && b.y - gutter < a.y + a.height + gutter;
+    }
+
+    private static void assertPlacement(AtlasPlan.Placement placement, int page, int x, int y) {
+        assertEquals(page, placement.page);
+        assertEquals(x, placement.x);
+        assertEquals(y, placement.y);
+    }
+}
@@ -0,0 +1,86 @@
+package com.example.sr_poc.processing;
+
+import org.junit.After;
+import org.junit.Test;
+
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+
+import static org.junit.Assert.*;
+
+public class BandWorkersTest {
+
+    private final BandWorkers workers = new BandWorkers("BandWorkersTest", 3);
+
+    @After
+    public void tearDown() {
+        workers.close();
+    }
+
+    @Test
+    public void everyBandRunsExactlyOncePerRun() {
+        AtomicIntegerArray counts = new AtomicIntegerArray(4);
+        for (int i = 0; i < 100; i++) {
+            workers.run(4, (band, bandCount) -> {
+                assertEquals(4, bandCount);
+                counts.incrementAndGet(band);
+            });
+        }
+        for (int band = 0; band < 4; band++) {
+            assertEquals(100, counts.get(band));
+        }
+    }
+
+    @Test
+    public void bandCountIsClampedToWorkers() {
+        AtomicIntegerArray counts = new AtomicIntegerArray(8);
+        workers.run(8, (band, bandCount) -> counts.incrementAndGet(band));
+        for (int band = 0; band < 8; band++) {
+            assertEquals(band < workers.getMaxBands() ? 1 : 0, counts.get(band));
+        }
+    }
+
+    @Test
+    public void workerFailureIsRethrownAfterAllBandsFinish() {
+        AtomicIntegerArray counts = new AtomicIntegerArray(4);
+        try {
+            workers.run(4, (band, bandCount) -> {
+                counts.incrementAndGet(band);
+                if (band == 2) {
+                    throw new IllegalStateException("band 2");
+                }
+            });
+            fail("Expected the band failure to propagate");
+        } catch (IllegalStateException e) {
+            assertEquals("band 2", e.getMessage());
+        }
+        for (int band = 0; band < 4; band++) {
+            assertEquals(1, counts.get(band));
+        }
+
+        // 失敗後仍可繼續使用
+        AtomicIntegerArray again = new AtomicIntegerArray(4);
+        workers.run(4, (band, bandCount) -> again.incrementAndGet(band));
+        assertEquals(1, again.get(3));
+    }
+
+    @Test
+    public void startHookRunsOnEachWorkerThreadBeforeItsBands() {
+        Set<Thread> started = ConcurrentHashMap.newKeySet();
+        BandWorkers hooked = new BandWorkers("Hooked", 3, () -> started.add(Thread.currentThread()));
+        try {
+            Set<Thread> ran = ConcurrentHashMap.newKeySet();
+            hooked.run(4, (band, bandCount) -> {
+                // 在 worker 上 assert 失敗會是 Error 而非 RuntimeException，改在呼叫端比對
+                if (band > 0 && started.contains(Thread.currentThread())) {
+                    ran.add(Thread.currentThread());
+                }
+            });
+            assertEquals(3, ran.size());
+            assertEquals(ran, started);
+        } finally {
+            hooked.close();
+        }
+    }
+}
@@ -0,0 +1,202 @@
+package com.example.sr_poc.processing;
+
+import com.example.sr_poc.utils.Constants;
+
+import org.junit.After;
+import org.junit.Test;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+public class OutputKernelTest {
+
+    private final BandWorkers workers = new BandWorkers("OutputKernelTest", 3);
+
+    @After
+    public void tearDown() {
+        workers.close();
+    }
+
+    @Test
+    public void bandedRunMatchesMultiPassReference() {
+        // 超過 LARGE_IMAGE_PIXEL_THRESHOLD，會分段並行
+        int width = 1100;
+        int height = 1000;
+        byte[] data = randomPixels(width, height, 1);
+        PostProcessChain chain = new PostProcessChain.Builder().sharpen(0.5f).gamma(2.2f).dither().build();
+
+        OutputKernel kernel = new OutputKernel(workers);
+        kernel.setChain(chain);
+        int[] actual = new int[width * height];
+        kernel.run(OutputKernel.uint8(data, width, height), actual);
+
+        float[][] rows = reference(data, width, height);
+        int[] expected = new int[width * height];
+        for (int y = 0; y < height; y++) {
+            quantize(rows[y], expected, y * width, width);
+        }
+        assertArrayEquals(expected, actual);
+    }
+
+    @Test
+    public void resampledRunMatchesMultiPassReference() {
+        int width = 2200;
+        int height = 2000;
+        int targetWidth = width / 2;
+        int targetHeight = height / 2;
+        byte[] data = randomPixels(width, height, 2);
+        PostProcessChain chain = new PostProcessChain.Builder().sharpen(0.5f).gamma(2.2f).dither().build();
+
+        OutputKernel kernel = new OutputKernel(workers);
+        kernel.setChain(chain);
+        int[] actual = new int[targetWidth * targetHeight];
+        kernel.run(OutputKernel.uint8(data, width, height),
+                   OutputRegion.scaled(width, height, targetWidth, targetHeight), actual);
+
+        // 先 stencil，再 2x2 平均縮小，最後逐像素運算
+        float[][] rows = sharpened(data, width, height);
+        float[] row = new float[targetWidth * 3];
+        int[] expected = new int[targetWidth * targetHeight];
+        for (int ty = 0; ty < targetHeight; ty++) {
+            float[] upper = rows[ty * 2];
+            float[] lower = rows[ty * 2 + 1];
+            for (int i = 0; i < targetWidth * 3; i++) {
+                int c = i / 3 * 6 + i % 3;
+                row[i] = (upper[c] + upper[c + 3] + lower[c] + lower[c + 3]) * 0.25f;
+            }
+            applyPointOps(row, targetWidth, ty);
+            quantize(row, expected, ty * targetWidth, targetWidth);
+        }
+        assertWithin(1, expected, actual);
+    }
+
+    @Test
+    public void tiledRegionsLineUpWithWholeImage() {
+        int width = 301;
+        int height = 97;
+        byte[] data = randomPixels(width, height, 3);
+        OutputKernel kernel = new OutputKernel(null);
+        kernel.setChain(new PostProcessChain.Builder().gamma(2.2f).dither().build());
+        OutputKernel.Source source = OutputKernel.uint8(data, width, height);
+
+        int[] whole = new int[width * height];
+        kernel.run(source, whole);
+
+        // 切點不對齊 4，dither 相位若從每塊的 0 開始就會出現接縫
+        int[] cuts = {0, 101, 202, width};
+        int[] stitched = new int[width * height];
+        for (int t = 0; t + 1 < cuts.length; t++) {
+            int left = cuts[t];
+            int tileWidth = cuts[t + 1] - left;
+            int[] tile = new int[tileWidth * height];
+            kernel.run(source, new OutputRegion(left, 0, tileWidth, height, left, 0, 1, 1), tile);
+            for (int y = 0; y < height; y++) {
+                System.arraycopy(tile, y * tileWidth, stitched, y * width + left, tileWidth);
+            }
+        }
+        assertArrayEquals(whole, stitched);
+    }
+
+    @Test
+    public void ditherDoesNotBiasByteSources() {
+        int width = 64;
+        int height = 64;
+        byte[] data = new byte[width * height * 3];
+        Arrays.fill(data, (byte) 100);
+        OutputKernel kernel = new OutputKernel(null);
+        kernel.setChain(new PostProcessChain.Builder().dither().build());
+
+        int[] pixels = new int[width * height];
+        kernel.run(OutputKernel.uint8(data, width, height), pixels);
+        long sum = 0;
+        for (int pixel : pixels) {
+            sum += pixel & 0xFF;
+        }
+        assertEquals(100.0, (double) sum / pixels.length, 0.01);
+    }
+
+    @Test
+    public void gammaOnByteSourceRoundsAfterTheCurve() {
+        int width = 256;
+        int height = 1;
+        byte[] data = new byte[width * 3];
+        for (int i = 0; i < data.length; i++) {
+            data[i] = (byte) (i / 3);
+        }
+        OutputKernel kernel = new OutputKernel(null);
+        kernel.setChain(new PostProcessChain.Builder().gamma(2.2f).build());
+
+        int[] pixels = new int[width];
+        kernel.run(OutputKernel.uint8(data, width, height), pixels);
+        for (int x = 0; x < width; x++) {
+            int expected = (int) Math.round(Math.pow(x / 255.0, 1 / 2.2) * 255);
+            // LUT 線性內插在曲線陡峭的暗部允許 1 階誤差
+            assertEquals("code " + x, expected, pixels[x] & 0xFF, 1);
+        }
+    }
+
+    // ---- Naive multi-pass reference ----
+
+    private static float[][] reference(byte[] data, int width, int height) {
+        float[][] rows = sharpened(data, width, height);
+        for (int y = 0; y < height; y++) {
+            applyPointOps(rows[y], width, y);
+        }
+        return rows;
+    }
+
+    private static float[][] sharpened(byte[] data, int width, int height) {
+        float[][] decoded = new float[height][width * 3];
+        for (int y = 0; y < height; y++) {
+            for (int i = 0; i < width * 3; i++) {
+                decoded[y][i] = (data[y * width * 3 + i] & 0xFF) * Constants.RGB_TO_FLOAT_MULTIPLIER;
+            }
+        }
+        PostProcessChain.SharpenOp sharpen = new PostProcessChain.SharpenOp(0.5f);
+        float[][] out = new float[height][width * 3];
+        for (int y = 0; y < height; y++) {
+            sharpen.applyRow(decoded[Math.max(y - 1, 0)], decoded[y], decoded[Math.min(y + 1, height - 1)],
+                             out[y], width);
+        }
+        return out;
+    }
+
+    private static void applyPointOps(float[] row, int width, int y) {
+        PostProcessChain.CurveOp.gamma(2.2f).applyRow(row, width, 0, y);
+        new PostProcessChain.BayerDitherOp().applyRow(row, width, 0, y);
+    }
+
+    private static void quantize(float[] rgb, int[] pixels, int offset, int width) {
+        for (int x = 0; x < width; x++) {
+            int r = toByte(rgb[x * 3]);
+            int g = toByte(rgb[x * 3 + 1]);
+            int b = toByte(rgb[x * 3 + 2]);
+            pixels[offset + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    private static int toByte(float v) {
+        return (int) (Math.max(0f, Math.min(1f, v)) * 255);
+    }
+
+    private static byte[] randomPixels(int width, int height, long seed) {
+        byte[] data = new byte[width * height * 3];
+        new Random(seed).nextBytes(data);
+        return data;
+    }
+
+    private static void assertWithin(int tolerance, int[] expected, int[] actual) {
+        assertEquals(expected.length, actual.length);
+        for (int i = 0; i < expected.length; i++) {
+            for (int shift = 0; shift < 24; shift += 8) {
+                int e = (expected[i] >> shift) & 0xFF;
+                int a = (actual[i] >> shift) & 0xFF;
+                if (Math.abs(e - a) > tolerance) {
+                    fail("pixel " + i + " channel " + shift / 8 + ": expected " + e + " but was " + a);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class PostProcessChainTest {
+
+    @Test
+    public void describeListsOpsInExecutionOrder() {
+        PostProcessChain chain = new PostProcessChain.Builder()
+            .dither()
+            .gamma(2.2f)
+            .sharpen(0.5f)
+            .srgbEncode()
+            .build();
+        assertEquals("sharpen(0.5000),gamma(2.2000),srgb,dither", chain.describe());
+        assertEquals("none", PostProcessChain.EMPTY.describe());
+    }
+
+    @Test
+    public void describeDistinguishesParameters() {
+        String weak = new PostProcessChain.Builder().sharpen(0.25f).build().describe();
+        String strong = new PostProcessChain.Builder().sharpen(0.75f).build().describe();
+        assertNotEquals(weak, strong);
+        // gamma 1 不產生運算
+        assertEquals("none", new PostProcessChain.Builder().gamma(1f).build().describe());
+    }
+}
@@ -0,0 +1,179 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.util.Arrays;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.Assert.*;
+
+public class PyramidWriterTest {
+
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void averageRoundsOncePerChannel() {
+        // 先兩兩取整再平均的舊做法：(10+11)/2=10、(11+11)/2=11、(10+11)/2=10；一次四捨五入為 (43+2)/4=11
+        assertEquals(0x0B0B0B0B, PyramidWriter.average(0x0A0A0A0A, 0x0B0B0B0B, 0x0B0B0B0B, 0x0B0B0B0B));
+        assertEquals(0x02000000, PyramidWriter.average(0x01000000, 0x01000000, 0x02000000, 0x02000000));
+        assertEquals(0, PyramidWriter.average(0, 0, 0, 0x01010101));
+        assertEquals(0xFFFFFFFF, PyramidWriter.average(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF));
+        // 通道之間不可進位
+        assertEquals(0x80008000, PyramidWriter.average(0xFF00FF00, 0xFF00FF00, 0x00000000, 0x01000100));
+    }
+
+    @Test
+    public void averageMatchesPerChannelReference() {
+        Random random = new Random(7);
+        for (int i = 0; i < 10000; i++) {
+            int a = random.nextInt();
+            int b = random.nextInt();
+            int c = random.nextInt();
+            int d = random.nextInt();
+            assertEquals(reference(a, b, c, d), PyramidWriter.average(a, b, c, d));
+        }
+    }
+
+    @Test
+    public void constantRowsKeepTheirValue() {
+        int[] row = new int[7];
+        Arrays.fill(row, 0x807F0103);
+        int[] dst = new int[4];
+        PyramidWriter.downsample(row, row, 7, dst);
+        for (int value : dst) {
+            assertEquals(0x807F0103, value);
+        }
+    }
+
+    @Test
+    public void downsampleOddWidthRepeatsLastColumn() {
+        int[] upper = {0x00000000, 0x00000004, 0x00000008, 0x0000000C, 0x00000010};
+        int[] lower = {0x00000030, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000020};
+        int[] dst = new int[3];
+        PyramidWriter.downsample(upper, lower, 1, 5, dst);
+        assertEquals(0x00000001, dst[0]); // (0+4+0+0+2)/4
+        assertEquals(0x00000005, dst[1]); // (8+12+0+0+2)/4
+        assertEquals(0x00000018, dst[2]); // (16+16+32+32+2)/4
+    }
+
+    @Test
+    public void oddSizeWithOverlapMatchesReferencePyramid() throws Exception {
+        assertPyramid(37, 23, 8, 2, 5);
+    }
+
+    @Test
+    public void overlapLargerThanHalfTile() throws Exception {
+        assertPyramid(19, 31, 4, 3, 1);
+    }
+
+    @Test
+    public void noOverlapOddHeight() throws Exception {
+        assertPyramid(16, 9, 4, 0, 3);
+    }
+
+    /**
+     * 以不規則的批次寫入列，與整張影像逐層計算的參考金字塔逐 tile 比對
+     */
+    private void assertPyramid(int width, int height, int tileSize, int overlap, int chunkRows) throws Exception {
+        Random random = new Random(width * 31 + height);
+        int[] image = new int[width * height];
+        for (int i = 0; i < image.length; i++) {
+            image[i] = random.nextInt();
+        }
+
+        Map<String, int[]> tiles = new ConcurrentHashMap<>();
+        Map<String, int[]> sizes = new ConcurrentHashMap<>();
+        PyramidWriter.TileEncoder encoder = (argb, w, h, file) -> {
+            String key = file.getParentFile().getName() + "/" + file.getName();
+            assertNull("tile written twice: " + key, tiles.put(key, argb.clone()));
+            sizes.put(key, new int[]{w, h});
+        };
+
+        File manifest = new File(folder.getRoot(), "image.dzi");
+        ExecutorService executor = Executors.newFixedThreadPool(2);
+        int levelCount;
+        int tilesWritten;
+        try {
+            PyramidWriter writer = new PyramidWriter(manifest, width, height, tileSize, overlap, "png",
+                                                     encoder, executor, 3);
+            for (int y = 0; y < height; y += chunkRows) {
+                writer.writeRows(image, y * width, Math.min(chunkRows, height - y));
+            }
+            writer.finish();
+            levelCount = writer.getLevelCount();
+            tilesWritten = writer.getTilesWritten();
+        } finally {
+            executor.shutdownNow();
+        }
+        assertTrue(manifest.isFile());
+
+        int expectedTiles = 0;
+        int[] level = image;
+        int w = width;
+        int h = height;
+        for (int index = levelCount - 1; index >= 0; index--) {
+            int cols = (w + tileSize - 1) / tileSize;
+            int rows = (h + tileSize - 1) / tileSize;
+            for (int row = 0; row < rows; row++) {
+                for (int col = 0; col < cols; col++) {
+                    String key = index + "/" + col + "_" + row + ".png";
+                    int left = Math.max(0, col * tileSize - overlap);
+                    int right = Math.min(w, (col + 1) * tileSize + overlap);
+                    int top = Math.max(0, row * tileSize - overlap);
+                    int bottom = Math.min(h, (row + 1) * tileSize + overlap);
+                    int[] tile = tiles.get(key);
+                    assertNotNull("missing tile " + key, tile);
+                    assertArrayEquals(key, new int[]{right - left, bottom - top}, sizes.get(key));
+                    for (int y = top; y < bottom; y++) {
+                        for (int x = left; x < right; x++) {
+                            assertEquals(key + " at " + x + "," + y, level[y * w + x],
+                                         tile[(y - top) * (right - left) + x - left]);
+                        }
+                    }
+                    expectedTiles++;
+                }
+            }
+            if (index == 0) {
+                assertEquals(1, w);
+                assertEquals(1, h);
+                break;
+            }
+            int nextW = (w + 1) / 2;
+            int nextH = (h + 1) / 2;
+            int[] next = new int[nextW * nextH];
+            for (int y = 0; y < nextH; y++) {
+                int y0 = 2 * y;
+                int y1 = Math.min(y0 + 1, h - 1);
+                for (int x = 0; x < nextW; x++) {
+                    int x0 = 2 * x;
+                    int x1 = Math.min(x0 + 1, w - 1);
+                    next[y * nextW + x] = reference(level[y0 * w + x0], level[y0 * w + x1],
+                                                    level[y1 * w + x0], level[y1 * w + x1]);
+                }
+            }
+            level = next;
+            w = nextW;
+            h = nextH;
+        }
+        assertEquals(expectedTiles, tilesWritten);
+        assertEquals(expectedTiles, tiles.size());
+    }
+
+    private static int reference(int a, int b, int c, int d) {
+        int result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            int sum = ((a >>> shift) & 0xFF) + ((b >>> shift) & 0xFF) + ((c >>> shift) & 0xFF)
+                + ((d >>> shift) & 0xFF);
+            result |= ((sum + 2) >> 2) << shift;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,190 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * 以合成時鐘與合成幀來源驅動 RealtimeFrameScheduler：60Hz vsync，放大成本以推進時鐘模擬
+ */
+public class RealtimeFrameSchedulerTest {
+
+    private static final long REFRESH_NANOS = 16_666_667L;
+    private static final long MS = 1_000_000L;
+
+    private static final class FakeClock implements RealtimeFrameScheduler.Clock {
+        long now;
+
+        @Override
+        public long nanoTime() {
+            return now;
+        }
+    }
+
+    private static final class Run {
+        final RealtimeFrameScheduler.Stats stats;
+        final List<Integer> presented;
+
+        Run(RealtimeFrameScheduler.Stats stats, List<Integer> presented) {
+            this.stats = stats;
+            this.presented = presented;
+        }
+    }
+
+    private static Run simulate(double sourceFps, long srCostNanos, long fallbackCostNanos,
+                                RealtimeFrameScheduler.MissPolicy policy, long durationNanos) {
+        FakeClock clock = new FakeClock();
+        List<Integer> presented = new ArrayList<>();
+        RealtimeFrameScheduler<Integer> scheduler = new RealtimeFrameScheduler<>(
+            clock, Runnable::run,
+            frame -> {
+                clock.now += srCostNanos;
+                return frame;
+            },
+            frame -> {
+                clock.now += fallbackCostNanos;
+                return frame;
+            },
+            (frame, vsync, fallback) -> presented.add(frame),
+            policy, REFRESH_NANOS, 2, 0.2);
+
+        long frameInterval = (long) (1e9 / sourceFps);
+        long nextFrame = 0;
+        int frameIndex = 0;
+        for (long vsync = 0; vsync < durationNanos; vsync += REFRESH_NANOS) {
+            while (nextFrame <= vsync) {
+                clock.now = nextFrame;
+                scheduler.onFrameDecoded(frameIndex++, nextFrame);
+                nextFrame += frameInterval;
+            }
+            clock.now = vsync;
+            scheduler.onVsync(vsync);
+        }
+        return new Run(scheduler.getStats(), presented);
+    }
+
+    @Test
+    public void fastSrPresentsEveryFrameWithinOneRefresh() {
+        Run run = simulate(30, 5 * MS, 1 * MS, RealtimeFrameScheduler.MissPolicy.DROP, 10_000 * MS);
+        RealtimeFrameScheduler.Stats stats = run.stats;
+
+        assertEquals(0, stats.getDropped());
+        assertEquals(0, stats.framesFallback);
+        assertTrue(stats.framesPresented >= stats.framesIn - 1);
+        assertTrue(stats.motionToPhotonP95Nanos <= 2 * REFRESH_NANOS);
+        assertPresentedInOrder(run.presented);
+    }
+
+    @Test
+    public void slowSrFallsBackToClassicUpscaling() {
+        // SR 45ms 超過兩個週期 (33ms) 的預算
+        Run run = simulate(30, 45 * MS, 3 * MS, RealtimeFrameScheduler.MissPolicy.FALLBACK, 10_000 * MS);
+        RealtimeFrameScheduler.Stats stats = run.stats;
+
+        assertTrue(stats.toString(), stats.framesFallback >= 0.85 * stats.framesPresented);
+        // 只有第一次量測與定期探測會錯過截止
+        assertTrue(stats.toString(), stats.getDroppedRate() < 0.06);
+        assertTrue(stats.toString(), stats.droppedLate > 0);
+        assertTrue(stats.motionToPhotonP95Nanos <= 3 * REFRESH_NANOS);
+        assertPresentedInOrder(run.presented);
+    }
+
+    @Test
+    public void slowSrWithDropPolicyDropsInsteadOfPresentingLate() {
+        Run run = simulate(30, 45 * MS, 3 * MS, RealtimeFrameScheduler.MissPolicy.DROP, 10_000 * MS);
+        RealtimeFrameScheduler.Stats stats = run.stats;
+
+        assertEquals(0, stats.framesFallback);
+        assertEquals(0, stats.framesPresented);
+        assertTrue(stats.toString(), stats.getDroppedRate() > 0.95);
+    }
+
+    @Test
+    public void framesArrivingFasterThanSrAreSupersededAndAccountedFor() {
+        // 60fps 來源，SR 20ms：在預算內但比幀間隔長，一次只能處理一幀
+        Run run = simulate(60, 20 * MS, 2 * MS, RealtimeFrameScheduler.MissPolicy.DROP, 5_000 * MS);
+        RealtimeFrameScheduler.Stats stats = run.stats;
+
+        assertTrue(stats.toString(), stats.droppedSuperseded > 0);
+        assertEquals(0, stats.droppedLate);
+        // 每一幀不是呈現就是丟棄（最後最多一幀待處理、一幀待呈現）
+        long unaccounted = stats.framesIn - stats.framesPresented - stats.getDropped();
+        assertTrue("unaccounted " + unaccounted, unaccounted >= 0 && unaccounted <= 2);
+        assertPresentedInOrder(run.presented);
+    }
+
+    @Test
+    public void everyFrameIsPresentedOrDiscardedExactlyOnce() {
+        assertFramesReleased(60, 20 * MS, 2 * MS, RealtimeFrameScheduler.MissPolicy.DROP);
+        assertFramesReleased(30, 45 * MS, 3 * MS, RealtimeFrameScheduler.MissPolicy.FALLBACK);
+        assertFramesReleased(30, 45 * MS, 3 * MS, RealtimeFrameScheduler.MissPolicy.DROP);
+    }
+
+    /**
+     * 放大產生新的幀（負數）；解碼幀、結果都必須恰好被呈現或捨棄一次
+     */
+    private static void assertFramesReleased(double sourceFps, long srCostNanos, long fallbackCostNanos,
+                                             RealtimeFrameScheduler.MissPolicy policy) {
+        FakeClock clock = new FakeClock();
+        Map<Integer, Integer> released = new HashMap<>();
+        List<Integer> outputs = new ArrayList<>();
+        RealtimeFrameScheduler<Integer> scheduler = new RealtimeFrameScheduler<>(
+            clock, Runnable::run,
+            frame -> {
+                clock.now += srCostNanos;
+                outputs.add(-frame - 1);
+                return -frame - 1;
+            },
+            frame -> {
+                clock.now += fallbackCostNanos;
+                outputs.add(-frame - 1);
+                return -frame - 1;
+            },
+            new RealtimeFrameScheduler.FrameSink<Integer>() {
+                @Override
+                public void present(Integer frame, long vsyncNanos, boolean fallback) {
+                    released.merge(frame, 1, Integer::sum);
+                }
+
+                @Override
+                public void discard(Integer frame) {
+                    released.merge(frame, 1, Integer::sum);
+                }
+            },
+            policy, REFRESH_NANOS, 2, 0.2);
+
+        long frameInterval = (long) (1e9 / sourceFps);
+        long nextFrame = 0;
+        int frameIndex = 0;
+        for (long vsync = 0; vsync < 3_000 * MS; vsync += REFRESH_NANOS) {
+            while (nextFrame <= vsync) {
+                clock.now = nextFrame;
+                scheduler.onFrameDecoded(frameIndex++, nextFrame);
+                nextFrame += frameInterval;
+            }
+            clock.now = vsync;
+            scheduler.onVsync(vsync);
+        }
+        scheduler.clear();
+
+        for (int i = 0; i < frameIndex; i++) {
+            assertEquals("input " + i, Integer.valueOf(1), released.get(i));
+        }
+        for (int output : outputs) {
+            assertEquals("output " + output, Integer.valueOf(1), released.get(output));
+        }
+        assertEquals(frameIndex + outputs.size(), released.size());
+    }
+
+    private static void assertPresentedInOrder(List<Integer> presented) {
+        for (int i = 1; i < presented.size(); i++) {
+            assertTrue("frame order", presented.get(i) > presented.get(i - 1));
+        }
+    }
+}
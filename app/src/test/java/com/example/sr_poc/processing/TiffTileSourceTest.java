@@ -0,0 +1,356 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.zip.Deflater;
+
+import static org.junit.Assert.*;
+
+public class TiffTileSourceTest {
+
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void strippedWithShortLastStrip() throws IOException {
+        // 7 列、每條 3 列：最後一條只有 1 列
+        TiffSpec spec = new TiffSpec(10, 7, 3);
+        spec.rowsPerStrip = 3;
+        try (TiffTileSource source = open(spec)) {
+            assertEquals(10, source.getWidth());
+            assertEquals(7, source.getHeight());
+            assertEquals(10, source.getTileWidth());
+            assertEquals(3, source.getTileHeight());
+            assertRegion(source, spec, 0, 0, 10, 7);
+            assertRegion(source, spec, 2, 2, 5, 5); // 跨越三條strip
+            assertRegion(source, spec, 0, 6, 10, 1);
+        }
+    }
+
+    @Test
+    public void tiledReadsStraddleTilesAndClipPaddedEdges() throws IOException {
+        // 40x30 以 16x16 tile 存放：3x2 個 tile，右側與下方的 tile 含 padding
+        TiffSpec spec = new TiffSpec(40, 30, 4);
+        spec.tileWidth = 16;
+        spec.tileHeight = 16;
+        spec.order = ByteOrder.BIG_ENDIAN;
+        try (TiffTileSource source = open(spec)) {
+            assertEquals(16, source.getTileWidth());
+            assertRegion(source, spec, 0, 0, 40, 30);
+            assertRegion(source, spec, 10, 12, 20, 10); // 四個tile的交界
+            assertRegion(source, spec, 33, 17, 7, 13);  // 只在邊緣tile內
+            assertRegion(source, spec, 15, 15, 2, 2);
+        }
+    }
+
+    @Test
+    public void deflateWithHorizontalPredictor() throws IOException {
+        TiffSpec spec = new TiffSpec(33, 21, 3);
+        spec.rowsPerStrip = 8;
+        spec.compression = 8;
+        spec.predictor = true;
+        try (TiffTileSource source = open(spec)) {
+            assertRegion(source, spec, 0, 0, 33, 21);
+            assertRegion(source, spec, 5, 6, 20, 12);
+        }
+    }
+
+    @Test
+    public void legacyDeflateCodeIsAccepted() throws IOException {
+        TiffSpec spec = new TiffSpec(12, 9, 4);
+        spec.tileWidth = 16;
+        spec.tileHeight = 16;
+        spec.compression = 32946;
+        try (TiffTileSource source = open(spec)) {
+            assertRegion(source, spec, 0, 0, 12, 9);
+        }
+    }
+
+    @Test
+    public void bigTiffTiledGrayscaleDeflate() throws IOException {
+        TiffSpec spec = new TiffSpec(50, 37, 1);
+        spec.bigTiff = true;
+        spec.tileWidth = 16;
+        spec.tileHeight = 16;
+        spec.compression = 8;
+        spec.predictor = true;
+        try (TiffTileSource source = open(spec)) {
+            assertEquals(50, source.getWidth());
+            assertEquals(37, source.getHeight());
+            assertRegion(source, spec, 0, 0, 50, 37);
+            assertRegion(source, spec, 14, 30, 20, 7);
+        }
+    }
+
+    @Test
+    public void smallCacheEvictsAndReloadsTiles() throws IOException {
+        TiffSpec spec = new TiffSpec(64, 64, 3);
+        spec.tileWidth = 16;
+        spec.tileHeight = 16;
+        spec.compression = 8;
+        // 只容得下一個tile，每次跨tile讀取都會淘汰並重新解壓
+        File file = spec.write(folder.newFile());
+        try (TiffTileSource source = new TiffTileSource(file, 16 * 16 * 3)) {
+            for (int pass = 0; pass < 2; pass++) {
+                assertRegion(source, spec, 0, 0, 64, 64);
+                assertRegion(source, spec, 8, 8, 40, 40);
+                assertRegion(source, spec, 48, 0, 16, 64);
+            }
+        }
+    }
+
+    @Test(expected = IOException.class)
+    public void rejectsNonTiffData() throws IOException {
+        File file = folder.newFile();
+        try (OutputStream out = new FileOutputStream(file)) {
+            out.write("not a tiff at all".getBytes());
+        }
+        new TiffTileSource(file, 1 << 20);
+    }
+
+    private TiffTileSource open(TiffSpec spec) throws IOException {
+        return new TiffTileSource(spec.write(folder.newFile()), 1 << 20);
+    }
+
+    private static void assertRegion(TiffTileSource source, TiffSpec spec, int left, int top,
+                                     int width, int height) throws IOException {
+        int[] actual = new int[width * height];
+        source.readRegion(left, top, width, height, actual);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                assertEquals("pixel (" + (left + x) + "," + (top + y) + ")",
+                             Integer.toHexString(spec.expectedArgb(left + x, top + y)),
+                             Integer.toHexString(actual[y * width + x]));
+            }
+        }
+    }
+
+    /**
+     * 產生測試用的 TIFF：樣本值由座標決定，單一 IFD，chunk 資料在前、IFD 在最後
+     */
+    private static final class TiffSpec {
+        final int width;
+        final int height;
+        final int samplesPerPixel;
+        ByteOrder order = ByteOrder.LITTLE_ENDIAN;
+        boolean bigTiff;
+        int tileWidth;   // 0 表示分條
+        int tileHeight;
+        int rowsPerStrip;
+        int compression = 1;
+        boolean predictor;
+
+        TiffSpec(int width, int height, int samplesPerPixel) {
+            this.width = width;
+            this.height = height;
+            this.samplesPerPixel = samplesPerPixel;
+            this.rowsPerStrip = height;
+        }
+
+        int sample(int x, int y, int c) {
+            return (x * 7 + y * 13 + c * 51 + x * y) & 0xFF;
+        }
+
+        int expectedArgb(int x, int y) {
+            if (samplesPerPixel == 1) {
+                int v = sample(x, y, 0);
+                return 0xFF000000 | (v << 16) | (v << 8) | v;
+            }
+            int a = samplesPerPixel == 4 ? sample(x, y, 3) : 0xFF;
+            return (a << 24) | (sample(x, y, 0) << 16) | (sample(x, y, 1) << 8) | sample(x, y, 2);
+        }
+
+        File write(File file) throws IOException {
+            boolean tiled = tileWidth > 0;
+            int chunkWidth = tiled ? tileWidth : width;
+            int chunkHeight = tiled ? tileHeight : rowsPerStrip;
+            int across = (width + chunkWidth - 1) / chunkWidth;
+            int down = (height + chunkHeight - 1) / chunkHeight;
+
+            List<byte[]> chunks = new ArrayList<>();
+            for (int ty = 0; ty < down; ty++) {
+                for (int tx = 0; tx < across; tx++) {
+                    // tile 一律補滿；strip 的最後一條只存實際列數
+                    int rows = tiled ? chunkHeight : Math.min(chunkHeight, height - ty * chunkHeight);
+                    chunks.add(encodeChunk(tx * chunkWidth, ty * chunkHeight, chunkWidth, rows));
+                }
+            }
+
+            int headerSize = bigTiff ? 16 : 8;
+            int dataSize = 0;
+            for (byte[] chunk : chunks) {
+                dataSize += chunk.length;
+            }
+            ByteBuffer out = ByteBuffer.allocate(headerSize + dataSize + chunks.size() * 16 + 1024).order(order);
+            out.put(order == ByteOrder.LITTLE_ENDIAN ? (byte) 'I' : (byte) 'M');
+            out.put(order == ByteOrder.LITTLE_ENDIAN ? (byte) 'I' : (byte) 'M');
+            out.putShort((short) (bigTiff ? 43 : 42));
+            if (bigTiff) {
+                out.putShort((short) 8);
+                out.putShort((short) 0);
+            }
+            int ifdPointer = out.position();
+            out.position(headerSize);
+
+            long[] offsets = new long[chunks.size()];
+            long[] counts = new long[chunks.size()];
+            for (int i = 0; i < chunks.size(); i++) {
+                offsets[i] = out.position();
+                counts[i] = chunks.get(i).length;
+                out.put(chunks.get(i));
+            }
+
+            int offsetType = bigTiff ? 16 : 4;
+            List<long[]> entries = new ArrayList<>(); // {tag, type, values...}
+            entries.add(entry(256, 3, width));
+            entries.add(entry(257, 3, height));
+            long[] bits = new long[samplesPerPixel];
+            Arrays.fill(bits, 8);
+            entries.add(entry(258, 3, bits));
+            entries.add(entry(259, 3, compression));
+            entries.add(entry(262, 3, samplesPerPixel == 1 ? 1 : 2));
+            if (!tiled) {
+                entries.add(entry(273, offsetType, offsets));
+            }
+            entries.add(entry(277, 3, samplesPerPixel));
+            if (!tiled) {
+                entries.add(entry(278, 3, rowsPerStrip));
+                entries.add(entry(279, offsetType, counts));
+            }
+            entries.add(entry(284, 3, 1));
+            if (predictor) {
+                entries.add(entry(317, 3, 2));
+            }
+            if (tiled) {
+                entries.add(entry(322, 3, tileWidth));
+                entries.add(entry(323, 3, tileHeight));
+                entries.add(entry(324, offsetType, offsets));
+                entries.add(entry(325, offsetType, counts));
+            }
+
+            // 放不進欄位的值先寫在 IFD 之前
+            int fieldSize = bigTiff ? 8 : 4;
+            long[] valuePositions = new long[entries.size()];
+            for (int i = 0; i < entries.size(); i++) {
+                long[] e = entries.get(i);
+                int count = e.length - 2;
+                if (count * typeSize((int) e[1]) > fieldSize) {
+                    valuePositions[i] = out.position();
+                    putValues(out, (int) e[1], e, 2, count);
+                }
+            }
+
+            long ifdOffset = out.position();
+            if (bigTiff) {
+                out.putLong(entries.size());
+            } else {
+                out.putShort((short) entries.size());
+            }
+            for (int i = 0; i < entries.size(); i++) {
+                long[] e = entries.get(i);
+                int count = e.length - 2;
+                out.putShort((short) e[0]);
+                out.putShort((short) e[1]);
+                if (bigTiff) {
+                    out.putLong(count);
+                } else {
+                    out.putInt(count);
+                }
+                int field = out.position();
+                if (count * typeSize((int) e[1]) > fieldSize) {
+                    if (bigTiff) {
+                        out.putLong(valuePositions[i]);
+                    } else {
+                        out.putInt((int) valuePositions[i]);
+                    }
+                } else {
+                    putValues(out, (int) e[1], e, 2, count);
+                }
+                out.position(field + fieldSize);
+            }
+            if (bigTiff) {
+                out.putLong(0);
+                out.putLong(ifdPointer, ifdOffset);
+            } else {
+                out.putInt(0);
+                out.putInt(ifdPointer, (int) ifdOffset);
+            }
+
+            try (OutputStream stream = new FileOutputStream(file)) {
+                stream.write(out.array(), 0, out.position());
+            }
+            return file;
+        }
+
+        private byte[] encodeChunk(int left, int top, int chunkWidth, int rows) {
+            int rowBytes = chunkWidth * samplesPerPixel;
+            byte[] raw = new byte[rowBytes * rows];
+            for (int y = 0; y < rows; y++) {
+                for (int x = 0; x < chunkWidth; x++) {
+                    for (int c = 0; c < samplesPerPixel; c++) {
+                        boolean inside = left + x < width && top + y < height;
+                        raw[y * rowBytes + x * samplesPerPixel + c] =
+                            (byte) (inside ? sample(left + x, top + y, c) : 0);
+                    }
+                }
+            }
+            if (predictor) {
+                for (int y = 0; y < rows; y++) {
+                    for (int i = rowBytes - 1; i >= samplesPerPixel; i--) {
+                        int p = y * rowBytes + i;
+                        raw[p] = (byte) (raw[p] - raw[p - samplesPerPixel]);
+                    }
+                }
+            }
+            if (compression == 1) {
+                return raw;
+            }
+            Deflater deflater = new Deflater();
+            deflater.setInput(raw);
+            deflater.finish();
+            byte[] buffer = new byte[raw.length + 64];
+            int length = 0;
+            while (!deflater.finished()) {
+                length += deflater.deflate(buffer, length, buffer.length - length);
+            }
+            deflater.end();
+            return Arrays.copyOf(buffer, length);
+        }
+
+        private static long[] entry(int tag, int type, long... values) {
+            long[] e = new long[values.length + 2];
+            e[0] = tag;
+            e[1] = type;
+            System.arraycopy(values, 0, e, 2, values.length);
+            return e;
+        }
+
+        private static int typeSize(int type) {
+            return type == 3 ? 2 : type == 4 ? 4 : 8;
+        }
+
+        private static void putValues(ByteBuffer out, int type, long[] e, int from, int count) {
+            for (int i = 0; i < count; i++) {
+                long v = e[from + i];
+                if (type == 3) {
+                    out.putShort((short) v);
+                } else if (type == 4) {
+                    out.putInt((int) v);
+                } else {
+                    out.putLong(v);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class TilePlanTest {
+
+    private static final double EPSILON = 1e-9;
+
+    @Test
+    public void inputTilesCoverImageAndClipAtEdges() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        assertEquals(4, plan.getTilesX());
+        assertEquals(3, plan.getTilesY());
+        assertEquals(12, plan.getTileCount());
+
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            assertEquals(tile.column * 24, tile.inputLeft);
+            assertEquals(tile.row * 24, tile.inputTop);
+            assertEquals(Math.min(32, 100 - tile.inputLeft), tile.inputWidth);
+            assertEquals(Math.min(32, 70 - tile.inputTop), tile.inputHeight);
+            assertTrue(tile.inputWidth > 0 && tile.inputHeight > 0);
+        }
+        TilePlan.Tile last = plan.getTiles().get(plan.getTileCount() - 1);
+        assertEquals(100, last.inputLeft + last.inputWidth);
+        assertEquals(70, last.inputTop + last.inputHeight);
+    }
+
+    @Test
+    public void ownershipSplitsAtOverlapMidlineInsideEachTile() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            // 負責範圍必須落在此tile的模型輸出內
+            assertTrue(tile.ownLeft >= tile.inputLeft * 4);
+            assertTrue(tile.ownRight <= (tile.inputLeft + tile.inputWidth) * 4);
+            assertTrue(tile.ownTop >= tile.inputTop * 4);
+            assertTrue(tile.ownBottom <= (tile.inputTop + tile.inputHeight) * 4);
+            if (tile.column > 0) {
+                assertEquals(tile.inputLeft * 4 + 16, tile.ownLeft);
+            }
+        }
+    }
+
+    @Test
+    public void singleTileWhenInputFits() {
+        TilePlan plan = new TilePlan(20, 10, 32, 8, 2);
+        assertEquals(1, plan.getTileCount());
+        TilePlan.Tile tile = plan.getTiles().get(0);
+        assertEquals(0, tile.ownLeft);
+        assertEquals(40, tile.ownRight);
+        assertEquals(20, tile.ownBottom);
+        assertEquals(OutputRegion.identity(40, 20), plan.regionFor(tile, 40, 20));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void overlapMustBeSmallerThanTile() {
+        new TilePlan(100, 100, 16, 16, 2);
+    }
+
+    @Test
+    public void nativeScaleRegionsAreUnitScaleAndCoverOnce() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        assertExactCoverage(plan, 400, 280);
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, 400, 280);
+            assertTrue(region.toString(), region.isUnitScale());
+            assertEquals(tile.ownLeft, region.left);
+            assertEquals(tile.ownRight - tile.ownLeft, region.width);
+            assertEquals(tile.ownLeft - tile.inputLeft * 4, region.originX, EPSILON);
+            assertEquals(tile.ownTop - tile.inputTop * 4, region.originY, EPSILON);
+        }
+    }
+
+    @Test
+    public void arbitraryUpscaleRegionsCoverOnceAndSampleInsideTile() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        assertExactCoverage(plan, 533, 311);
+        assertSamplesInsideTiles(plan, 533, 311);
+    }
+
+    @Test
+    public void downscaleRegionsCoverOnceAndSampleInsideTile() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        assertExactCoverage(plan, 37, 23);
+        assertSamplesInsideTiles(plan, 37, 23);
+    }
+
+    @Test
+    public void tinyTargetLeavesSomeTilesEmpty() {
+        TilePlan plan = new TilePlan(100, 70, 32, 8, 4);
+        int empty = 0;
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, 3, 2);
+            assertTrue(region.width >= 0 && region.height >= 0);
+            if (region.width == 0 || region.height == 0) {
+                empty++;
+            }
+        }
+        assertTrue("Expected tiles without target pixels", empty > 0);
+        assertExactCoverage(plan, 3, 2);
+    }
+
+    /**
+     * 每個目標像素恰好由一個tile寫入
+     */
+    private static void assertExactCoverage(TilePlan plan, int targetWidth, int targetHeight) {
+        int[] owners = new int[targetWidth * targetHeight];
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, targetWidth, targetHeight);
+            assertTrue(region.left >= 0 && region.top >= 0);
+            assertTrue(region.left + region.width <= targetWidth);
+            assertTrue(region.top + region.height <= targetHeight);
+            for (int y = region.top; y < region.top + region.height; y++) {
+                for (int x = region.left; x < region.left + region.width; x++) {
+                    owners[y * targetWidth + x]++;
+                }
+            }
+        }
+        for (int i = 0; i < owners.length; i++) {
+            assertEquals("pixel (" + i % targetWidth + "," + i / targetWidth + ")", 1, owners[i]);
+        }
+    }
+
+    /**
+     * 取樣中心（模型輸出的區域座標）不超出此tile的輸出範圍半個像素以上
+     */
+    private static void assertSamplesInsideTiles(TilePlan plan, int targetWidth, int targetHeight) {
+        int scale = plan.getScale();
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, targetWidth, targetHeight);
+            if (region.width == 0 || region.height == 0) {
+                continue;
+            }
+            double firstX = region.originX;
+            double lastX = region.originX + (region.width - 1) * region.stepX;
+            double firstY = region.originY;
+            double lastY = region.originY + (region.height - 1) * region.stepY;
+            assertTrue(region.toString(), firstX >= -0.5 - EPSILON);
+            assertTrue(region.toString(), firstY >= -0.5 - EPSILON);
+            assertTrue(region.toString(), lastX <= tile.inputWidth * scale - 0.5 + EPSILON);
+            assertTrue(region.toString(), lastY <= tile.inputHeight * scale - 0.5 + EPSILON);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class TileTimingsTest {
+
+    @Test
+    public void latencyRangeIgnoresSkippedAndFailedTiles() {
+        TileTimings timings = new TileTimings(256, 128);
+        timings.add(0, 0, OutputRegion.identity(128, 128), 20_000_000, "GPU", TileTimings.Decision.INFERRED);
+        timings.add(1, 0, new OutputRegion(128, 0, 128, 128, 0, 0, 1, 1), 80_000_000, "worker/GPU",
+                    TileTimings.Decision.ROUTED);
+        timings.add(2, 0, new OutputRegion(256, 0, 0, 128, 0, 0, 1, 1), 0, "GPU", TileTimings.Decision.SKIPPED);
+        timings.add(0, 1, OutputRegion.identity(128, 128), 500_000_000, "GPU", TileTimings.Decision.FAILED);
+
+        assertEquals(4, timings.getRecords().size());
+        assertEquals(20_000_000, timings.getMinLatencyNanos());
+        assertEquals(80_000_000, timings.getMaxLatencyNanos());
+
+        String summary = timings.toString();
+        assertTrue(summary, summary.contains("max 80.0ms at (1,0) on worker/GPU"));
+        assertTrue(summary, summary.contains("1 skipped, 1 failed"));
+    }
+
+    @Test
+    public void emptyTimingsHaveZeroRange() {
+        TileTimings timings = new TileTimings(64, 64);
+        assertEquals(0, timings.getMinLatencyNanos());
+        assertEquals(0, timings.getMaxLatencyNanos());
+        assertTrue(timings.toString().contains("none inferred"));
+    }
+}
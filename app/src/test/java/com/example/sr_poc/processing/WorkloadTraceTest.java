@@ -0,0 +1,70 @@
+package com.example.sr_poc.processing;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.Writer;
+import java.util.List;
+
+import static org.junit.Assert.*;
+
+public class WorkloadTraceTest {
+
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void entryRoundTrips() {
+        WorkloadTrace.Entry entry = new WorkloadTrace.Entry(1250, 1920, 1080, "GPU", true, 3840, 2160,
+                                                            "abc123", "inputs/abc123.png");
+        WorkloadTrace.Entry parsed = WorkloadTrace.Entry.parse(entry.toLine());
+        assertEquals(1250, parsed.offsetMs);
+        assertEquals(1920, parsed.width);
+        assertEquals(1080, parsed.height);
+        assertEquals("GPU", parsed.mode);
+        assertTrue(parsed.tiling);
+        assertEquals(3840, parsed.targetWidth);
+        assertEquals(2160, parsed.targetHeight);
+        assertEquals("abc123", parsed.inputHash);
+        assertEquals("inputs/abc123.png", parsed.inputFile);
+    }
+
+    @Test
+    public void autoModeAndMissingInputRoundTrip() {
+        WorkloadTrace.Entry parsed = WorkloadTrace.Entry.parse(
+            new WorkloadTrace.Entry(0, 640, 480, null, false, 0, 0, "ff", null).toLine());
+        assertEquals(WorkloadTrace.AUTO_MODE, parsed.mode);
+        assertNull(parsed.inputFile);
+    }
+
+    @Test
+    public void readSkipsCommentsAndSortsByOffset() throws IOException {
+        File trace = folder.newFile("workload.tsv");
+        try (Writer out = new FileWriter(trace)) {
+            out.write(WorkloadTrace.HEADER + "\n");
+            out.write(new WorkloadTrace.Entry(300, 64, 64, "CPU", false, 0, 0, "b", null).toLine() + "\n");
+            out.write("\n");
+            // 並行請求可能晚寫入但較早開始
+            out.write(new WorkloadTrace.Entry(100, 64, 64, "CPU", false, 0, 0, "a", null).toLine() + "\n");
+        }
+        List<WorkloadTrace.Entry> entries = WorkloadTrace.read(trace);
+        assertEquals(2, entries.size());
+        assertEquals("a", entries.get(0).inputHash);
+        assertEquals("b", entries.get(1).inputHash);
+    }
+
+    @Test
+    public void inputFileResolvesNextToTrace() throws IOException {
+        File trace = folder.newFile("workload.tsv");
+        folder.newFolder("inputs");
+        File captured = folder.newFile("inputs/a.png");
+        WorkloadTrace.Entry withInput = new WorkloadTrace.Entry(0, 8, 8, null, false, 0, 0, "a", "inputs/a.png");
+        WorkloadTrace.Entry missing = new WorkloadTrace.Entry(0, 8, 8, null, false, 0, 0, "b", "inputs/b.png");
+        assertEquals(captured.getAbsoluteFile(), WorkloadTrace.inputFileFor(trace, withInput));
+        assertNull(WorkloadTrace.inputFileFor(trace, missing));
+    }
+}
@@ -0,0 +1,48 @@
+package com.example.sr_poc.utils;
+
+import org.junit.After;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class EnergyMeterTest {
+
+    private EnergyMeter meter;
+
+    @After
+    public void tearDown() {
+        if (meter != null) {
+            meter.close();
+        }
+    }
+
+    @Test
+    public void constantPowerIntegratesToPowerTimesDuration() throws Exception {
+        meter = new EnergyMeter(EnergyMeter.constant(2.0), 10);
+        EnergyMeter.Measurement measurement = meter.begin();
+        Thread.sleep(200);
+        EnergyMeter.Energy energy = measurement.end();
+
+        assertTrue(energy.isValid());
+        assertEquals(2.0, energy.getAverageWatts(), 0.1);
+        assertEquals(energy.joules * 1e6 / 4_000_000, energy.joulesPerMegapixel(4_000_000), 1e-9);
+    }
+
+    @Test
+    public void unavailableSamplesAreSkipped() throws Exception {
+        meter = new EnergyMeter(() -> -1, 10);
+        EnergyMeter.Measurement measurement = meter.begin();
+        Thread.sleep(50);
+        EnergyMeter.Energy energy = measurement.end();
+
+        assertFalse(energy.isValid());
+        assertEquals(0.0, energy.joules, 0.0);
+    }
+
+    @Test
+    public void endIsIdempotent() {
+        meter = new EnergyMeter(EnergyMeter.constant(1.0), 10);
+        EnergyMeter.Measurement measurement = meter.begin();
+        assertSame(measurement.end(), measurement.end());
+    }
+}
@@ -0,0 +1,60 @@
+package com.example.sr_poc.utils;
+
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.*;
+
+public class JankStatsTest {
+
+    private static final long DEADLINE = 16_666_667; // 60Hz
+
+    @Test
+    public void framesAreGroupedByStageInFirstSeenOrder() {
+        JankStats stats = new JankStats();
+        stats.record("idle", 8_000_000, DEADLINE);
+        stats.record("render", 40_000_000, DEADLINE);
+        stats.record("idle", 9_000_000, DEADLINE);
+
+        List<JankStats.Stage> stages = stats.getStages();
+        assertEquals(2, stages.size());
+        assertEquals("idle", stages.get(0).name);
+        assertEquals(2, stages.get(0).getFrames());
+        assertEquals(0, stages.get(0).getJankyFrames());
+        assertEquals("render", stages.get(1).name);
+        assertEquals(1, stages.get(1).getJankyFrames());
+        // 40ms 在 16.7ms 期限下延後兩個 vsync
+        assertEquals(2, stages.get(1).getMissedVsyncs());
+    }
+
+    @Test
+    public void percentilesUseMillisecondBuckets() {
+        JankStats stats = new JankStats();
+        for (int i = 1; i <= 100; i++) {
+            stats.record("render", i * 1_000_000L - 1, DEADLINE);
+        }
+        JankStats.Stage render = stats.getStages().get(0);
+        assertEquals(50, render.percentileMs(0.50));
+        assertEquals(95, render.percentileMs(0.95));
+        assertEquals(100 - 16, render.getJankyFrames());
+    }
+
+    @Test
+    public void longFramesLandInLastBucket() {
+        JankStats stats = new JankStats();
+        stats.record("store", 2_000_000_000L, DEADLINE);
+        JankStats.Stage store = stats.getStages().get(0);
+        assertEquals(JankStats.MAX_BUCKET_MS + 1, store.percentileMs(1.0));
+        assertEquals(2000.0, store.getMaxMs(), 1e-9);
+    }
+
+    @Test
+    public void resetClearsStages() {
+        JankStats stats = new JankStats();
+        stats.record("render", 1_000_000, DEADLINE);
+        stats.reset();
+        assertTrue(stats.getStages().isEmpty());
+        assertEquals("no frames", stats.toString());
+    }
+}
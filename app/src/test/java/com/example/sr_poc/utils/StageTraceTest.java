@@ -0,0 +1,54 @@
+package com.example.sr_poc.utils;
+
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.*;
+
+public class StageTraceTest {
+
+    @Test
+    public void markClosesPreviousStage() {
+        StageTrace trace = new StageTrace();
+        assertNull(trace.current());
+
+        trace.mark("lookup");
+        assertEquals("lookup", trace.current());
+        trace.mark("render");
+        assertEquals("render", trace.current());
+        trace.finish();
+        assertNull(trace.current());
+
+        List<StageTrace.Stage> stages = trace.getStages();
+        assertEquals(2, stages.size());
+        assertEquals(stages.get(1).startNanos, stages.get(0).getEndNanos());
+        assertTrue(stages.get(1).getEndNanos() >= stages.get(1).startNanos);
+    }
+
+    @Test
+    public void finishIsIdempotent() {
+        StageTrace trace = new StageTrace();
+        trace.mark("render");
+        trace.finish();
+        long end = trace.getStages().get(0).getEndNanos();
+        trace.finish();
+        assertEquals(end, trace.getStages().get(0).getEndNanos());
+    }
+
+    @Test
+    public void stageAtFindsStageContainingTime() {
+        StageTrace trace = new StageTrace();
+        trace.mark("lookup");
+        trace.mark("render");
+        trace.finish();
+        List<StageTrace.Stage> stages = trace.getStages();
+        StageTrace.Stage lookup = stages.get(0);
+        StageTrace.Stage render = stages.get(1);
+
+        assertNull(trace.stageAt(lookup.startNanos - 1));
+        assertEquals("lookup", trace.stageAt(lookup.startNanos));
+        assertEquals("render", trace.stageAt(render.startNanos));
+        assertNull(trace.stageAt(render.getEndNanos()));
+    }
+}
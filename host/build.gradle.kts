@@ -0,0 +1,70 @@
+plugins {
+    application
+}
+
+// Host (Linux, CPU-only) build of the tiling/conversion core. The Android-free sources are
+// compiled straight from :app so both deployments run the same tiling and output kernel code.
+val sharedSources = listOf(
+    "com/example/sr_poc/processing/BandWorkers.java",
+    "com/example/sr_poc/processing/DynamicBatcher.java",
+    "com/example/sr_poc/processing/OutputKernel.java",
+    "com/example/sr_poc/processing/OutputRegion.java",
+    "com/example/sr_poc/processing/ParallelPngEncoder.java",
+    "com/example/sr_poc/processing/PostProcessChain.java",
+    "com/example/sr_poc/processing/RawRgbaTileSource.java",
+    "com/example/sr_poc/processing/TilePlan.java",
+    "com/example/sr_poc/processing/TileSource.java",
+    "com/example/sr_poc/processing/WorkloadTrace.java",
+    "com/example/sr_poc/utils/BitmapConverter.java",
+    "com/example/sr_poc/utils/Constants.java",
+    "com/example/sr_poc/utils/EnergyMeter.java"
+)
+
+sourceSets {
+    main {
+        java {
+            srcDir("../app/src/main/java")
+            include("com/example/sr_poc/host/**")
+            include(sharedSources)
+        }
+    }
+}
+
+java {
+    sourceCompatibility = JavaVersion.VERSION_17
+    targetCompatibility = JavaVersion.VERSION_17
+}
+
+application {
+    mainClass.set("com.example.sr_poc.host.UpscaleDaemon")
+}
+
+tasks.register<JavaExec>("loadgen") {
+    group = "application"
+    description = "Runs the load generator against a running daemon"
+    classpath = sourceSets["main"].runtimeClasspath
+    mainClass.set("com.example.sr_poc.host.LoadGenerator")
+}
+
+tasks.register<JavaExec>("replay") {
+    group = "application"
+    description = "Replays a captured app workload against a running daemon"
+    classpath = sourceSets["main"].runtimeClasspath
+    mainClass.set("com.example.sr_poc.host.WorkloadReplay")
+}
+
+tasks.register<JavaExec>("farm") {
+    group = "application"
+    description = "Tile farm coordinator: plan, run-local, scaling (1 vs N worker wall time) or stitch"
+    classpath = sourceSets["main"].runtimeClasspath
+    mainClass.set("com.example.sr_poc.host.farm.FarmCoordinator")
+}
+
+tasks.test {
+    // 農場測試以獨立JVM啟動worker，需要完整的測試classpath
+    systemProperty("farm.classpath", sourceSets["test"].runtimeClasspath.asPath)
+}
+
+dependencies {
+    testImplementation(libs.junit)
+}
@@ -0,0 +1,37 @@
+package com.example.sr_poc.host;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * 解析 --key value 形式的命令列參數
+ */
+public final class Args {
+
+    private final Map<String, String> values = new HashMap<>();
+
+    public Args(String[] args) {
+        for (int i = 0; i < args.length; i++) {
+            if (!args[i].startsWith("--")) {
+                throw new IllegalArgumentException("Unexpected argument " + args[i]);
+            }
+            String key = args[i].substring(2);
+            boolean hasValue = i + 1 < args.length && !args[i + 1].startsWith("--");
+            values.put(key, hasValue ? args[++i] : "true");
+        }
+    }
+
+    public String get(String key, String defaultValue) {
+        return values.getOrDefault(key, defaultValue);
+    }
+
+    public long getLong(String key, long defaultValue) {
+        String value = values.get(key);
+        return value != null ? Long.parseLong(value) : defaultValue;
+    }
+
+    public int getInt(String key, int defaultValue) {
+        String value = values.get(key);
+        return value != null ? Integer.parseInt(value) : defaultValue;
+    }
+}
@@ -0,0 +1,97 @@
+package com.example.sr_poc.host;
+
+/**
+ * 內建的 Catmull-Rom 雙三次放大，作為沒有模型時的基準後端與負載測試用的推理替身
+ */
+public final class BicubicEngine implements InferenceEngine {
+
+    private final int tileSize;
+    private final int scale;
+    // 每個輸出座標的4個來源索引與權重（水平、垂直相同）
+    private final int[] taps;
+    private final float[] weights;
+    private final float[] rowBuffer;
+
+    public BicubicEngine(int tileSize, int scale) {
+        this.tileSize = tileSize;
+        this.scale = scale;
+        int outSize = tileSize * scale;
+        this.taps = new int[outSize * 4];
+        this.weights = new float[outSize * 4];
+        this.rowBuffer = new float[tileSize * outSize * 3];
+
+        for (int o = 0; o < outSize; o++) {
+            double center = (o + 0.5) / scale - 0.5;
+            int base = (int) Math.floor(center);
+            double t = center - base;
+            for (int k = 0; k < 4; k++) {
+                taps[o * 4 + k] = Math.max(0, Math.min(tileSize - 1, base - 1 + k));
+                weights[o * 4 + k] = (float) cubic(k - 1 - t);
+            }
+        }
+    }
+
+    @Override
+    public int getTileSize() {
+        return tileSize;
+    }
+
+    @Override
+    public int getScale() {
+        return scale;
+    }
+
+    @Override
+    public void infer(float[][] inputs, float[][] outputs, int count) {
+        for (int i = 0; i < count; i++) {
+            upscale(inputs[i], outputs[i]);
+        }
+    }
+
+    private void upscale(float[] in, float[] out) {
+        int outSize = tileSize * scale;
+        // 水平方向：tileSize 列 x outSize 欄
+        for (int y = 0; y < tileSize; y++) {
+            int src = y * tileSize * 3;
+            int dst = y * outSize * 3;
+            for (int x = 0; x < outSize; x++) {
+                for (int c = 0; c < 3; c++) {
+                    float sum = 0f;
+                    for (int k = 0; k < 4; k++) {
+                        sum += weights[x * 4 + k] * in[src + taps[x * 4 + k] * 3 + c];
+                    }
+                    rowBuffer[dst + x * 3 + c] = sum;
+                }
+            }
+        }
+        // 垂直方向
+        int stride = outSize * 3;
+        for (int y = 0; y < outSize; y++) {
+            int dst = y * stride;
+            int r0 = taps[y * 4] * stride;
+            int r1 = taps[y * 4 + 1] * stride;
+            int r2 = taps[y * 4 + 2] * stride;
+            int r3 = taps[y * 4 + 3] * stride;
+            float w0 = weights[y * 4];
+            float w1 = weights[y * 4 + 1];
+            float w2 = weights[y * 4 + 2];
+            float w3 = weights[y * 4 + 3];
+            for (int i = 0; i < stride; i++) {
+                float v = w0 * rowBuffer[r0 + i] + w1 * rowBuffer[r1 + i]
+                        + w2 * rowBuffer[r2 + i] + w3 * rowBuffer[r3 + i];
+                out[dst + i] = Math.max(0f, Math.min(1f, v));
+            }
+        }
+    }
+
+    private static double cubic(double x) {
+        x = Math.abs(x);
+        if (x < 1) {
+            return 1.5 * x * x * x - 2.5 * x * x + 1;
+        }
+        if (x < 2) {
+            return -0.5 * x * x * x + 2.5 * x * x - 4 * x + 2;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,101 @@
+package com.example.sr_poc.host;
+
+import java.util.ArrayDeque;
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.IntSupplier;
+
+/**
+ * 守護程序的運作指標：佇列深度、工作延遲百分位（最近 LATENCY_WINDOW 筆）、
+ * 最近 THROUGHPUT_WINDOW_MS 內的吞吐量，以及平均批次大小
+ */
+public final class HostMetrics {
+
+    private static final int LATENCY_WINDOW = 1024;
+    private static final long THROUGHPUT_WINDOW_MS = 10_000;
+
+    private final AtomicInteger jobsInFlight = new AtomicInteger();
+    private final AtomicLong jobsTotal = new AtomicLong();
+    private final AtomicLong errorsTotal = new AtomicLong();
+    private final AtomicLong batches = new AtomicLong();
+    private final AtomicLong batchedTiles = new AtomicLong();
+    private volatile IntSupplier tileQueueDepth = () -> 0;
+
+    private final long[] latencies = new long[LATENCY_WINDOW];
+    private int latencyCount;
+    private int latencyNext;
+
+    // (完成時間ms, 輸出像素數) 的滑動視窗
+    private final ArrayDeque<long[]> completions = new ArrayDeque<>();
+
+    void setTileQueueDepth(IntSupplier tileQueueDepth) {
+        this.tileQueueDepth = tileQueueDepth;
+    }
+
+    void jobStarted() {
+        jobsInFlight.incrementAndGet();
+    }
+
+    void jobFinished(long latencyNanos, long outputPixels) {
+        jobsInFlight.decrementAndGet();
+        jobsTotal.incrementAndGet();
+        long now = System.currentTimeMillis();
+        synchronized (this) {
+            latencies[latencyNext] = latencyNanos;
+            latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+            latencyCount = Math.min(latencyCount + 1, LATENCY_WINDOW);
+            completions.add(new long[] {now, outputPixels});
+            expire(now);
+        }
+    }
+
+    void jobFailed() {
+        jobsInFlight.decrementAndGet();
+        errorsTotal.incrementAndGet();
+    }
+
+    void batchRun(int size) {
+        batches.incrementAndGet();
+        batchedTiles.addAndGet(size);
+    }
+
+    private void expire(long now) {
+        while (!completions.isEmpty() && now - completions.peekFirst()[0] > THROUGHPUT_WINDOW_MS) {
+            completions.pollFirst();
+        }
+    }
+
+    public synchronized String toJson() {
+        long now = System.currentTimeMillis();
+        expire(now);
+        long pixels = 0;
+        for (long[] completion : completions) {
+            pixels += completion[1];
+        }
+        double seconds = THROUGHPUT_WINDOW_MS / 1000.0;
+
+        long[] sorted = Arrays.copyOf(latencies, latencyCount);
+        Arrays.sort(sorted);
+        long batchCount = batches.get();
+
+        return String.format(Locale.US,
+            "{\"jobs_in_flight\":%d,\"tiles_queued\":%d,\"jobs_total\":%d,\"errors_total\":%d,"
+            + "\"latency_ms\":{\"p50\":%.1f,\"p95\":%.1f,\"p99\":%.1f,\"samples\":%d},"
+            + "\"throughput\":{\"jobs_per_s\":%.2f,\"mpix_per_s\":%.2f,\"window_s\":%.0f},"
+            + "\"batching\":{\"batches\":%d,\"mean_size\":%.2f}}",
+            jobsInFlight.get(), tileQueueDepth.getAsInt(), jobsTotal.get(), errorsTotal.get(),
+            percentileMs(sorted, 0.50), percentileMs(sorted, 0.95), percentileMs(sorted, 0.99), sorted.length,
+            completions.size() / seconds, pixels / seconds / 1e6, seconds,
+            batchCount, batchCount > 0 ? (double) batchedTiles.get() / batchCount : 0.0);
+    }
+
+    static double percentileMs(long[] sortedNanos, double p) {
+        if (sortedNanos.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.min(sortedNanos.length - 1, Math.ceil(p * sortedNanos.length) - 1);
+        return sortedNanos[Math.max(0, index)] / 1e6;
+    }
+}
@@ -0,0 +1,68 @@
+package com.example.sr_poc.host;
+
+import com.example.sr_poc.processing.ParallelPngEncoder;
+
+import java.awt.image.BufferedImage;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.zip.Deflater;
+import javax.imageio.ImageIO;
+
+/**
+ * 主機端影像編解碼：解碼用 ImageIO，PNG 輸出與 App 共用 ParallelPngEncoder
+ */
+final class ImageCodec {
+
+    private static final int STRIP_ROWS = 64;
+
+    private static final AtomicInteger THREAD_COUNTER = new AtomicInteger();
+    private static final ExecutorService ENCODER = Executors.newFixedThreadPool(
+        Runtime.getRuntime().availableProcessors(), r -> {
+            Thread thread = new Thread(r, "PngEncoder-" + THREAD_COUNTER.incrementAndGet());
+            thread.setDaemon(true);
+            return thread;
+        });
+
+    private ImageCodec() {
+        // Prevent instantiation
+    }
+
+    static UpscaleService.Image decode(byte[] data) throws IOException {
+        BufferedImage image = ImageIO.read(new ByteArrayInputStream(data));
+        if (image == null) {
+            throw new IOException("Unrecognized image data");
+        }
+        int width = image.getWidth();
+        int height = image.getHeight();
+        int[] pixels = image.getRGB(0, 0, width, height, null, 0, width);
+        return new UpscaleService.Image(width, height, pixels);
+    }
+
+    static byte[] encode(UpscaleService.Image image, byte format) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream(image.width * image.height);
+        if (format == Protocol.FORMAT_JPEG) {
+            BufferedImage buffered = new BufferedImage(image.width, image.height, BufferedImage.TYPE_INT_RGB);
+            buffered.setRGB(0, 0, image.width, image.height, image.pixels, 0, image.width);
+            if (!ImageIO.write(buffered, "jpeg", out)) {
+                throw new IOException("No JPEG writer");
+            }
+            return out.toByteArray();
+        }
+
+        ParallelPngEncoder encoder = new ParallelPngEncoder(out, image.width, image.height, false, ENCODER,
+                                                            Deflater.DEFAULT_COMPRESSION, STRIP_ROWS,
+                                                            2 * Runtime.getRuntime().availableProcessors());
+        for (int y = 0; y < image.height; y += STRIP_ROWS) {
+            int rows = Math.min(STRIP_ROWS, image.height - y);
+            int[] strip = new int[image.width * rows];
+            System.arraycopy(image.pixels, y * image.width, strip, 0, strip.length);
+            encoder.writeRows(strip, rows);
+        }
+        encoder.finish();
+        return out.toByteArray();
+    }
+}
@@ -0,0 +1,39 @@
+package com.example.sr_poc.host;
+
+/**
+ * 主機端推理後端。每個推理執行緒持有一個實例（模型常駐、不重複載入），不需執行緒安全。
+ * 張量格式與 App 端 float32 模型相同：NHWC、RGB 交錯、數值範圍 [0,1]。
+ */
+public interface InferenceEngine extends AutoCloseable {
+
+    /** 方形輸入tile邊長 */
+    int getTileSize();
+
+    /** 輸出倍率 */
+    int getScale();
+
+    /**
+     * 執行一批tile；outputs 已配置好 (tileSize*scale)^2*3 個float
+     */
+    void infer(float[][] inputs, float[][] outputs, int count) throws Exception;
+
+    @Override
+    default void close() {
+    }
+
+    interface Factory {
+        InferenceEngine create() throws Exception;
+    }
+
+    /**
+     * "bicubic" 為內建參考實作；其他名稱視為具有 (int tileSize, int scale) 建構子的類別名稱
+     */
+    static Factory factoryFor(String name, int tileSize, int scale) {
+        if ("bicubic".equals(name)) {
+            return () -> new BicubicEngine(tileSize, scale);
+        }
+        return () -> (InferenceEngine) Class.forName(name)
+            .getConstructor(int.class, int.class)
+            .newInstance(tileSize, scale);
+    }
+}
@@ -0,0 +1,138 @@
+package com.example.sr_poc.host;
+
+import com.example.sr_poc.utils.EnergyMeter;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.net.StandardProtocolFamily;
+import java.net.UnixDomainSocketAddress;
+import java.nio.channels.Channels;
+import java.nio.channels.SocketChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 守護程序的封閉迴圈負載產生器：concurrency 條連線各自連續送出請求，
+ * 結束時輸出延遲百分位與吞吐量，並附上伺服器端 metrics。
+ *
+ * <pre>
+ * --socket /tmp/sr_upscale.sock  --image in.png  --concurrency 4  --requests 100
+ * --format png|jpeg  --warmup 4  [--power-watts 15]
+ * </pre>
+ *
+ * 主機沒有電池量測，--power-watts 以固定功率估算能耗（如機器的平均負載功率），輸出每百萬像素焦耳數。
+ */
+public final class LoadGenerator {
+
+    public static void main(String[] argv) throws Exception {
+        Args args = new Args(argv);
+        Path socketPath = Path.of(args.get("socket", "/tmp/sr_upscale.sock"));
+        byte[] image = Files.readAllBytes(Path.of(args.get("image", "input.png")));
+        int concurrency = args.getInt("concurrency", 4);
+        int requests = args.getInt("requests", 100);
+        int warmup = args.getInt("warmup", concurrency);
+        byte format = "jpeg".equals(args.get("format", "png")) ? Protocol.FORMAT_JPEG : Protocol.FORMAT_PNG;
+        double powerWatts = Double.parseDouble(args.get("power-watts", "-1"));
+        EnergyMeter meter = powerWatts > 0 ? new EnergyMeter(EnergyMeter.constant(powerWatts), 100) : null;
+
+        // 暖機請求不列入統計
+        runClosedLoop(socketPath, image, format, Math.min(concurrency, Math.max(1, warmup)), warmup);
+
+        long start = System.nanoTime();
+        EnergyMeter.Measurement measurement = meter != null ? meter.begin() : null;
+        long[] latencies = runClosedLoop(socketPath, image, format, concurrency, requests);
+        EnergyMeter.Energy energy = measurement != null ? measurement.end() : null;
+        double seconds = (System.nanoTime() - start) / 1e9;
+
+        Arrays.sort(latencies);
+        System.out.println(String.format(Locale.US,
+            "%d requests, concurrency %d: %.2f req/s, latency p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms",
+            latencies.length, concurrency, latencies.length / seconds,
+            HostMetrics.percentileMs(latencies, 0.50), HostMetrics.percentileMs(latencies, 0.95),
+            HostMetrics.percentileMs(latencies, 0.99),
+            latencies.length > 0 ? latencies[latencies.length - 1] / 1e6 : 0));
+        if (energy != null) {
+            long outputPixels = outputPixels(socketPath, image, format) * latencies.length;
+            System.out.println(String.format(Locale.US, "energy: %s, %.3f J/MP",
+                                             energy, energy.joulesPerMegapixel(outputPixels)));
+            meter.close();
+        }
+
+        try (Connection connection = new Connection(socketPath)) {
+            Protocol.writeMetricsRequest(connection.out);
+            System.out.println("server: " + new String(Protocol.readResponse(connection.in), StandardCharsets.UTF_8));
+        }
+    }
+
+    /**
+     * 每個請求的輸出像素數（所有請求相同，送一次並解碼回應）
+     */
+    private static long outputPixels(Path socketPath, byte[] image, byte format) throws IOException {
+        try (Connection connection = new Connection(socketPath)) {
+            Protocol.writeUpscaleRequest(connection.out, image, 0, 0, format);
+            UpscaleService.Image result = ImageCodec.decode(Protocol.readResponse(connection.in));
+            return (long) result.width * result.height;
+        }
+    }
+
+    private static long[] runClosedLoop(Path socketPath, byte[] image, byte format, int concurrency, int requests)
+            throws Exception {
+        if (requests <= 0) {
+            return new long[0];
+        }
+        AtomicInteger remaining = new AtomicInteger(requests);
+        ExecutorService clients = Executors.newFixedThreadPool(concurrency);
+        List<Future<List<Long>>> futures = new ArrayList<>();
+        for (int i = 0; i < concurrency; i++) {
+            futures.add(clients.submit(() -> {
+                List<Long> samples = new ArrayList<>();
+                try (Connection connection = new Connection(socketPath)) {
+                    while (remaining.getAndDecrement() > 0) {
+                        long start = System.nanoTime();
+                        Protocol.writeUpscaleRequest(connection.out, image, 0, 0, format);
+                        Protocol.readResponse(connection.in);
+                        samples.add(System.nanoTime() - start);
+                    }
+                }
+                return samples;
+            }));
+        }
+
+        List<Long> all = new ArrayList<>();
+        for (Future<List<Long>> future : futures) {
+            all.addAll(future.get());
+        }
+        clients.shutdown();
+        return all.stream().mapToLong(Long::longValue).toArray();
+    }
+
+    static final class Connection implements AutoCloseable {
+        final SocketChannel channel;
+        final DataInputStream in;
+        final DataOutputStream out;
+
+        Connection(Path socketPath) throws IOException {
+            channel = SocketChannel.open(StandardProtocolFamily.UNIX);
+            channel.connect(UnixDomainSocketAddress.of(socketPath));
+            in = new DataInputStream(new BufferedInputStream(Channels.newInputStream(channel)));
+            out = new DataOutputStream(new BufferedOutputStream(Channels.newOutputStream(channel), 64 * 1024));
+        }
+
+        @Override
+        public void close() throws IOException {
+            channel.close();
+        }
+    }
+}
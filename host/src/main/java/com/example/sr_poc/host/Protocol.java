@@ -0,0 +1,79 @@
+package com.example.sr_poc.host;
+
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * Unix socket 上的請求/回應格式（大端序），一條連線可依序送出多個請求：
+ * <pre>
+ * request  : byte command
+ *   'U'    : int targetWidth, int targetHeight (0 = 模型倍率), byte format (0 PNG, 1 JPEG), int length, bytes
+ *   'M'    : (無內容) 取得 metrics JSON
+ * response : byte status (0 OK, 1 錯誤), int length, bytes (影像、metrics JSON 或 UTF-8 錯誤訊息)
+ * </pre>
+ */
+public final class Protocol {
+
+    public static final byte COMMAND_UPSCALE = 'U';
+    public static final byte COMMAND_METRICS = 'M';
+
+    public static final byte FORMAT_PNG = 0;
+    public static final byte FORMAT_JPEG = 1;
+
+    public static final byte STATUS_OK = 0;
+    public static final byte STATUS_ERROR = 1;
+
+    /** 單一影像上限，避免惡意長度造成巨量配置 */
+    public static final int MAX_PAYLOAD_BYTES = 512 * 1024 * 1024;
+
+    private Protocol() {
+        // Prevent instantiation
+    }
+
+    public static void writeUpscaleRequest(DataOutputStream out, byte[] image, int targetWidth, int targetHeight,
+                                           byte format) throws IOException {
+        out.writeByte(COMMAND_UPSCALE);
+        out.writeInt(targetWidth);
+        out.writeInt(targetHeight);
+        out.writeByte(format);
+        out.writeInt(image.length);
+        out.write(image);
+        out.flush();
+    }
+
+    public static void writeMetricsRequest(DataOutputStream out) throws IOException {
+        out.writeByte(COMMAND_METRICS);
+        out.flush();
+    }
+
+    public static void writeResponse(DataOutputStream out, byte status, byte[] payload) throws IOException {
+        out.writeByte(status);
+        out.writeInt(payload.length);
+        out.write(payload);
+        out.flush();
+    }
+
+    /**
+     * 讀取回應內容；伺服器回報錯誤時拋出 IOException
+     */
+    public static byte[] readResponse(DataInputStream in) throws IOException {
+        byte status = in.readByte();
+        byte[] payload = readPayload(in);
+        if (status != STATUS_OK) {
+            throw new IOException("Server error: " + new String(payload, StandardCharsets.UTF_8));
+        }
+        return payload;
+    }
+
+    static byte[] readPayload(DataInputStream in) throws IOException {
+        int length = in.readInt();
+        if (length < 0 || length > MAX_PAYLOAD_BYTES) {
+            throw new IOException("Invalid payload length " + length);
+        }
+        byte[] payload = new byte[length];
+        in.readFully(payload);
+        return payload;
+    }
+}
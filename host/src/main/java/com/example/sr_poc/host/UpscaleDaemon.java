@@ -0,0 +1,159 @@
+package com.example.sr_poc.host;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.EOFException;
+import java.io.IOException;
+import java.net.StandardProtocolFamily;
+import java.net.UnixDomainSocketAddress;
+import java.nio.channels.Channels;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * 主機端超解析度守護程序：在 Unix domain socket 上接受放大工作（協定見 Protocol）。
+ * engine 在啟動時載入並常駐，並行連線的tile由 UpscaleService 合併批次推理。
+ *
+ * <pre>
+ * --socket /tmp/sr.sock  --engine bicubic|類別名稱  --tile 128  --scale 4  --overlap 32
+ * --threads N  --batch 4  --batch-delay-ms 5  --metrics-interval-s 10 (0 關閉)
+ * </pre>
+ */
+public final class UpscaleDaemon {
+
+    private static final Logger LOG = Logger.getLogger("UpscaleDaemon");
+
+    private final UpscaleService service;
+    private final HostMetrics metrics;
+    private final ExecutorService connections = Executors.newCachedThreadPool();
+    private volatile boolean running = true;
+
+    UpscaleDaemon(UpscaleService service, HostMetrics metrics) {
+        this.service = service;
+        this.metrics = metrics;
+    }
+
+    public static void main(String[] argv) throws Exception {
+        Args args = new Args(argv);
+        Path socketPath = Path.of(args.get("socket", "/tmp/sr_upscale.sock"));
+        int threads = args.getInt("threads", Math.max(1, Runtime.getRuntime().availableProcessors() / 2));
+
+        HostMetrics metrics = new HostMetrics();
+        InferenceEngine.Factory factory = InferenceEngine.factoryFor(args.get("engine", "bicubic"),
+                                                                     args.getInt("tile", 128),
+                                                                     args.getInt("scale", 4));
+        UpscaleService service = new UpscaleService(factory, threads, args.getInt("batch", 4),
+                                                    args.getInt("batch-delay-ms", 5),
+                                                    args.getInt("overlap", 32), metrics);
+        LOG.info(String.format("Engines ready: %d x tile %d, scale %d", threads,
+                               service.getTileSize(), service.getScale()));
+
+        int metricsInterval = args.getInt("metrics-interval-s", 10);
+        ScheduledExecutorService reporter = Executors.newSingleThreadScheduledExecutor(r -> {
+            Thread thread = new Thread(r, "MetricsReporter");
+            thread.setDaemon(true);
+            return thread;
+        });
+        if (metricsInterval > 0) {
+            reporter.scheduleAtFixedRate(() -> LOG.info(metrics.toJson()),
+                                         metricsInterval, metricsInterval, TimeUnit.SECONDS);
+        }
+
+        UpscaleDaemon daemon = new UpscaleDaemon(service, metrics);
+        daemon.serve(socketPath);
+    }
+
+    void serve(Path socketPath) throws IOException {
+        Files.deleteIfExists(socketPath);
+        try (ServerSocketChannel server = ServerSocketChannel.open(StandardProtocolFamily.UNIX)) {
+            server.bind(UnixDomainSocketAddress.of(socketPath));
+            Runtime.getRuntime().addShutdownHook(new Thread(() -> {
+                running = false;
+                try {
+                    server.close();
+                    Files.deleteIfExists(socketPath);
+                } catch (IOException e) {
+                    LOG.log(Level.WARNING, "Shutdown cleanup failed", e);
+                }
+                connections.shutdownNow();
+                service.close();
+            }));
+            LOG.info("Listening on " + socketPath);
+
+            while (running) {
+                SocketChannel client;
+                try {
+                    client = server.accept();
+                } catch (IOException e) {
+                    if (running) {
+                        throw e;
+                    }
+                    break;
+                }
+                connections.execute(() -> handle(client));
+            }
+        }
+    }
+
+    private void handle(SocketChannel client) {
+        try (SocketChannel channel = client;
+             DataInputStream in = new DataInputStream(new BufferedInputStream(Channels.newInputStream(channel)));
+             DataOutputStream out = new DataOutputStream(
+                 new BufferedOutputStream(Channels.newOutputStream(channel), 64 * 1024))) {
+            while (true) {
+                int command;
+                try {
+                    command = in.readByte();
+                } catch (EOFException e) {
+                    return;
+                }
+                if (command == Protocol.COMMAND_UPSCALE) {
+                    handleUpscale(in, out);
+                } else if (command == Protocol.COMMAND_METRICS) {
+                    Protocol.writeResponse(out, Protocol.STATUS_OK, metrics.toJson().getBytes(StandardCharsets.UTF_8));
+                } else {
+                    Protocol.writeResponse(out, Protocol.STATUS_ERROR,
+                                           ("Unknown command " + command).getBytes(StandardCharsets.UTF_8));
+                    return;
+                }
+            }
+        } catch (IOException e) {
+            LOG.log(Level.FINE, "Connection closed", e);
+        }
+    }
+
+    private void handleUpscale(DataInputStream in, DataOutputStream out) throws IOException {
+        int targetWidth = in.readInt();
+        int targetHeight = in.readInt();
+        byte format = in.readByte();
+        byte[] data = Protocol.readPayload(in);
+
+        long start = System.nanoTime();
+        metrics.jobStarted();
+        byte[] encoded;
+        try {
+            UpscaleService.Image input = ImageCodec.decode(data);
+            UpscaleService.Image output = service.upscale(input.pixels, input.width, input.height,
+                                                          targetWidth, targetHeight);
+            encoded = ImageCodec.encode(output, format);
+            metrics.jobFinished(System.nanoTime() - start, (long) output.width * output.height);
+        } catch (IOException | RuntimeException | OutOfMemoryError e) {
+            metrics.jobFailed();
+            LOG.log(Level.WARNING, "Job failed", e);
+            Protocol.writeResponse(out, Protocol.STATUS_ERROR, String.valueOf(e).getBytes(StandardCharsets.UTF_8));
+            return;
+        }
+        Protocol.writeResponse(out, Protocol.STATUS_OK, encoded);
+    }
+}
@@ -0,0 +1,264 @@
+package com.example.sr_poc.host;
+
+import com.example.sr_poc.processing.DynamicBatcher;
+import com.example.sr_poc.processing.OutputKernel;
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.TilePlan;
+import com.example.sr_poc.utils.BitmapConverter;
+
+import java.io.Closeable;
+import java.io.IOException;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * 與 App 相同的分塊流程（TilePlan 切塊、OutputKernel 轉換/重取樣），推理改由常駐的 InferenceEngine 執行。
+ * 所有工作的tile進入同一個 DynamicBatcher，並行的工作會被合併成批次推理。
+ * 每個工作同時送出的tile數有上限（數個批次），大圖不會一次持有全部tile的輸入與輸出。
+ */
+public final class UpscaleService implements Closeable {
+
+    private static final Logger LOG = Logger.getLogger("UpscaleService");
+    private static final int IN_FLIGHT_BATCHES = 3;
+
+    public static final class Image {
+        public final int width;
+        public final int height;
+        public final int[] pixels;
+
+        public Image(int width, int height, int[] pixels) {
+            this.width = width;
+            this.height = height;
+            this.pixels = pixels;
+        }
+    }
+
+    private static final class TileRequest {
+        final float[] input;
+        final OutputRegion region;
+        final Semaphore inFlight; // 所屬工作的名額，批次完成時歸還
+        final CompletableFuture<int[]> result = new CompletableFuture<>();
+
+        TileRequest(float[] input, OutputRegion region, Semaphore inFlight) {
+            this.input = input;
+            this.region = region;
+            this.inFlight = inFlight;
+        }
+    }
+
+    /** 常駐的engine與其批次緩衝，同一時間只由一個推理執行緒使用 */
+    private static final class EngineSlot {
+        final InferenceEngine engine;
+        final OutputKernel kernel = new OutputKernel(null);
+        final float[][] inputs;
+        final float[][] outputs;
+
+        EngineSlot(InferenceEngine engine, int maxBatchSize) {
+            this.engine = engine;
+            int outSize = engine.getTileSize() * engine.getScale();
+            this.inputs = new float[maxBatchSize][];
+            this.outputs = new float[maxBatchSize][outSize * outSize * 3];
+        }
+    }
+
+    private final int tileSize;
+    private final int scale;
+    private final int overlapPixels;
+    private final int maxBatchSize;
+    private final HostMetrics metrics;
+    private final ExecutorService inferenceExecutor;
+    private final ScheduledExecutorService timer;
+    private final DynamicBatcher<TileRequest> batcher;
+    private final List<EngineSlot> slots = new ArrayList<>();
+    private final BlockingQueue<EngineSlot> idleSlots = new LinkedBlockingQueue<>();
+
+    public UpscaleService(InferenceEngine.Factory factory, int threads, int maxBatchSize, long maxDelayMs,
+                          int overlapPixels, HostMetrics metrics) throws Exception {
+        this.maxBatchSize = Math.max(1, maxBatchSize);
+        this.overlapPixels = overlapPixels;
+        this.metrics = metrics;
+
+        // 啟動時就載入所有engine，第一個請求不需等待模型初始化
+        for (int i = 0; i < threads; i++) {
+            slots.add(new EngineSlot(factory.create(), this.maxBatchSize));
+        }
+        idleSlots.addAll(slots);
+        this.tileSize = slots.get(0).engine.getTileSize();
+        this.scale = slots.get(0).engine.getScale();
+
+        AtomicInteger counter = new AtomicInteger();
+        this.inferenceExecutor = Executors.newFixedThreadPool(threads,
+            r -> new Thread(r, "Inference-" + counter.incrementAndGet()));
+        this.timer = Executors.newSingleThreadScheduledExecutor(r -> new Thread(r, "BatchTimer"));
+
+        this.batcher = new DynamicBatcher<>(new DynamicBatcher.Scheduler() {
+            @Override
+            public void execute(Runnable task) {
+                inferenceExecutor.execute(task);
+            }
+
+            @Override
+            public void schedule(Runnable task, long delayMs) {
+                timer.schedule(() -> inferenceExecutor.execute(task), delayMs, TimeUnit.MILLISECONDS);
+            }
+        }, request -> Boolean.TRUE, this::runBatch);
+        batcher.setPolicy(this.maxBatchSize, maxDelayMs);
+        metrics.setTileQueueDepth(batcher::getQueueDepth);
+    }
+
+    public int getTileSize() {
+        return tileSize;
+    }
+
+    public int getScale() {
+        return scale;
+    }
+
+    /**
+     * @param targetWidth  0 表示使用模型倍率
+     */
+    public Image upscale(int[] pixels, int width, int height, int targetWidth, int targetHeight)
+            throws IOException {
+        TilePlan plan = new TilePlan(width, height, tileSize, overlapPixels, scale);
+        int outputWidth = targetWidth > 0 ? targetWidth : plan.getOutputWidth();
+        int outputHeight = targetHeight > 0 ? targetHeight : plan.getOutputHeight();
+
+        Semaphore inFlight = new Semaphore(maxBatchSize * IN_FLIGHT_BATCHES);
+        ArrayDeque<TileRequest> pending = new ArrayDeque<>();
+        int[] output = new int[outputWidth * outputHeight];
+        int[] tilePixels = new int[tileSize * tileSize];
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = plan.regionFor(tile, outputWidth, outputHeight);
+            if (region.width <= 0 || region.height <= 0) {
+                continue;
+            }
+            // 名額用完時等待本工作先前的批次完成，再配置下一個tile的輸入
+            try {
+                inFlight.acquire();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new IOException("Interrupted", e);
+            }
+            readPadded(pixels, width, tile, tilePixels);
+            float[] input = new float[tileSize * tileSize * 3];
+            BitmapConverter.convertPixelsToFloat32(tilePixels, input);
+            TileRequest request = new TileRequest(input, region, inFlight);
+            pending.add(request);
+            batcher.submit(request);
+
+            // 已完成的結果依序寫入輸出並釋放
+            while (!pending.isEmpty() && pending.peek().result.isDone()) {
+                place(pending.poll(), output, outputWidth);
+            }
+        }
+        while (!pending.isEmpty()) {
+            place(pending.poll(), output, outputWidth);
+        }
+        return new Image(outputWidth, outputHeight, output);
+    }
+
+    private static void place(TileRequest request, int[] output, int outputWidth) throws IOException {
+        int[] result;
+        try {
+            result = request.result.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Interrupted", e);
+        } catch (ExecutionException e) {
+            throw new IOException("Tile inference failed", e.getCause());
+        }
+        OutputRegion region = request.region;
+        for (int y = 0; y < region.height; y++) {
+            System.arraycopy(result, y * region.width, output,
+                             (region.top + y) * outputWidth + region.left, region.width);
+        }
+    }
+
+    private void runBatch(List<TileRequest> batch) {
+        try {
+            runOnEngine(batch);
+        } finally {
+            for (TileRequest request : batch) {
+                request.inFlight.release();
+            }
+        }
+    }
+
+    private void runOnEngine(List<TileRequest> batch) {
+        EngineSlot current = idleSlots.poll();
+        int count = batch.size();
+        if (current == null) {
+            // 執行緒數等於engine數，不應發生
+            IllegalStateException e = new IllegalStateException("No idle engine");
+            batch.forEach(request -> request.result.completeExceptionally(e));
+            return;
+        }
+        try {
+            for (int i = 0; i < count; i++) {
+                current.inputs[i] = batch.get(i).input;
+            }
+            current.engine.infer(current.inputs, current.outputs, count);
+            metrics.batchRun(count);
+
+            int outSize = tileSize * scale;
+            for (int i = 0; i < count; i++) {
+                TileRequest request = batch.get(i);
+                int[] result = new int[request.region.width * request.region.height];
+                current.kernel.run(OutputKernel.float32(current.outputs[i], outSize, outSize), request.region, result);
+                request.result.complete(result);
+            }
+        } catch (Exception e) {
+            LOG.log(Level.WARNING, "Batch of " + count + " failed", e);
+            for (TileRequest request : batch) {
+                request.result.completeExceptionally(e);
+            }
+        } finally {
+            for (int i = 0; i < count; i++) {
+                current.inputs[i] = null;
+            }
+            idleSlots.add(current);
+        }
+    }
+
+    /**
+     * 與 TileProcessor 相同的邊界處理：不足tile大小的部分以邊緣像素補齊
+     */
+    private void readPadded(int[] pixels, int imageWidth, TilePlan.Tile tile, int[] dst) {
+        for (int y = 0; y < tileSize; y++) {
+            int sourceRow = (tile.inputTop + Math.min(y, tile.inputHeight - 1)) * imageWidth + tile.inputLeft;
+            int row = y * tileSize;
+            System.arraycopy(pixels, sourceRow, dst, row, tile.inputWidth);
+            int edge = pixels[sourceRow + tile.inputWidth - 1];
+            for (int x = tile.inputWidth; x < tileSize; x++) {
+                dst[row + x] = edge;
+            }
+        }
+    }
+
+    @Override
+    public void close() {
+        timer.shutdownNow();
+        inferenceExecutor.shutdown();
+        try {
+            inferenceExecutor.awaitTermination(5, TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+        for (EngineSlot engineSlot : slots) {
+            engineSlot.engine.close();
+        }
+    }
+}
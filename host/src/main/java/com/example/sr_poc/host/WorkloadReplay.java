@@ -0,0 +1,118 @@
+package com.example.sr_poc.host;
+
+import com.example.sr_poc.processing.WorkloadTrace;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+/**
+ * 對守護程序依原本的時間點重送 App 擷取的請求序列（開放迴圈，每個請求一條連線）。
+ * 主機端由守護程序自行決定後端與分塊，紀錄中的 mode/tiling 只列入報表；目標尺寸照原值送出。
+ *
+ * <pre>
+ * --trace workload-123.tsv  --socket /tmp/sr_upscale.sock  [--speed 1.0]  [--format png|jpeg]
+ * </pre>
+ *
+ * 紀錄旁的 inputs/ 有擷取輸入時使用原圖，否則以紀錄的尺寸產生合成影像。
+ */
+public final class WorkloadReplay {
+
+    public static void main(String[] argv) throws Exception {
+        Args args = new Args(argv);
+        File traceFile = new File(args.get("trace", "workload.tsv"));
+        Path socketPath = Path.of(args.get("socket", "/tmp/sr_upscale.sock"));
+        double speed = Double.parseDouble(args.get("speed", "1.0"));
+        byte format = "jpeg".equals(args.get("format", "png")) ? Protocol.FORMAT_JPEG : Protocol.FORMAT_PNG;
+
+        List<WorkloadTrace.Entry> entries = WorkloadTrace.read(traceFile);
+        Map<String, byte[]> inputs = loadInputs(traceFile, entries);
+
+        ExecutorService clients = Executors.newCachedThreadPool();
+        List<Future<Long>> futures = new ArrayList<>();
+        long maxLatenessNanos = 0;
+        long origin = System.nanoTime();
+        for (WorkloadTrace.Entry entry : entries) {
+            long due = origin + (long) (entry.offsetMs * 1_000_000L / speed);
+            long wait = due - System.nanoTime();
+            if (wait > 0) {
+                Thread.sleep(wait / 1_000_000, (int) (wait % 1_000_000));
+            }
+            maxLatenessNanos = Math.max(maxLatenessNanos, System.nanoTime() - due);
+            byte[] image = inputs.get(entry.inputHash);
+            futures.add(clients.submit(() -> send(socketPath, image, entry, format)));
+        }
+
+        long[] latencies = new long[futures.size()];
+        int completed = 0;
+        int failed = 0;
+        for (Future<Long> future : futures) {
+            try {
+                latencies[completed] = future.get();
+                completed++;
+            } catch (Exception e) {
+                failed++;
+                System.err.println("request failed: " + e.getCause());
+            }
+        }
+        clients.shutdown();
+
+        long[] sorted = Arrays.copyOf(latencies, completed);
+        Arrays.sort(sorted);
+        System.out.println(String.format(Locale.US,
+            "%d requests (%d failed): latency p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms, max lateness %.1f ms",
+            entries.size(), failed, HostMetrics.percentileMs(sorted, 0.50), HostMetrics.percentileMs(sorted, 0.95),
+            HostMetrics.percentileMs(sorted, 0.99), completed > 0 ? sorted[completed - 1] / 1e6 : 0,
+            maxLatenessNanos / 1e6));
+    }
+
+    private static long send(Path socketPath, byte[] image, WorkloadTrace.Entry entry, byte format)
+            throws IOException {
+        try (LoadGenerator.Connection connection = new LoadGenerator.Connection(socketPath)) {
+            long start = System.nanoTime();
+            Protocol.writeUpscaleRequest(connection.out, image, entry.targetWidth, entry.targetHeight, format);
+            Protocol.readResponse(connection.in);
+            return System.nanoTime() - start;
+        }
+    }
+
+    /**
+     * 送出前先讀入或編碼所有輸入，避免編碼時間延後送出
+     */
+    private static Map<String, byte[]> loadInputs(File traceFile, List<WorkloadTrace.Entry> entries)
+            throws IOException {
+        Map<String, byte[]> inputs = new HashMap<>();
+        for (WorkloadTrace.Entry entry : entries) {
+            if (inputs.containsKey(entry.inputHash)) {
+                continue;
+            }
+            File file = WorkloadTrace.inputFileFor(traceFile, entry);
+            inputs.put(entry.inputHash, file != null ? Files.readAllBytes(file.toPath())
+                                                     : ImageCodec.encode(synthetic(entry.width, entry.height),
+                                                                         Protocol.FORMAT_PNG));
+        }
+        return inputs;
+    }
+
+    private static UpscaleService.Image synthetic(int width, int height) {
+        int[] pixels = new int[width * height];
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int r = x * 255 / Math.max(1, width - 1);
+                int g = y * 255 / Math.max(1, height - 1);
+                pixels[y * width + x] = 0xFF000000 | (r << 16) | (g << 8) | ((x ^ y) & 0xFF);
+            }
+        }
+        return new UpscaleService.Image(width, height, pixels);
+    }
+}
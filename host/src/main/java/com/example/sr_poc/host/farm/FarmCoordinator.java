@@ -0,0 +1,137 @@
+package com.example.sr_poc.host.farm;
+
+import com.example.sr_poc.host.Args;
+
+import java.awt.image.BufferedImage;
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.logging.Logger;
+import javax.imageio.ImageIO;
+
+/**
+ * 分塊農場的 coordinator：建立工作目錄（TilePlan 與 TileProcessor 相同）、
+ * 在本機啟動多個 worker 程序，以及把完成的tile拼成結果。
+ *
+ * <pre>
+ * plan      --job DIR --input IMG [--tile 128] [--overlap 32] [--scale 4] [--width W --height H] [--engine bicubic]
+ * run-local --job DIR [--workers N] [--engine 類別名稱]
+ * scaling   --job DIR [--workers N] [--engine 類別名稱]
+ * stitch    --job DIR --output OUT.png
+ * </pre>
+ * scaling 先以1個再以N個 worker 重跑整個工作（每次清除已完成的tile），記錄兩者的牆鐘時間。
+ * 多台主機時，各主機對同一個共享目錄執行 FarmWorker 即可，不需要 run-local。
+ */
+public final class FarmCoordinator {
+
+    private static final Logger LOG = Logger.getLogger("FarmCoordinator");
+
+    private FarmCoordinator() {
+        // Prevent instantiation
+    }
+
+    public static void main(String[] argv) throws Exception {
+        if (argv.length == 0) {
+            throw new IllegalArgumentException("Usage: plan|run-local|scaling|stitch --job DIR ...");
+        }
+        String command = argv[0];
+        Args args = new Args(Arrays.copyOfRange(argv, 1, argv.length));
+        Path jobDir = Path.of(args.get("job", "sr_farm_job"));
+
+        switch (command) {
+            case "plan": {
+                BufferedImage image = ImageIO.read(new File(args.get("input", "input.png")));
+                if (image == null) {
+                    throw new IOException("Unrecognized input image");
+                }
+                int width = image.getWidth();
+                int height = image.getHeight();
+                FarmJob job = FarmJob.create(jobDir, image.getRGB(0, 0, width, height, null, 0, width),
+                                             width, height, args.getInt("tile", 128), args.getInt("overlap", 32),
+                                             args.getInt("scale", 4), args.getInt("width", 0),
+                                             args.getInt("height", 0), args.get("engine", "bicubic"));
+                LOG.info(job.getPlan() + " -> " + job.getOutputWidth() + "x" + job.getOutputHeight());
+                break;
+            }
+            case "run-local": {
+                long elapsed = runLocalWorkers(jobDir, args.getInt("workers",
+                                               Runtime.getRuntime().availableProcessors()), args.get("engine", null));
+                LOG.info("Workers finished in " + elapsed + " ms");
+                break;
+            }
+            case "scaling": {
+                FarmJob job = FarmJob.load(jobDir);
+                int workers = args.getInt("workers", Runtime.getRuntime().availableProcessors());
+                String engine = args.get("engine", null);
+                job.reset();
+                long single = runLocalWorkers(jobDir, 1, engine);
+                job.reset();
+                long parallel = runLocalWorkers(jobDir, workers, engine);
+                LOG.info(String.format(Locale.US, "%d tiles: 1 worker %d ms, %d workers %d ms (%.2fx)",
+                                       job.getPlan().getTileCount(), single, workers, parallel,
+                                       (double) single / Math.max(1, parallel)));
+                break;
+            }
+            case "stitch": {
+                ExecutorService executor = Executors.newFixedThreadPool(Runtime.getRuntime().availableProcessors());
+                try (OutputStream out = new BufferedOutputStream(
+                         Files.newOutputStream(Path.of(args.get("output", "output.png"))), 256 * 1024)) {
+                    FarmStitcher.stitch(FarmJob.load(jobDir), out, executor);
+                } finally {
+                    executor.shutdown();
+                }
+                break;
+            }
+            default:
+                throw new IllegalArgumentException("Unknown command " + command);
+        }
+    }
+
+    /**
+     * 以目前的 classpath 啟動 workers 個 FarmWorker JVM 並等待全部結束，回傳經過毫秒數
+     *
+     * @param engine null 表示使用計畫檔中的 engine
+     */
+    public static long runLocalWorkers(Path jobDir, int workers, String engine) throws IOException, InterruptedException {
+        return runLocalWorkers(jobDir, workers, engine, System.getProperty("java.class.path"));
+    }
+
+    public static long runLocalWorkers(Path jobDir, int workers, String engine, String classpath)
+            throws IOException, InterruptedException {
+        String java = Path.of(System.getProperty("java.home"), "bin", "java").toString();
+        long start = System.nanoTime();
+        List<Process> processes = new ArrayList<>();
+        try {
+            for (int i = 0; i < workers; i++) {
+                List<String> command = new ArrayList<>(List.of(
+                    java, "-cp", classpath, FarmWorker.class.getName(),
+                    "--job", jobDir.toString(), "--id", "local-" + i));
+                if (engine != null) {
+                    command.add("--engine");
+                    command.add(engine);
+                }
+                processes.add(new ProcessBuilder(command).inheritIO().start());
+            }
+            for (Process process : processes) {
+                int exit = process.waitFor();
+                if (exit != 0) {
+                    throw new IOException("Worker exited with " + exit);
+                }
+            }
+        } finally {
+            for (Process process : processes) {
+                process.destroy();
+            }
+        }
+        return (System.nanoTime() - start) / 1_000_000;
+    }
+}
@@ -0,0 +1,192 @@
+package com.example.sr_poc.host.farm;
+
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.TilePlan;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.Locale;
+import java.util.Properties;
+
+/**
+ * 共享目錄上的分塊工作。目錄結構：
+ * <pre>
+ * plan.properties      影像尺寸與分塊參數（worker 以相同參數重建 TilePlan）
+ * input.rgba           輸入像素（RGBA8888，列優先），worker 以 mmap 按需讀取
+ * tiles/NNNNNN.lock    worker 認領中的tile；內容為worker id，mtime 為心跳
+ * tiles/NNNNNN.out     完成的tile輸出（region 大小的 ARGB int，大端序）
+ * </pre>
+ */
+public final class FarmJob {
+
+    public static final String PLAN_FILE = "plan.properties";
+    public static final String INPUT_FILE = "input.rgba";
+    public static final String TILES_DIR = "tiles";
+
+    private final Path directory;
+    private final int width;
+    private final int height;
+    private final int tileSize;
+    private final int overlap;
+    private final int scale;
+    private final int outputWidth;
+    private final int outputHeight;
+    private final String engine;
+    private final TilePlan plan;
+
+    private FarmJob(Path directory, int width, int height, int tileSize, int overlap, int scale,
+                    int outputWidth, int outputHeight, String engine) {
+        this.directory = directory;
+        this.width = width;
+        this.height = height;
+        this.tileSize = tileSize;
+        this.overlap = overlap;
+        this.scale = scale;
+        this.engine = engine;
+        this.plan = new TilePlan(width, height, tileSize, overlap, scale);
+        this.outputWidth = outputWidth > 0 ? outputWidth : plan.getOutputWidth();
+        this.outputHeight = outputHeight > 0 ? outputHeight : plan.getOutputHeight();
+    }
+
+    /**
+     * 建立工作目錄：寫入輸入像素與計畫檔（計畫檔最後以原子改名寫出，worker 看到它時輸入已完整）
+     */
+    public static FarmJob create(Path directory, int[] argb, int width, int height, int tileSize, int overlap,
+                                 int scale, int outputWidth, int outputHeight, String engine) throws IOException {
+        Files.createDirectories(directory.resolve(TILES_DIR));
+        FarmJob job = new FarmJob(directory, width, height, tileSize, overlap, scale,
+                                  outputWidth, outputHeight, engine);
+
+        byte[] row = new byte[width * 4];
+        try (OutputStream out = Files.newOutputStream(directory.resolve(INPUT_FILE))) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0, p = 0; x < width; x++, p += 4) {
+                    int pixel = argb[y * width + x];
+                    row[p] = (byte) (pixel >> 16);
+                    row[p + 1] = (byte) (pixel >> 8);
+                    row[p + 2] = (byte) pixel;
+                    row[p + 3] = (byte) (pixel >>> 24);
+                }
+                out.write(row);
+            }
+        }
+
+        Properties properties = new Properties();
+        properties.setProperty("width", Integer.toString(width));
+        properties.setProperty("height", Integer.toString(height));
+        properties.setProperty("tile_size", Integer.toString(tileSize));
+        properties.setProperty("overlap", Integer.toString(overlap));
+        properties.setProperty("scale", Integer.toString(scale));
+        properties.setProperty("output_width", Integer.toString(job.outputWidth));
+        properties.setProperty("output_height", Integer.toString(job.outputHeight));
+        properties.setProperty("tile_count", Integer.toString(job.plan.getTileCount()));
+        properties.setProperty("engine", engine);
+        Path temp = directory.resolve(PLAN_FILE + ".tmp");
+        try (OutputStream out = Files.newOutputStream(temp)) {
+            properties.store(out, "SR tile farm plan");
+        }
+        Files.move(temp, directory.resolve(PLAN_FILE), StandardCopyOption.ATOMIC_MOVE);
+        return job;
+    }
+
+    public static FarmJob load(Path directory) throws IOException {
+        Properties properties = new Properties();
+        try (InputStream in = Files.newInputStream(directory.resolve(PLAN_FILE))) {
+            properties.load(in);
+        }
+        return new FarmJob(directory,
+                           intProperty(properties, "width"), intProperty(properties, "height"),
+                           intProperty(properties, "tile_size"), intProperty(properties, "overlap"),
+                           intProperty(properties, "scale"),
+                           intProperty(properties, "output_width"), intProperty(properties, "output_height"),
+                           properties.getProperty("engine", "bicubic"));
+    }
+
+    private static int intProperty(Properties properties, String key) throws IOException {
+        String value = properties.getProperty(key);
+        if (value == null) {
+            throw new IOException("Plan is missing " + key);
+        }
+        return Integer.parseInt(value.trim());
+    }
+
+    public Path getDirectory() {
+        return directory;
+    }
+
+    public Path getInputFile() {
+        return directory.resolve(INPUT_FILE);
+    }
+
+    public Path lockFile(int tileIndex) {
+        return directory.resolve(TILES_DIR).resolve(String.format(Locale.US, "%06d.lock", tileIndex));
+    }
+
+    public Path outputFile(int tileIndex) {
+        return directory.resolve(TILES_DIR).resolve(String.format(Locale.US, "%06d.out", tileIndex));
+    }
+
+    public TilePlan getPlan() {
+        return plan;
+    }
+
+    public OutputRegion regionFor(TilePlan.Tile tile) {
+        return plan.regionFor(tile, outputWidth, outputHeight);
+    }
+
+    public int getWidth() {
+        return width;
+    }
+
+    public int getHeight() {
+        return height;
+    }
+
+    public int getTileSize() {
+        return tileSize;
+    }
+
+    public int getScale() {
+        return scale;
+    }
+
+    public int getOutputWidth() {
+        return outputWidth;
+    }
+
+    public int getOutputHeight() {
+        return outputHeight;
+    }
+
+    public String getEngine() {
+        return engine;
+    }
+
+    /**
+     * 刪除所有tile的輸出與 lock，讓同一個工作可以重跑（擴展性量測用）
+     */
+    public void reset() throws IOException {
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            Files.deleteIfExists(outputFile(tile.index));
+            Files.deleteIfExists(lockFile(tile.index));
+        }
+    }
+
+    /**
+     * 尚未有輸出檔的tile數（不需推理的空region不計）
+     */
+    public int countRemaining() {
+        int remaining = 0;
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            OutputRegion region = regionFor(tile);
+            if (region.width > 0 && region.height > 0 && !Files.exists(outputFile(tile.index))) {
+                remaining++;
+            }
+        }
+        return remaining;
+    }
+}
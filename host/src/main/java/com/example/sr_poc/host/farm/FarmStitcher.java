@@ -0,0 +1,95 @@
+package com.example.sr_poc.host.farm;
+
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.ParallelPngEncoder;
+import com.example.sr_poc.processing.TilePlan;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.concurrent.ExecutorService;
+import java.util.zip.Deflater;
+
+/**
+ * 依tile排讀取各tile輸出拼成完整結果並串流編碼成PNG；只保留一排tile高的輸出帶
+ */
+public final class FarmStitcher {
+
+    private static final int STRIP_ROWS = 64;
+
+    private FarmStitcher() {
+        // Prevent instantiation
+    }
+
+    public static void stitch(FarmJob job, OutputStream out, ExecutorService executor) throws IOException {
+        int remaining = job.countRemaining();
+        if (remaining > 0) {
+            throw new IOException(remaining + " tiles have no output yet");
+        }
+
+        TilePlan plan = job.getPlan();
+        int width = job.getOutputWidth();
+        int height = job.getOutputHeight();
+        int bandHeight = 0;
+        for (TilePlan.Tile tile : plan.getTiles()) {
+            bandHeight = Math.max(bandHeight, job.regionFor(tile).height);
+        }
+
+        ParallelPngEncoder encoder = new ParallelPngEncoder(out, width, height, false, executor,
+                                                            Deflater.DEFAULT_COMPRESSION, STRIP_ROWS,
+                                                            2 * Runtime.getRuntime().availableProcessors());
+        int[] band = new int[width * Math.max(1, bandHeight)];
+        int bandTop = 0;
+        try {
+            for (TilePlan.Tile tile : plan.getTiles()) {
+                OutputRegion region = job.regionFor(tile);
+                if (region.width > 0 && region.height > 0) {
+                    int[] pixels = readTile(job.outputFile(tile.index), region.width * region.height);
+                    for (int y = 0; y < region.height; y++) {
+                        System.arraycopy(pixels, y * region.width, band,
+                                         (region.top - bandTop + y) * width + region.left, region.width);
+                    }
+                }
+                if (tile.column == plan.getTilesX() - 1) {
+                    int rowBottom = tile.row == plan.getTilesY() - 1 ? height : region.top + region.height;
+                    writeBand(encoder, band, width, rowBottom - bandTop);
+                    bandTop = rowBottom;
+                }
+            }
+            encoder.finish();
+        } catch (IOException | RuntimeException e) {
+            encoder.abort();
+            throw e;
+        }
+    }
+
+    private static void writeBand(ParallelPngEncoder encoder, int[] band, int width, int rows) throws IOException {
+        // writeRows 取得陣列所有權，因此每個strip各自複製
+        for (int y = 0; y < rows; y += STRIP_ROWS) {
+            int count = Math.min(STRIP_ROWS, rows - y);
+            int[] strip = new int[width * count];
+            System.arraycopy(band, y * width, strip, 0, strip.length);
+            encoder.writeRows(strip, count);
+        }
+    }
+
+    private static int[] readTile(Path file, int pixelCount) throws IOException {
+        try (FileChannel channel = FileChannel.open(file, StandardOpenOption.READ)) {
+            if (channel.size() != (long) pixelCount * 4) {
+                throw new IOException(file + ": expected " + pixelCount * 4 + " bytes, got " + channel.size());
+            }
+            ByteBuffer buffer = ByteBuffer.allocate(pixelCount * 4).order(ByteOrder.BIG_ENDIAN);
+            while (buffer.hasRemaining() && channel.read(buffer) >= 0) {
+                // 讀到滿為止
+            }
+            buffer.flip();
+            int[] pixels = new int[pixelCount];
+            buffer.asIntBuffer().get(pixels);
+            return pixels;
+        }
+    }
+}
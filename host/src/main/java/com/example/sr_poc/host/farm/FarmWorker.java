@@ -0,0 +1,289 @@
+package com.example.sr_poc.host.farm;
+
+import com.example.sr_poc.host.Args;
+import com.example.sr_poc.host.InferenceEngine;
+import com.example.sr_poc.processing.OutputKernel;
+import com.example.sr_poc.processing.OutputRegion;
+import com.example.sr_poc.processing.RawRgbaTileSource;
+import com.example.sr_poc.processing.TilePlan;
+import com.example.sr_poc.processing.TileSource;
+import com.example.sr_poc.utils.BitmapConverter;
+
+import java.io.IOException;
+import java.lang.management.ManagementFactory;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.FileAlreadyExistsException;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.nio.file.attribute.FileTime;
+import java.util.List;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+import java.util.logging.Logger;
+
+/**
+ * 分塊農場的worker：重建與 coordinator 相同的 TilePlan，以 lock 檔認領tile、推理並寫出tile輸出，
+ * 直到所有tile都有輸出為止。可在任意台主機上執行多個，只需共用同一個工作目錄。
+ *
+ * 認領以 CREATE_NEW 建立 lock 檔（原子操作）；持有期間定期更新 mtime 作為心跳，
+ * 超過 lease 未更新的 lock 視為worker已死，以原子改名奪取後重新認領；
+ * 改名後確認搬走的仍是判定過期的那個 lock，否則放回。完成時只刪除內容仍是自己 ID 的 lock。
+ *
+ * <pre>
+ * --job /shared/job  [--engine 類別名稱，預設取計畫檔]  [--lease-ms 30000]  [--id 名稱]
+ * </pre>
+ */
+public final class FarmWorker {
+
+    private static final Logger LOG = Logger.getLogger("FarmWorker");
+    private static final long IDLE_POLL_MS = 200;
+
+    private final FarmJob job;
+    private final InferenceEngine engine;
+    private final long leaseMs;
+    private final String workerId;
+    private final ScheduledExecutorService heartbeat = Executors.newSingleThreadScheduledExecutor(r -> {
+        Thread thread = new Thread(r, "FarmHeartbeat");
+        thread.setDaemon(true);
+        return thread;
+    });
+
+    private final OutputKernel kernel = new OutputKernel(null);
+    private final int[] regionPixels;
+    private final int[] tilePixels;
+    private final float[][] input;
+    private final float[][] output;
+    private int tilesProcessed;
+
+    public FarmWorker(FarmJob job, InferenceEngine engine, long leaseMs, String workerId) {
+        if (engine.getTileSize() != job.getTileSize() || engine.getScale() != job.getScale()) {
+            throw new IllegalArgumentException("Engine geometry does not match the plan");
+        }
+        this.job = job;
+        this.engine = engine;
+        this.leaseMs = leaseMs;
+        this.workerId = workerId;
+        int tileSize = job.getTileSize();
+        int outSize = tileSize * job.getScale();
+        this.regionPixels = new int[tileSize * tileSize];
+        this.tilePixels = new int[tileSize * tileSize];
+        this.input = new float[][] {new float[tileSize * tileSize * 3]};
+        this.output = new float[][] {new float[outSize * outSize * 3]};
+    }
+
+    public static void main(String[] argv) throws Exception {
+        Args args = new Args(argv);
+        String jobDir = args.get("job", null);
+        if (jobDir == null) {
+            throw new IllegalArgumentException("--job is required");
+        }
+        long leaseMs = args.getLong("lease-ms", 30_000);
+        String id = args.get("id", ManagementFactory.getRuntimeMXBean().getName());
+
+        FarmJob job = FarmJob.load(Path.of(jobDir));
+        String name = args.get("engine", job.getEngine());
+        try (InferenceEngine engine = InferenceEngine.factoryFor(name, job.getTileSize(), job.getScale()).create()) {
+            FarmWorker worker = new FarmWorker(job, engine, leaseMs, id);
+            long start = System.nanoTime();
+            worker.run();
+            LOG.info(String.format("%s: %d tiles in %d ms", id, worker.getTilesProcessed(),
+                                   (System.nanoTime() - start) / 1_000_000));
+        }
+    }
+
+    public int getTilesProcessed() {
+        return tilesProcessed;
+    }
+
+    /**
+     * 處理直到所有tile完成；其他worker持有的tile會等到完成或lease過期
+     */
+    public void run() throws Exception {
+        List<TilePlan.Tile> tiles = job.getPlan().getTiles();
+        try (TileSource source = new RawRgbaTileSource(job.getInputFile().toFile(),
+                                                       job.getWidth(), job.getHeight(), 0)) {
+            while (true) {
+                boolean pending = false;
+                boolean claimedAny = false;
+                // 從隨機位置開始掃描，降低多個worker同時搶同一塊的機率
+                int offset = ThreadLocalRandom.current().nextInt(tiles.size());
+                for (int i = 0; i < tiles.size(); i++) {
+                    TilePlan.Tile tile = tiles.get((offset + i) % tiles.size());
+                    OutputRegion region = job.regionFor(tile);
+                    if (region.width <= 0 || region.height <= 0 || Files.exists(job.outputFile(tile.index))) {
+                        continue;
+                    }
+                    pending = true;
+                    if (tryClaim(tile.index)) {
+                        claimedAny = true;
+                        if (Files.exists(job.outputFile(tile.index))) {
+                            // 掃描後才被其他worker完成
+                            releaseLock(job.lockFile(tile.index));
+                            continue;
+                        }
+                        process(source, tile, region);
+                    }
+                }
+                if (!pending) {
+                    return;
+                }
+                if (!claimedAny) {
+                    Thread.sleep(IDLE_POLL_MS);
+                }
+            }
+        } finally {
+            heartbeat.shutdownNow();
+        }
+    }
+
+    private boolean tryClaim(int tileIndex) throws IOException {
+        Path lock = job.lockFile(tileIndex);
+        try {
+            Files.write(lock, workerId.getBytes(StandardCharsets.UTF_8), StandardOpenOption.CREATE_NEW);
+            return true;
+        } catch (FileAlreadyExistsException e) {
+            // 繼續判斷是否過期
+        }
+
+        String owner;
+        long modified;
+        try {
+            owner = readOwner(lock);
+            modified = Files.getLastModifiedTime(lock).toMillis();
+        } catch (NoSuchFileException e) {
+            return false;
+        }
+        if (System.currentTimeMillis() - modified < leaseMs) {
+            return false;
+        }
+        // 過期：只有改名成功的worker取得奪取權，再以 CREATE_NEW 重新認領
+        Path stale = lock.resolveSibling(lock.getFileName() + ".stale." + ProcessHandle.current().pid());
+        try {
+            Files.move(lock, stale, StandardCopyOption.ATOMIC_MOVE);
+        } catch (NoSuchFileException e) {
+            return false;
+        }
+        // 檢查與改名不是原子操作：期間其他worker可能已奪取並寫入新的lock，或原持有者更新了心跳
+        if (!isSameLock(stale, owner, modified)) {
+            restore(stale, lock);
+            return false;
+        }
+        Files.deleteIfExists(stale);
+        LOG.warning(workerId + ": reclaimed expired lock for tile " + tileIndex + " from " + owner);
+        return tryClaim(tileIndex);
+    }
+
+    private static boolean isSameLock(Path path, String owner, long modified) throws IOException {
+        try {
+            return Files.getLastModifiedTime(path).toMillis() == modified && owner.equals(readOwner(path));
+        } catch (NoSuchFileException e) {
+            return false;
+        }
+    }
+
+    /**
+     * 把誤搬的lock放回原處。以硬連結建立（目標存在時失敗，不會覆蓋），保留原本的內容與 mtime；
+     * 原處已有新的lock時直接丟棄
+     */
+    private static void restore(Path stale, Path lock) throws IOException {
+        try {
+            Files.createLink(lock, stale);
+        } catch (FileAlreadyExistsException e) {
+            // 已被重新認領
+        }
+        Files.deleteIfExists(stale);
+    }
+
+    /**
+     * 只刪除仍屬於自己的lock；處理期間lease過期被奪取時，新持有者的lock必須保留
+     */
+    private void releaseLock(Path lock) throws IOException {
+        try {
+            if (workerId.equals(readOwner(lock))) {
+                Files.deleteIfExists(lock);
+            }
+        } catch (NoSuchFileException e) {
+            // 已被奪取後完成
+        }
+    }
+
+    private static String readOwner(Path lock) throws IOException {
+        return new String(Files.readAllBytes(lock), StandardCharsets.UTF_8);
+    }
+
+    private void process(TileSource source, TilePlan.Tile tile, OutputRegion region) throws Exception {
+        Path lock = job.lockFile(tile.index);
+        ScheduledFuture<?> beat = heartbeat.scheduleAtFixedRate(() -> {
+            try {
+                Files.setLastModifiedTime(lock, FileTime.fromMillis(System.currentTimeMillis()));
+            } catch (IOException e) {
+                // lock被奪取時更新會失敗，完成的輸出仍然有效
+            }
+        }, Math.max(1, leaseMs / 3), Math.max(1, leaseMs / 3), TimeUnit.MILLISECONDS);
+
+        try {
+            readPadded(source, tile);
+            BitmapConverter.convertPixelsToFloat32(tilePixels, input[0]);
+            engine.infer(input, output, 1);
+
+            int outSize = job.getTileSize() * job.getScale();
+            int[] result = new int[region.width * region.height];
+            kernel.run(OutputKernel.float32(output[0], outSize, outSize), region, result);
+            writeOutput(tile.index, result);
+            tilesProcessed++;
+        } finally {
+            beat.cancel(false);
+            releaseLock(lock);
+        }
+    }
+
+    /**
+     * 先寫暫存檔再原子改名，stitcher 不會讀到寫一半的輸出。
+     * 暫存檔以 workerId 命名：不同主機的 pid 可能相同，lease 被奪取後新舊 worker 仍可能同時寫同一tile
+     */
+    private void writeOutput(int tileIndex, int[] pixels) throws IOException {
+        Path target = job.outputFile(tileIndex);
+        Path temp = target.resolveSibling(target.getFileName() + "." + workerId + ".tmp");
+        ByteBuffer buffer = ByteBuffer.allocate(pixels.length * 4);
+        buffer.asIntBuffer().put(pixels);
+        try {
+            try (FileChannel channel = FileChannel.open(temp, StandardOpenOption.CREATE, StandardOpenOption.WRITE,
+                                                        StandardOpenOption.TRUNCATE_EXISTING)) {
+                while (buffer.hasRemaining()) {
+                    channel.write(buffer);
+                }
+            }
+            Files.move(temp, target, StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING);
+        } catch (IOException e) {
+            Files.deleteIfExists(temp);
+            throw e;
+        }
+    }
+
+    /**
+     * 與 TileProcessor 相同的邊界處理：不足tile大小的部分以邊緣像素補齊
+     */
+    private void readPadded(TileSource source, TilePlan.Tile tile) throws IOException {
+        int tileSize = job.getTileSize();
+        int width = tile.inputWidth;
+        int height = tile.inputHeight;
+        source.readRegion(tile.inputLeft, tile.inputTop, width, height, regionPixels);
+        for (int y = 0; y < tileSize; y++) {
+            int sourceRow = Math.min(y, height - 1) * width;
+            int row = y * tileSize;
+            System.arraycopy(regionPixels, sourceRow, tilePixels, row, width);
+            int edge = regionPixels[sourceRow + width - 1];
+            for (int x = width; x < tileSize; x++) {
+                tilePixels[row + x] = edge;
+            }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+package com.example.sr_poc.host.farm;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import com.example.sr_poc.host.BicubicEngine;
+import com.example.sr_poc.host.HostMetrics;
+import com.example.sr_poc.host.InferenceEngine;
+import com.example.sr_poc.host.UpscaleService;
+
+import org.junit.AfterClass;
+import org.junit.BeforeClass;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.awt.image.BufferedImage;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.FileTime;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.stream.Collectors;
+import java.util.stream.Stream;
+import javax.imageio.ImageIO;
+
+/**
+ * 在本機跑分塊農場：多個 worker JVM 拼接的結果需與單機 UpscaleService 完全相同；
+ * 並行的 worker 分攤tile且不重複處理，過期的 lock 可被奪取。
+ * 1 個與 N 個 worker 的牆鐘時間以 FarmCoordinator 的 scaling 指令量測，不在單元測試中斷言。
+ */
+public class FarmWorkerTest {
+
+    private static final int WIDTH = 512;
+    private static final int HEIGHT = 384;
+    private static final int TILE = 64;
+    private static final int OVERLAP = 8;
+    private static final int SCALE = 2;
+    private static final int WORKERS = 4;
+
+    private static ExecutorService executor;
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @BeforeClass
+    public static void setUp() {
+        executor = Executors.newFixedThreadPool(2);
+    }
+
+    @AfterClass
+    public static void tearDown() {
+        executor.shutdown();
+    }
+
+    @Test
+    public void stitchedOutputMatchesInProcessService() throws Exception {
+        int[] input = syntheticImage();
+        FarmJob job = createJob("match", input, "bicubic");
+        FarmCoordinator.runLocalWorkers(job.getDirectory(), WORKERS, null, classpath());
+        assertEquals(0, job.countRemaining());
+
+        ByteArrayOutputStream stitched = new ByteArrayOutputStream();
+        FarmStitcher.stitch(job, stitched, executor);
+
+        UpscaleService.Image expected;
+        try (UpscaleService service = new UpscaleService(() -> new BicubicEngine(TILE, SCALE), 1, 1, 0,
+                                                         OVERLAP, new HostMetrics())) {
+            expected = service.upscale(input, WIDTH, HEIGHT, 0, 0);
+        }
+        UpscaleService.Image actual = decodePng(stitched.toByteArray());
+        assertEquals(expected.width, actual.width);
+        assertEquals(expected.height, actual.height);
+        assertArrayEquals(expected.pixels, actual.pixels);
+    }
+
+    @Test
+    public void concurrentWorkersSplitTilesWithoutOverlap() throws Exception {
+        FarmJob job = createJob("split", syntheticImage(), FixedCostEngine.class.getName());
+        int tiles = job.countRemaining();
+
+        // 每個tile有固定成本，所有worker都應分到工作；各自的tile數加總等於tile數即表示沒有重複推理
+        int[] processed = runWorkers(job, WORKERS, 30_000, () -> new FixedCostEngine(TILE, SCALE));
+        int total = 0;
+        for (int i = 0; i < WORKERS; i++) {
+            assertTrue("worker " + i + " processed no tiles", processed[i] > 0);
+            total += processed[i];
+        }
+        assertEquals("tiles processed more than once", tiles, total);
+        assertEquals(0, job.countRemaining());
+        assertNoLocks(job);
+    }
+
+    @Test
+    public void expiredLockIsTakenOver() throws Exception {
+        FarmJob job = createJob("expired", syntheticImage(), "bicubic");
+        Path lock = job.lockFile(0);
+        Files.write(lock, "dead-worker".getBytes(StandardCharsets.UTF_8));
+        Files.setLastModifiedTime(lock, FileTime.fromMillis(System.currentTimeMillis() - 60_000));
+        int tiles = job.countRemaining();
+
+        int[] processed = runWorkers(job, 1, 1_000, () -> new BicubicEngine(TILE, SCALE));
+        assertEquals(tiles, processed[0]);
+        assertTrue(Files.exists(job.outputFile(0)));
+        assertNoLocks(job);
+    }
+
+    @Test
+    public void resetClearsFinishedTilesForRerun() throws Exception {
+        FarmJob job = createJob("reset", syntheticImage(), "bicubic");
+        int tiles = job.countRemaining();
+        runWorkers(job, 1, 1_000, () -> new BicubicEngine(TILE, SCALE));
+        assertEquals(0, job.countRemaining());
+
+        job.reset();
+        assertEquals(tiles, job.countRemaining());
+        assertEquals(tiles, runWorkers(job, 1, 1_000, () -> new BicubicEngine(TILE, SCALE))[0]);
+        assertNoLocks(job);
+    }
+
+    /**
+     * 在本程序以執行緒跑 workers 個 FarmWorker，回傳各自處理的tile數
+     */
+    private static int[] runWorkers(FarmJob job, int workers, long leaseMs, InferenceEngine.Factory factory)
+            throws Exception {
+        ExecutorService pool = Executors.newFixedThreadPool(workers);
+        try {
+            List<Future<Integer>> futures = new ArrayList<>();
+            for (int i = 0; i < workers; i++) {
+                String id = "thread-" + i;
+                futures.add(pool.submit(() -> {
+                    try (InferenceEngine engine = factory.create()) {
+                        FarmWorker worker = new FarmWorker(job, engine, leaseMs, id);
+                        worker.run();
+                        return worker.getTilesProcessed();
+                    }
+                }));
+            }
+            int[] processed = new int[workers];
+            for (int i = 0; i < workers; i++) {
+                processed[i] = futures.get(i).get();
+            }
+            return processed;
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    private static void assertNoLocks(FarmJob job) throws Exception {
+        try (Stream<Path> files = Files.list(job.lockFile(0).getParent())) {
+            assertEquals(List.of(), files.filter(path -> !path.toString().endsWith(".out"))
+                                        .collect(Collectors.toList()));
+        }
+    }
+
+    private FarmJob createJob(String name, int[] input, String engine) throws Exception {
+        Path directory = folder.newFolder(name).toPath();
+        return FarmJob.create(directory, input, WIDTH, HEIGHT, TILE, OVERLAP, SCALE, 0, 0, engine);
+    }
+
+    private static String classpath() {
+        return System.getProperty("farm.classpath", System.getProperty("java.class.path"));
+    }
+
+    private static int[] syntheticImage() {
+        int[] pixels = new int[WIDTH * HEIGHT];
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                int r = (x * 255) / WIDTH;
+                int g = (y * 255) / HEIGHT;
+                int b = ((x / 16 + y / 16) & 1) * 255;
+                pixels[y * WIDTH + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+            }
+        }
+        return pixels;
+    }
+
+    private static UpscaleService.Image decodePng(byte[] png) throws Exception {
+        BufferedImage image = ImageIO.read(new ByteArrayInputStream(png));
+        int width = image.getWidth();
+        int height = image.getHeight();
+        return new UpscaleService.Image(width, height, image.getRGB(0, 0, width, height, null, 0, width));
+    }
+}
@@ -0,0 +1,34 @@
+package com.example.sr_poc.host.farm;
+
+import com.example.sr_poc.host.BicubicEngine;
+import com.example.sr_poc.host.InferenceEngine;
+
+/**
+ * 每個tile額外耗時固定毫秒的測試engine，模擬模型推理成本，使擴展性量測不受核心數限制
+ */
+public final class FixedCostEngine implements InferenceEngine {
+
+    static final long COST_MS = 50;
+
+    private final BicubicEngine delegate;
+
+    public FixedCostEngine(int tileSize, int scale) {
+        this.delegate = new BicubicEngine(tileSize, scale);
+    }
+
+    @Override
+    public int getTileSize() {
+        return delegate.getTileSize();
+    }
+
+    @Override
+    public int getScale() {
+        return delegate.getScale();
+    }
+
+    @Override
+    public void infer(float[][] inputs, float[][] outputs, int count) throws Exception {
+        delegate.infer(inputs, outputs, count);
+        Thread.sleep(COST_MS * count);
+    }
+}
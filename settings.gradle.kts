@@ -21,4 +21,5 @@ dependencyResolutionManagement {
 
 rootProject.name = "sr_poc"
 include(":app")
+include(":host")
  
\ No newline at end of file